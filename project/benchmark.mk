@@ -0,0 +1,47 @@
+###############################################################################
+##  OBJECTS                                                                  ##
+###############################################################################
+
+BENCH_COMPRESS = compress.c
+
+BENCH_SUITE = benchmark.c
+BENCH_SUITE += mock_server.c
+
+BENCH_COMPRESS_OBJECT = $(patsubst %.c,$(TARGET_BENCH)/%.o,$(BENCH_COMPRESS))
+BENCH_SUITE_OBJECT = $(patsubst %.c,$(TARGET_BENCH)/%.o,$(BENCH_SUITE))
+
+###############################################################################
+##  FLAGS                                                                    ##
+###############################################################################
+
+BENCH_CFLAGS = -I$(TARGET_INCL)
+BENCH_LDFLAGS = $(TEST_LDFLAGS)
+
+###############################################################################
+##  TARGETS                                                                  ##
+###############################################################################
+
+.PHONY: benchmark
+benchmark: $(TARGET_BENCH)/benchmark
+	$(TARGET_BENCH)/benchmark $(BENCH_ARGS)
+
+.PHONY: benchmark-compress
+benchmark-compress: $(TARGET_BENCH)/compress
+	$(TARGET_BENCH)/compress
+
+.PHONY: benchmark-build
+benchmark-build: $(TARGET_BENCH)/benchmark $(TARGET_BENCH)/compress
+
+.PHONY: benchmark-clean
+benchmark-clean:
+	@rm -rf $(TARGET_BENCH)
+
+$(TARGET_BENCH)/%.o: CFLAGS = $(BENCH_CFLAGS)
+$(TARGET_BENCH)/%.o: $(SOURCE_BENCH)/%.c | $(TARGET_BENCH)
+	$(object)
+
+$(TARGET_BENCH)/compress: $(BENCH_COMPRESS_OBJECT) $(TARGET_LIB)/libaerospike.a | build prepare
+	$(executable) $(BENCH_LDFLAGS)
+
+$(TARGET_BENCH)/benchmark: $(BENCH_SUITE_OBJECT) $(TARGET_LIB)/libaerospike.a | build prepare
+	$(executable) $(BENCH_LDFLAGS)
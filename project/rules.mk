@@ -20,6 +20,9 @@ $(TARGET_INCL): | $(TARGET_BASE)
 $(TARGET_TEST): | $(TARGET_BASE)
 	mkdir $@
 
+$(TARGET_BENCH): | $(TARGET_BASE)
+	mkdir $@
+
 .PHONY: info
 info:
 	@echo
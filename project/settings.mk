@@ -49,6 +49,7 @@ SOURCE_PATH = $(SOURCE)
 SOURCE_MAIN = $(SOURCE_PATH)/main
 SOURCE_INCL = $(SOURCE_PATH)/include
 SOURCE_TEST = $(SOURCE_PATH)/test
+SOURCE_BENCH = $(SOURCE_PATH)/benchmark
 
 VPATH = $(SOURCE_MAIN) $(SOURCE_INCL)
 
@@ -65,6 +66,7 @@ TARGET_LIB  = $(TARGET_BASE)/lib
 TARGET_OBJ  = $(TARGET_BASE)/obj
 TARGET_INCL = $(TARGET_BASE)/include
 TARGET_TEST = $(TARGET_BASE)/test
+TARGET_BENCH = $(TARGET_BASE)/benchmark
 
 ###############################################################################
 ##  FUNCTIONS                                                                ##
@@ -18,10 +18,13 @@ TEST_AEROSPIKE += aerospike_string/*.c
 TEST_AEROSPIKE += aerospike_udf/*.c
 TEST_AEROSPIKE += policy/*.c
 TEST_AEROSPIKE += util/*.c
+TEST_AEROSPIKE += buffer_pool.c
+TEST_AEROSPIKE += cluster.c
 TEST_AEROSPIKE += filter_exp.c
 TEST_AEROSPIKE += exp_operate.c
 TEST_AEROSPIKE += transaction.c
 TEST_AEROSPIKE += transaction_async.c
+TEST_AEROSPIKE += tls.c
 
 TEST_SOURCE = $(wildcard $(addprefix $(SOURCE_TEST)/, $(TEST_AEROSPIKE)))
 
@@ -86,6 +89,10 @@ ifeq ($(EVENT_LIB),libevent)
   TEST_LDFLAGS += -levent_core -levent_pthreads
 endif
 
+ifeq ($(EVENT_LIB),liburing)
+  TEST_LDFLAGS += -luring
+endif
+
 TEST_LDFLAGS += -lssl -lcrypto -lpthread -lyaml -lm -lz $(LINK_SUFFIX)
 
 AS_HOST := 127.0.0.1
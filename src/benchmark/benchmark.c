@@ -0,0 +1,673 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+//==========================================================
+// Client micro-benchmark suite.
+//
+// Starts an in-process mock server (see mock_server.h) and measures client
+// throughput and latency for sync get/put/operate, batch, scan and query,
+// and async get/put with and without pipelining when the client is built
+// with an event library. Single threaded sync get is also measured with
+// socket spin mode (see aerospike_socket_spin()) to compare p50/p99 latency
+// against the default poll based socket waits. Results only reflect client
+// overhead and loopback networking, so they are useful for catching client
+// regressions.
+//
+
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_batch.h>
+#include <aerospike/aerospike_key.h>
+#include <aerospike/aerospike_query.h>
+#include <aerospike/aerospike_scan.h>
+#include <aerospike/as_atomic.h>
+#include <aerospike/as_event.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_query.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_scan.h>
+#include <citrusleaf/cf_clock.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "mock_server.h"
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+#define NAMESPACE "test"
+#define SET "bench"
+#define KEY_COUNT 100000
+
+// Log-linear histogram: 4 linear sub-buckets per power of 2 microseconds.
+#define HIST_SUB_BITS 2
+#define HIST_BUCKETS (64 << HIST_SUB_BITS)
+
+#define MAX_EVENT_LOOPS 64
+
+//---------------------------------
+// Types
+//---------------------------------
+
+typedef struct {
+	uint64_t buckets[HIST_BUCKETS];
+	uint64_t count;
+	uint64_t max_us;
+} histogram;
+
+typedef struct {
+	uint32_t threads;
+	uint32_t duration;
+	uint32_t bins;
+	uint32_t bin_size;
+	uint32_t batch_size;
+	uint32_t scan_records;
+	uint32_t async_concurrency;
+	uint32_t event_loops;
+	uint32_t spin_us;
+	char* value;
+} bench_config;
+
+struct worker_s;
+typedef as_status (*sync_fn)(struct worker_s* w, as_error* err, uint32_t i);
+
+typedef struct worker_s {
+	aerospike* as;
+	bench_config* cfg;
+	sync_fn fn;
+	uint64_t end_ms;
+	uint64_t ops;
+	uint64_t records;
+	uint64_t errors;
+	uint32_t id;
+	histogram hist;
+} worker;
+
+//---------------------------------
+// Histogram Functions
+//---------------------------------
+
+static inline uint32_t
+hist_index(uint64_t us)
+{
+	if (us < (1 << HIST_SUB_BITS)) {
+		return (uint32_t)us;
+	}
+
+	uint32_t msb = 63 - (uint32_t)__builtin_clzll(us);
+	uint32_t sub = (uint32_t)(us >> (msb - HIST_SUB_BITS)) & ((1 << HIST_SUB_BITS) - 1);
+	return ((msb - HIST_SUB_BITS + 1) << HIST_SUB_BITS) + sub;
+}
+
+static inline uint64_t
+hist_upper(uint32_t index)
+{
+	if (index < (1 << HIST_SUB_BITS)) {
+		return index + 1;
+	}
+
+	uint32_t msb = (index >> HIST_SUB_BITS) + HIST_SUB_BITS - 1;
+	uint64_t sub = index & ((1 << HIST_SUB_BITS) - 1);
+	return ((1ULL << msb) + ((sub + 1) << (msb - HIST_SUB_BITS)));
+}
+
+static inline void
+hist_add(histogram* h, uint64_t ns)
+{
+	uint64_t us = ns / 1000;
+	uint32_t index = hist_index(us);
+
+	if (index >= HIST_BUCKETS) {
+		index = HIST_BUCKETS - 1;
+	}
+	h->buckets[index]++;
+	h->count++;
+
+	if (us > h->max_us) {
+		h->max_us = us;
+	}
+}
+
+static void
+hist_merge(histogram* trg, const histogram* src)
+{
+	for (uint32_t i = 0; i < HIST_BUCKETS; i++) {
+		trg->buckets[i] += src->buckets[i];
+	}
+	trg->count += src->count;
+
+	if (src->max_us > trg->max_us) {
+		trg->max_us = src->max_us;
+	}
+}
+
+static uint64_t
+hist_percentile(const histogram* h, double pct)
+{
+	uint64_t limit = (uint64_t)((double)h->count * pct / 100.0);
+	uint64_t sum = 0;
+
+	for (uint32_t i = 0; i < HIST_BUCKETS; i++) {
+		sum += h->buckets[i];
+
+		if (sum > limit) {
+			return hist_upper(i);
+		}
+	}
+	return h->max_us;
+}
+
+static void
+print_header(void)
+{
+	printf("%-18s %12s %12s %9s %9s %9s %9s %8s\n", "workload", "ops/s", "records/s",
+		"p50(us)", "p90(us)", "p99(us)", "max(us)", "errors");
+}
+
+static void
+print_result(
+	const char* name, uint64_t ops, uint64_t records, uint64_t errors, uint64_t elapsed_ms,
+	const histogram* h
+	)
+{
+	double secs = (double)elapsed_ms / 1000.0;
+
+	printf("%-18s %12.0f %12.0f %9llu %9llu %9llu %9llu %8llu\n", name, (double)ops / secs,
+		(double)records / secs, (unsigned long long)hist_percentile(h, 50),
+		(unsigned long long)hist_percentile(h, 90), (unsigned long long)hist_percentile(h, 99),
+		(unsigned long long)h->max_us, (unsigned long long)errors);
+}
+
+//---------------------------------
+// Sync Workloads
+//---------------------------------
+
+static as_status
+run_get(worker* w, as_error* err, uint32_t i)
+{
+	as_key key;
+	as_key_init_int64(&key, NAMESPACE, SET, (int64_t)(i % KEY_COUNT));
+
+	as_record* rec = NULL;
+	as_status status = aerospike_key_get(w->as, err, NULL, &key, &rec);
+	as_record_destroy(rec);
+	w->records++;
+	return status;
+}
+
+static as_status
+run_put(worker* w, as_error* err, uint32_t i)
+{
+	as_key key;
+	as_key_init_int64(&key, NAMESPACE, SET, (int64_t)(i % KEY_COUNT));
+
+	as_record rec;
+	as_record_inita(&rec, (uint16_t)w->cfg->bins);
+
+	for (uint32_t b = 0; b < w->cfg->bins; b++) {
+		char name[16];
+		snprintf(name, sizeof(name), "b%u", b);
+		as_record_set_strp(&rec, name, w->cfg->value, false);
+	}
+
+	as_status status = aerospike_key_put(w->as, err, NULL, &key, &rec);
+	as_record_destroy(&rec);
+	w->records++;
+	return status;
+}
+
+static as_status
+run_operate(worker* w, as_error* err, uint32_t i)
+{
+	as_key key;
+	as_key_init_int64(&key, NAMESPACE, SET, (int64_t)(i % KEY_COUNT));
+
+	as_operations ops;
+	as_operations_inita(&ops, 2);
+	as_operations_add_incr(&ops, "counter", 1);
+	as_operations_add_read(&ops, "b0");
+
+	as_record* rec = NULL;
+	as_status status = aerospike_key_operate(w->as, err, NULL, &key, &ops, &rec);
+	as_operations_destroy(&ops);
+	as_record_destroy(rec);
+	w->records++;
+	return status;
+}
+
+static as_status
+run_batch(worker* w, as_error* err, uint32_t i)
+{
+	uint32_t n = w->cfg->batch_size;
+	as_batch_records records;
+	as_batch_records_init(&records, n);
+
+	for (uint32_t k = 0; k < n; k++) {
+		as_batch_read_record* r = as_batch_read_reserve(&records);
+		as_key_init_int64(&r->key, NAMESPACE, SET, (int64_t)((i * n + k) % KEY_COUNT));
+		r->read_all_bins = true;
+	}
+
+	as_status status = aerospike_batch_read(w->as, err, NULL, &records);
+	as_batch_records_destroy(&records);
+	w->records += n;
+	return status;
+}
+
+static bool
+count_records(const as_val* val, void* udata)
+{
+	if (val) {
+		as_incr_uint64((uint64_t*)udata);
+	}
+	return true;
+}
+
+static as_status
+run_scan(worker* w, as_error* err, uint32_t i)
+{
+	as_scan scan;
+	as_scan_init(&scan, NAMESPACE, SET);
+
+	uint64_t count = 0;
+	as_status status = aerospike_scan_foreach(w->as, err, NULL, &scan, count_records, &count);
+	as_scan_destroy(&scan);
+	w->records += count;
+	return status;
+}
+
+static as_status
+run_query(worker* w, as_error* err, uint32_t i)
+{
+	as_query query;
+	as_query_init(&query, NAMESPACE, SET);
+	as_query_where_inita(&query, 1);
+	as_query_where(&query, "b0", as_integer_range(0, 1000));
+
+	uint64_t count = 0;
+	as_status status = aerospike_query_foreach(w->as, err, NULL, &query, count_records, &count);
+	as_query_destroy(&query);
+	w->records += count;
+	return status;
+}
+
+static void*
+worker_run(void* udata)
+{
+	worker* w = udata;
+	as_error err;
+	uint32_t i = w->id * 7919;
+
+	while (cf_getms() < w->end_ms) {
+		uint64_t begin = cf_getns();
+		as_status status = w->fn(w, &err, i++);
+		hist_add(&w->hist, cf_getns() - begin);
+		w->ops++;
+
+		if (status != AEROSPIKE_OK) {
+			w->errors++;
+		}
+	}
+	return NULL;
+}
+
+static void
+run_sync(aerospike* as, bench_config* cfg, const char* name, sync_fn fn, uint32_t threads)
+{
+	worker* workers = calloc(threads, sizeof(worker));
+	pthread_t* tids = calloc(threads, sizeof(pthread_t));
+	uint64_t begin = cf_getms();
+	uint64_t end = begin + cfg->duration * 1000;
+
+	for (uint32_t i = 0; i < threads; i++) {
+		workers[i].as = as;
+		workers[i].cfg = cfg;
+		workers[i].fn = fn;
+		workers[i].end_ms = end;
+		workers[i].id = i;
+		pthread_create(&tids[i], NULL, worker_run, &workers[i]);
+	}
+
+	histogram* h = calloc(1, sizeof(histogram));
+	uint64_t ops = 0;
+	uint64_t records = 0;
+	uint64_t errors = 0;
+
+	for (uint32_t i = 0; i < threads; i++) {
+		pthread_join(tids[i], NULL);
+		hist_merge(h, &workers[i].hist);
+		ops += workers[i].ops;
+		records += workers[i].records;
+		errors += workers[i].errors;
+	}
+
+	print_result(name, ops, records, errors, cf_getms() - begin, h);
+	free(h);
+	free(tids);
+	free(workers);
+}
+
+//---------------------------------
+// Async Workloads
+//---------------------------------
+
+#if AS_EVENT_LIB_DEFINED
+
+typedef struct {
+	aerospike* as;
+	bench_config* cfg;
+	uint64_t end_ms;
+	bool put;
+	bool pipeline;
+	uint32_t active;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+
+	// Per event loop counters. Each loop only updates its own entry.
+	histogram hist[MAX_EVENT_LOOPS];
+	uint64_t ops[MAX_EVENT_LOOPS];
+	uint64_t errors[MAX_EVENT_LOOPS];
+} async_bench;
+
+typedef struct {
+	async_bench* ab;
+	as_event_loop* event_loop;
+	uint64_t begin;
+	uint32_t i;
+	as_key key;
+	as_record rec;
+} async_cmd;
+
+static void async_issue(async_cmd* cmd);
+
+static void
+async_done(async_cmd* cmd, as_error* err, as_event_loop* event_loop)
+{
+	async_bench* ab = cmd->ab;
+	uint32_t index = event_loop->index;
+
+	hist_add(&ab->hist[index], cf_getns() - cmd->begin);
+	ab->ops[index]++;
+
+	if (err) {
+		ab->errors[index]++;
+	}
+
+	if (cf_getms() < ab->end_ms) {
+		async_issue(cmd);
+		return;
+	}
+
+	pthread_mutex_lock(&ab->lock);
+
+	if (--ab->active == 0) {
+		pthread_cond_signal(&ab->cond);
+	}
+	pthread_mutex_unlock(&ab->lock);
+}
+
+static void
+async_read_listener(as_error* err, as_record* rec, void* udata, as_event_loop* event_loop)
+{
+	async_done(udata, err, event_loop);
+}
+
+static void
+async_write_listener(as_error* err, void* udata, as_event_loop* event_loop)
+{
+	async_done(udata, err, event_loop);
+}
+
+static void
+async_pipe_listener(void* udata, as_event_loop* event_loop)
+{
+}
+
+static void
+async_issue(async_cmd* cmd)
+{
+	async_bench* ab = cmd->ab;
+	as_pipe_listener pipe = ab->pipeline ? async_pipe_listener : NULL;
+	as_error err;
+	as_status status;
+
+	as_key_init_int64(&cmd->key, NAMESPACE, SET, (int64_t)(cmd->i++ % KEY_COUNT));
+	cmd->begin = cf_getns();
+
+	if (ab->put) {
+		status = aerospike_key_put_async(ab->as, &err, NULL, &cmd->key, &cmd->rec,
+			async_write_listener, cmd, cmd->event_loop, pipe);
+	}
+	else {
+		status = aerospike_key_get_async(ab->as, &err, NULL, &cmd->key, async_read_listener, cmd,
+			cmd->event_loop, pipe);
+	}
+
+	if (status != AEROSPIKE_OK) {
+		// Listener is not called when the command could not be queued.
+		async_done(cmd, &err, cmd->event_loop);
+	}
+}
+
+static void
+run_async(aerospike* as, bench_config* cfg, const char* name, bool put, bool pipeline)
+{
+	async_bench* ab = calloc(1, sizeof(async_bench));
+	ab->as = as;
+	ab->cfg = cfg;
+	ab->put = put;
+	ab->pipeline = pipeline;
+	ab->active = cfg->async_concurrency;
+	pthread_mutex_init(&ab->lock, NULL);
+	pthread_cond_init(&ab->cond, NULL);
+
+	uint32_t n = cfg->async_concurrency;
+	async_cmd* cmds = calloc(n, sizeof(async_cmd));
+	uint64_t begin = cf_getms();
+	ab->end_ms = begin + cfg->duration * 1000;
+
+	for (uint32_t i = 0; i < n; i++) {
+		async_cmd* cmd = &cmds[i];
+		cmd->ab = ab;
+		cmd->event_loop = as_event_loop_get_by_index(i % cfg->event_loops);
+		cmd->i = i * 7919;
+		as_record_init(&cmd->rec, (uint16_t)cfg->bins);
+
+		for (uint32_t b = 0; b < cfg->bins; b++) {
+			char bin[16];
+			snprintf(bin, sizeof(bin), "b%u", b);
+			as_record_set_strp(&cmd->rec, bin, cfg->value, false);
+		}
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		async_issue(&cmds[i]);
+	}
+
+	pthread_mutex_lock(&ab->lock);
+
+	while (ab->active > 0) {
+		pthread_cond_wait(&ab->cond, &ab->lock);
+	}
+	pthread_mutex_unlock(&ab->lock);
+
+	uint64_t elapsed = cf_getms() - begin;
+	histogram* h = calloc(1, sizeof(histogram));
+	uint64_t ops = 0;
+	uint64_t errors = 0;
+
+	for (uint32_t i = 0; i < cfg->event_loops; i++) {
+		hist_merge(h, &ab->hist[i]);
+		ops += ab->ops[i];
+		errors += ab->errors[i];
+	}
+
+	print_result(name, ops, ops, errors, elapsed, h);
+
+	for (uint32_t i = 0; i < n; i++) {
+		as_record_destroy(&cmds[i].rec);
+	}
+	free(h);
+	free(cmds);
+	pthread_cond_destroy(&ab->cond);
+	pthread_mutex_destroy(&ab->lock);
+	free(ab);
+}
+
+#endif
+
+//---------------------------------
+// Main
+//---------------------------------
+
+static void
+usage(const char* program)
+{
+	fprintf(stderr, "Usage: %s [options]\n", program);
+	fprintf(stderr, "  -t <threads>      Sync threads. Default: 8\n");
+	fprintf(stderr, "  -d <seconds>      Duration of each workload. Default: 3\n");
+	fprintf(stderr, "  -b <bins>         Bins per record. Default: 1\n");
+	fprintf(stderr, "  -s <bytes>        Bin value size. Default: 100\n");
+	fprintf(stderr, "  -k <keys>         Keys per batch. Default: 100\n");
+	fprintf(stderr, "  -r <records>      Records per scan/query. Default: 1000\n");
+	fprintf(stderr, "  -c <commands>     Async commands in flight. Default: 100\n");
+	fprintf(stderr, "  -l <loops>        Event loops. Default: 2\n");
+	fprintf(stderr, "  -p <micros>       Socket spin period for spin workload. Default: 100\n");
+}
+
+int
+main(int argc, char* argv[])
+{
+	bench_config cfg = {
+		.threads = 8,
+		.duration = 3,
+		.bins = 1,
+		.bin_size = 100,
+		.batch_size = 100,
+		.scan_records = 1000,
+		.async_concurrency = 100,
+		.event_loops = 2,
+		.spin_us = 100
+	};
+
+	int c;
+
+	while ((c = getopt(argc, argv, "t:d:b:s:k:r:c:l:p:h")) != -1) {
+		switch (c) {
+			case 't': cfg.threads = (uint32_t)atoi(optarg); break;
+			case 'd': cfg.duration = (uint32_t)atoi(optarg); break;
+			case 'b': cfg.bins = (uint32_t)atoi(optarg); break;
+			case 's': cfg.bin_size = (uint32_t)atoi(optarg); break;
+			case 'k': cfg.batch_size = (uint32_t)atoi(optarg); break;
+			case 'r': cfg.scan_records = (uint32_t)atoi(optarg); break;
+			case 'c': cfg.async_concurrency = (uint32_t)atoi(optarg); break;
+			case 'l': cfg.event_loops = (uint32_t)atoi(optarg); break;
+			case 'p': cfg.spin_us = (uint32_t)atoi(optarg); break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+
+	if (cfg.threads == 0 || cfg.bins == 0 || cfg.batch_size == 0 || cfg.event_loops == 0 ||
+		cfg.event_loops > MAX_EVENT_LOOPS || cfg.async_concurrency == 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	cfg.value = malloc(cfg.bin_size + 1);
+	memset(cfg.value, 'v', cfg.bin_size);
+	cfg.value[cfg.bin_size] = 0;
+
+	mock_server ms = {
+		.ns = NAMESPACE,
+		.n_bins = cfg.bins,
+		.bin_size = cfg.bin_size,
+		.scan_records = cfg.scan_records
+	};
+
+	if (!mock_server_start(&ms)) {
+		fprintf(stderr, "Failed to start mock server\n");
+		return 1;
+	}
+
+#if AS_EVENT_LIB_DEFINED
+	if (!as_event_create_loops(cfg.event_loops)) {
+		fprintf(stderr, "Failed to create event loops\n");
+		mock_server_stop(&ms);
+		return 1;
+	}
+#endif
+
+	as_config config;
+	as_config_init(&config);
+	as_config_add_host(&config, "127.0.0.1", ms.port);
+	config.max_conns_per_node = cfg.threads * 2 + 16;
+	config.async_max_conns_per_node = cfg.async_concurrency * 2;
+
+	aerospike as;
+	aerospike_init(&as, &config);
+
+	as_error err;
+
+	if (aerospike_connect(&as, &err) != AEROSPIKE_OK) {
+		fprintf(stderr, "Connect failed: %d %s\n", err.code, err.message);
+		aerospike_destroy(&as);
+		mock_server_stop(&ms);
+		return 1;
+	}
+
+	printf("Mock server port %u: %u threads, %us per workload, %u bins of %u bytes\n\n",
+		ms.port, cfg.threads, cfg.duration, cfg.bins, cfg.bin_size);
+	print_header();
+
+	run_sync(&as, &cfg, "sync get", run_get, cfg.threads);
+	run_sync(&as, &cfg, "sync put", run_put, cfg.threads);
+	run_sync(&as, &cfg, "sync operate", run_operate, cfg.threads);
+	run_sync(&as, &cfg, "sync batch", run_batch, cfg.threads);
+	run_sync(&as, &cfg, "sync scan", run_scan, 1);
+	run_sync(&as, &cfg, "sync query", run_query, 1);
+
+	// Compare single command latency with poll based socket waits and with socket spin mode.
+	run_sync(&as, &cfg, "sync get 1t", run_get, 1);
+
+	if (cfg.spin_us > 0) {
+		aerospike_socket_spin(cfg.spin_us, 0);
+		run_sync(&as, &cfg, "sync get 1t spin", run_get, 1);
+		aerospike_socket_spin(0, 0);
+	}
+
+#if AS_EVENT_LIB_DEFINED
+	run_async(&as, &cfg, "async get", false, false);
+	run_async(&as, &cfg, "async put", true, false);
+	run_async(&as, &cfg, "async get pipe", false, true);
+	run_async(&as, &cfg, "async put pipe", true, true);
+#else
+	printf("\nAsync workloads skipped. Build with EVENT_LIB=libev|libuv|libevent|liburing.\n");
+#endif
+
+	aerospike_close(&as, &err);
+	aerospike_destroy(&as);
+
+#if AS_EVENT_LIB_DEFINED
+	as_event_close_loops();
+#endif
+
+	mock_server_stop(&ms);
+	free(cfg.value);
+	return 0;
+}
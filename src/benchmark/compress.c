@@ -0,0 +1,241 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+//==========================================================
+// Compression micro-benchmark.
+//
+// Compares throughput and ratio of the client's command compression path
+// (as_command_compress/as_proto_decompress with reused per-thread zlib streams)
+// against one-shot zlib compress2/uncompress at several levels. Payloads are
+// msgpack encoded records that resemble typical user profile bins.
+//
+
+#include <aerospike/as_arraylist.h>
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_command.h>
+#include <aerospike/as_compress.h>
+#include <aerospike/as_double.h>
+#include <aerospike/as_integer.h>
+#include <aerospike/as_msgpack.h>
+#include <aerospike/as_orderedmap.h>
+#include <aerospike/as_proto.h>
+#include <aerospike/as_string.h>
+#include <citrusleaf/alloc.h>
+#include <citrusleaf/cf_clock.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+//---------------------------------
+// Constants
+//---------------------------------
+
+static const char* countries[] = {"US", "DE", "IN", "BR", "JP", "GB", "FR", "CA"};
+static const char* words[] = {
+	"premium", "mobile", "returning", "newsletter", "trial", "gold", "beta", "verified",
+	"android", "ios", "web", "partner"
+};
+
+static const size_t payload_sizes[] = {1024, 16 * 1024, 256 * 1024, 1024 * 1024};
+static const int levels[] = {1, 3, 6, 9};
+
+// Minimum bytes processed per measurement.
+#define BENCH_BYTES (256 * 1024 * 1024)
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static void
+append_record(as_serializer* ser, uint32_t id, uint8_t** p, uint8_t* end)
+{
+	char buf[64];
+	as_orderedmap map;
+	as_orderedmap_init(&map, 8);
+
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("id"), (as_val*)as_integer_new(id));
+
+	snprintf(buf, sizeof(buf), "user_%u", id);
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("name"),
+		(as_val*)as_string_new_strdup(buf));
+
+	snprintf(buf, sizeof(buf), "user_%u@example.com", id);
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("email"),
+		(as_val*)as_string_new_strdup(buf));
+
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("country"),
+		(as_val*)as_string_new_strdup(countries[rand() % 8]));
+
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("score"),
+		(as_val*)as_double_new((double)(rand() % 100000) / 100.0));
+
+	as_arraylist* tags = as_arraylist_new(5, 0);
+
+	for (uint32_t i = 0; i < 5; i++) {
+		as_arraylist_append_str(tags, words[rand() % 12]);
+	}
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("tags"), (as_val*)tags);
+
+	as_arraylist* history = as_arraylist_new(20, 0);
+	int64_t ts = 1700000000000LL + (int64_t)rand() * 1000;
+
+	for (uint32_t i = 0; i < 20; i++) {
+		ts += rand() % 86400000;
+		as_arraylist_append_int64(history, ts);
+	}
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("history"), (as_val*)history);
+
+	uint8_t* blob = cf_malloc(32);
+
+	for (uint32_t i = 0; i < 32; i++) {
+		blob[i] = (uint8_t)rand();
+	}
+	as_orderedmap_set(&map, (as_val*)as_string_new_strdup("token"),
+		(as_val*)as_bytes_new_wrap(blob, 32, true));
+
+	as_buffer buffer;
+	as_buffer_init(&buffer);
+	as_serializer_serialize(ser, (as_val*)&map, &buffer);
+
+	size_t n = buffer.size;
+
+	if (n > (size_t)(end - *p)) {
+		n = end - *p;
+	}
+	memcpy(*p, buffer.data, n);
+	*p += n;
+
+	as_buffer_destroy(&buffer);
+	as_orderedmap_destroy(&map);
+}
+
+static uint8_t*
+create_payload(size_t size)
+{
+	uint8_t* buf = cf_malloc(size);
+	uint8_t* p = buf + sizeof(as_proto);
+	uint8_t* end = buf + size;
+	as_serializer ser;
+	as_msgpack_init(&ser);
+	uint32_t id = 0;
+
+	while (p < end) {
+		append_record(&ser, id++, &p, end);
+	}
+	as_serializer_destroy(&ser);
+
+	// Payload is sent as a regular proto message.
+	as_proto* proto = (as_proto*)buf;
+	proto->version = AS_PROTO_VERSION;
+	proto->type = AS_MESSAGE_TYPE;
+	proto->sz = size - sizeof(as_proto);
+	as_proto_swap_to_be(proto);
+	return buf;
+}
+
+static double
+mb_per_sec(size_t bytes, uint64_t ns)
+{
+	return ((double)bytes / (1024.0 * 1024.0)) / ((double)ns / 1e9);
+}
+
+static void
+bench(uint8_t* src, size_t size, int level)
+{
+	uint32_t iterations = (uint32_t)(BENCH_BYTES / size);
+	size_t capacity = as_command_compress_max_size(size);
+	uint8_t* comp = cf_malloc(capacity);
+	uint8_t* out = cf_malloc(size);
+	size_t comp_size = 0;
+	as_error err;
+
+	// One-shot zlib, as used before contexts were reused.
+	uint64_t begin = cf_getns();
+
+	for (uint32_t i = 0; i < iterations; i++) {
+		uLongf len = (uLongf)capacity;
+		compress2(comp, &len, src, (uLong)size, level);
+	}
+
+	uint64_t zlib_comp_ns = cf_getns() - begin;
+	uLongf zlib_len = (uLongf)capacity;
+	compress2(comp, &zlib_len, src, (uLong)size, level);
+
+	begin = cf_getns();
+
+	for (uint32_t i = 0; i < iterations; i++) {
+		uLongf len = (uLongf)size;
+		uncompress(out, &len, comp, zlib_len);
+	}
+
+	uint64_t zlib_decomp_ns = cf_getns() - begin;
+
+	// Client command path.
+	begin = cf_getns();
+
+	for (uint32_t i = 0; i < iterations; i++) {
+		comp_size = capacity;
+		as_command_compress(&err, src, size, comp, &comp_size, level);
+	}
+
+	uint64_t client_comp_ns = cf_getns() - begin;
+
+	begin = cf_getns();
+
+	for (uint32_t i = 0; i < iterations; i++) {
+		as_proto_decompress(&err, out, size, comp + sizeof(as_proto),
+			comp_size - sizeof(as_proto));
+	}
+
+	uint64_t client_decomp_ns = cf_getns() - begin;
+
+	printf("%8zu %5d %7.3f %12.1f %12.1f %12.1f %12.1f\n", size, level,
+		(double)size / (double)comp_size,
+		mb_per_sec(size * iterations, zlib_comp_ns),
+		mb_per_sec(size * iterations, client_comp_ns),
+		mb_per_sec(size * iterations, zlib_decomp_ns),
+		mb_per_sec(size * iterations, client_decomp_ns));
+
+	cf_free(comp);
+	cf_free(out);
+}
+
+//---------------------------------
+// Main
+//---------------------------------
+
+int
+main(int argc, char* argv[])
+{
+	srand(1);
+
+	printf("%8s %5s %7s %12s %12s %12s %12s\n", "size", "level", "ratio", "zlib-comp",
+		"client-comp", "zlib-decomp", "client-decomp");
+	printf("%8s %5s %7s %12s %12s %12s %12s\n", "", "", "", "MB/s", "MB/s", "MB/s", "MB/s");
+
+	for (uint32_t i = 0; i < sizeof(payload_sizes) / sizeof(size_t); i++) {
+		size_t size = payload_sizes[i];
+		uint8_t* payload = create_payload(size);
+
+		for (uint32_t j = 0; j < sizeof(levels) / sizeof(int); j++) {
+			bench(payload, size, levels[j]);
+		}
+		cf_free(payload);
+	}
+	return 0;
+}
@@ -0,0 +1,696 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include "mock_server.h"
+#include <aerospike/as_command.h>
+#include <aerospike/as_proto.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+#define MOCK_NODE_NAME "BB9000000000001"
+#define MOCK_BUILD "8.1.0.0"
+#define MOCK_PARTITIONS 4096
+#define MOCK_MSG_SIZE 22
+
+// Multi-record responses are split into protos of about this size.
+#define MOCK_PROTO_CHUNK (128 * 1024)
+
+//---------------------------------
+// Types
+//---------------------------------
+
+typedef struct {
+	uint8_t* data;
+	size_t size;
+	size_t capacity;
+} mock_buffer;
+
+typedef struct {
+	mock_server* ms;
+	int fd;
+} mock_conn;
+
+//---------------------------------
+// Buffer Functions
+//---------------------------------
+
+static void
+mock_buffer_reserve(mock_buffer* b, size_t size)
+{
+	if (b->size + size > b->capacity) {
+		size_t capacity = b->capacity ? b->capacity : 4096;
+
+		while (capacity < b->size + size) {
+			capacity *= 2;
+		}
+		b->data = realloc(b->data, capacity);
+		b->capacity = capacity;
+	}
+}
+
+static void
+mock_buffer_append(mock_buffer* b, const void* data, size_t size)
+{
+	mock_buffer_reserve(b, size);
+	memcpy(b->data + b->size, data, size);
+	b->size += size;
+}
+
+static void
+mock_buffer_append_str(mock_buffer* b, const char* s)
+{
+	mock_buffer_append(b, s, strlen(s));
+}
+
+static void
+mock_buffer_append_u8(mock_buffer* b, uint8_t v)
+{
+	mock_buffer_append(b, &v, 1);
+}
+
+static void
+mock_buffer_append_u16(mock_buffer* b, uint16_t v)
+{
+	v = htons(v);
+	mock_buffer_append(b, &v, 2);
+}
+
+static void
+mock_buffer_append_u32(mock_buffer* b, uint32_t v)
+{
+	v = htonl(v);
+	mock_buffer_append(b, &v, 4);
+}
+
+static inline uint32_t
+mock_get_u32(const uint8_t* p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline uint16_t
+mock_get_u16(const uint8_t* p)
+{
+	return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static inline uint64_t
+mock_get_u64(const uint8_t* p)
+{
+	return ((uint64_t)mock_get_u32(p) << 32) | mock_get_u32(p + 4);
+}
+
+static void
+mock_put_proto(uint8_t* p, uint8_t type, uint64_t size)
+{
+	p[0] = AS_PROTO_VERSION;
+	p[1] = type;
+
+	for (int i = 0; i < 6; i++) {
+		p[2 + i] = (uint8_t)(size >> ((5 - i) * 8));
+	}
+}
+
+//---------------------------------
+// Response Functions
+//---------------------------------
+
+static size_t
+mock_proto_begin(mock_buffer* b)
+{
+	size_t begin = b->size;
+	mock_buffer_reserve(b, 8);
+	b->size += 8;
+	return begin;
+}
+
+static void
+mock_proto_end(mock_buffer* b, size_t begin, uint8_t type)
+{
+	mock_put_proto(b->data + begin, type, b->size - begin - 8);
+}
+
+static void
+mock_msg_write(
+	mock_buffer* b, uint8_t info3, uint8_t result_code, uint32_t ttl_or_index, uint16_t n_fields,
+	uint16_t n_ops
+	)
+{
+	mock_buffer_append_u8(b, MOCK_MSG_SIZE);
+	mock_buffer_append_u8(b, 0);
+	mock_buffer_append_u8(b, 0);
+	mock_buffer_append_u8(b, info3);
+	mock_buffer_append_u8(b, 0);
+	mock_buffer_append_u8(b, result_code);
+	mock_buffer_append_u32(b, 1); // generation
+	mock_buffer_append_u32(b, 0); // record ttl
+	mock_buffer_append_u32(b, ttl_or_index);
+	mock_buffer_append_u16(b, n_fields);
+	mock_buffer_append_u16(b, n_ops);
+}
+
+static void
+mock_record_write(mock_server* ms, mock_buffer* b, uint32_t index, bool no_bins)
+{
+	uint16_t n_ops = no_bins ? 0 : (uint16_t)ms->n_bins;
+	mock_msg_write(b, 0, AEROSPIKE_OK, index, 0, n_ops);
+
+	if (n_ops) {
+		mock_buffer_append(b, ms->ops, ms->ops_size);
+	}
+}
+
+static void
+mock_scan_record_write(mock_server* ms, mock_buffer* b, uint32_t i)
+{
+	mock_msg_write(b, 0, AEROSPIKE_OK, 0, 1, (uint16_t)ms->n_bins);
+
+	// Digest field. Spread records over partitions.
+	uint8_t digest[AS_DIGEST_VALUE_SIZE];
+	memset(digest, 0, sizeof(digest));
+	digest[0] = (uint8_t)i;
+	digest[1] = (uint8_t)((i >> 8) & 0x0F);
+	memcpy(&digest[2], &i, sizeof(i));
+
+	mock_buffer_append_u32(b, AS_DIGEST_VALUE_SIZE + 1);
+	mock_buffer_append_u8(b, AS_FIELD_DIGEST);
+	mock_buffer_append(b, digest, sizeof(digest));
+	mock_buffer_append(b, ms->ops, ms->ops_size);
+}
+
+static void
+mock_multi_write(mock_server* ms, mock_buffer* b, uint32_t count, bool batch, bool no_bins)
+{
+	size_t begin = mock_proto_begin(b);
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (batch) {
+			mock_record_write(ms, b, i, no_bins);
+		}
+		else {
+			mock_scan_record_write(ms, b, i);
+		}
+
+		if (b->size - begin >= MOCK_PROTO_CHUNK) {
+			mock_proto_end(b, begin, AS_MESSAGE_TYPE);
+			begin = mock_proto_begin(b);
+		}
+	}
+
+	mock_msg_write(b, AS_MSG_INFO3_LAST, AEROSPIKE_OK, 0, 0, 0);
+	mock_proto_end(b, begin, AS_MESSAGE_TYPE);
+}
+
+static void
+mock_handle_msg(mock_server* ms, uint8_t* body, size_t size, mock_buffer* b)
+{
+	if (size < MOCK_MSG_SIZE) {
+		return;
+	}
+
+	uint8_t info1 = body[1];
+	uint8_t info2 = body[2];
+	uint16_t n_fields = mock_get_u16(body + 18);
+	uint16_t n_ops = mock_get_u16(body + 20);
+	uint8_t* p = body + MOCK_MSG_SIZE;
+	uint8_t* end = body + size;
+	uint32_t batch_count = 0;
+	bool batch = false;
+	bool multi = false;
+
+	for (uint16_t i = 0; i < n_fields && p + 5 <= end; i++) {
+		uint32_t len = mock_get_u32(p);
+		uint8_t type = p[4];
+
+		switch (type) {
+			case AS_FIELD_BATCH_INDEX:
+				batch = true;
+				batch_count = mock_get_u32(p + 5);
+				break;
+
+			case AS_FIELD_PID_ARRAY:
+			case AS_FIELD_DIGEST_ARRAY:
+			case AS_FIELD_INDEX_RANGE:
+				multi = true;
+				break;
+
+			default:
+				break;
+		}
+		p += 4 + len;
+	}
+
+	bool no_bins = (info1 & AS_MSG_INFO1_GET_NOBINDATA) != 0;
+
+	if (batch) {
+		mock_multi_write(ms, b, batch_count, true, no_bins);
+		return;
+	}
+
+	if (multi) {
+		mock_multi_write(ms, b, ms->scan_records, false, no_bins);
+		return;
+	}
+
+	size_t begin = mock_proto_begin(b);
+
+	if ((info1 & AS_MSG_INFO1_READ) && !no_bins) {
+		// Read or operate with read ops.
+		mock_msg_write(b, 0, AEROSPIKE_OK, 0, 0, (uint16_t)ms->n_bins);
+		mock_buffer_append(b, ms->ops, ms->ops_size);
+	}
+	else {
+		// Write, delete, touch or exists.
+		(void)info2;
+		(void)n_ops;
+		mock_msg_write(b, 0, AEROSPIKE_OK, 0, 0, 0);
+	}
+	mock_proto_end(b, begin, AS_MESSAGE_TYPE);
+}
+
+static void
+mock_info_value(mock_server* ms, const char* name, mock_buffer* b)
+{
+	char buf[128];
+
+	if (strcmp(name, "node") == 0) {
+		mock_buffer_append_str(b, MOCK_NODE_NAME);
+	}
+	else if (strcmp(name, "build") == 0) {
+		mock_buffer_append_str(b, MOCK_BUILD);
+	}
+	else if (strcmp(name, "partition-generation") == 0 ||
+			 strcmp(name, "peers-generation") == 0 ||
+			 strcmp(name, "rebalance-generation") == 0) {
+		mock_buffer_append_str(b, "1");
+	}
+	else if (strncmp(name, "peers-", 6) == 0) {
+		snprintf(buf, sizeof(buf), "1,%u,[]", ms->port);
+		mock_buffer_append_str(b, buf);
+	}
+	else if (strncmp(name, "service-", 8) == 0) {
+		snprintf(buf, sizeof(buf), "127.0.0.1:%u", ms->port);
+		mock_buffer_append_str(b, buf);
+	}
+	else if (strcmp(name, "replicas") == 0) {
+		mock_buffer_append_str(b, ms->replicas);
+	}
+	else if (strcmp(name, "rack-ids") == 0) {
+		snprintf(buf, sizeof(buf), "%s:0", ms->ns);
+		mock_buffer_append_str(b, buf);
+	}
+	else if (strcmp(name, "partitions") == 0) {
+		snprintf(buf, sizeof(buf), "%u", MOCK_PARTITIONS);
+		mock_buffer_append_str(b, buf);
+	}
+	else if (strcmp(name, "cluster-name") == 0) {
+		mock_buffer_append_str(b, "mock");
+	}
+}
+
+static void
+mock_handle_info(mock_server* ms, uint8_t* body, size_t size, mock_buffer* b)
+{
+	size_t begin = mock_proto_begin(b);
+	char* p = (char*)body;
+	char* end = p + size;
+
+	while (p < end) {
+		char* name = p;
+
+		while (p < end && *p != '\n') {
+			p++;
+		}
+
+		if (p == end) {
+			break;
+		}
+		*p++ = 0;
+
+		if (*name == 0) {
+			continue;
+		}
+		mock_buffer_append_str(b, name);
+		mock_buffer_append_u8(b, '\t');
+		mock_info_value(ms, name, b);
+		mock_buffer_append_u8(b, '\n');
+	}
+	mock_proto_end(b, begin, AS_INFO_MESSAGE_TYPE);
+}
+
+//---------------------------------
+// Connection Functions
+//---------------------------------
+
+static bool
+mock_read_fully(int fd, uint8_t* buf, size_t size)
+{
+	size_t pos = 0;
+
+	while (pos < size) {
+		ssize_t rv = read(fd, buf + pos, size - pos);
+
+		if (rv <= 0) {
+			if (rv < 0 && errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		pos += (size_t)rv;
+	}
+	return true;
+}
+
+static bool
+mock_write_fully(int fd, const uint8_t* buf, size_t size)
+{
+	size_t pos = 0;
+
+	while (pos < size) {
+		ssize_t rv = write(fd, buf + pos, size - pos);
+
+		if (rv <= 0) {
+			if (rv < 0 && errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		pos += (size_t)rv;
+	}
+	return true;
+}
+
+static void
+mock_conn_remove(mock_server* ms, int fd)
+{
+	pthread_mutex_lock(&ms->lock);
+
+	for (uint32_t i = 0; i < ms->n_conns; i++) {
+		if (ms->conns[i] == fd) {
+			ms->conns[i] = ms->conns[--ms->n_conns];
+			break;
+		}
+	}
+	pthread_mutex_unlock(&ms->lock);
+}
+
+static void*
+mock_conn_run(void* udata)
+{
+	mock_conn* conn = udata;
+	mock_server* ms = conn->ms;
+	int fd = conn->fd;
+	free(conn);
+
+	mock_buffer req = {0};
+	mock_buffer inflated = {0};
+	mock_buffer rsp = {0};
+	uint8_t header[8];
+
+	while (ms->running && mock_read_fully(fd, header, sizeof(header))) {
+		uint8_t type = header[1];
+		size_t size = (size_t)(mock_get_u64(header) & 0xFFFFFFFFFFFFULL);
+
+		if (size > PROTO_SIZE_MAX) {
+			break;
+		}
+
+		req.size = 0;
+		mock_buffer_reserve(&req, size);
+
+		if (!mock_read_fully(fd, req.data, size)) {
+			break;
+		}
+
+		uint8_t* body = req.data;
+
+		if (type == AS_COMPRESSED_MESSAGE_TYPE) {
+			// Compressed body is the uncompressed size followed by a zlib compressed proto.
+			if (size < 8) {
+				break;
+			}
+
+			uLongf len = (uLongf)mock_get_u64(body);
+			inflated.size = 0;
+			mock_buffer_reserve(&inflated, len);
+
+			if (uncompress(inflated.data, &len, body + 8, (uLong)(size - 8)) != Z_OK || len < 8) {
+				break;
+			}
+			type = inflated.data[1];
+			body = inflated.data + 8;
+			size = len - 8;
+		}
+
+		rsp.size = 0;
+
+		if (type == AS_INFO_MESSAGE_TYPE) {
+			mock_handle_info(ms, body, size, &rsp);
+		}
+		else if (type == AS_MESSAGE_TYPE) {
+			mock_handle_msg(ms, body, size, &rsp);
+		}
+		else {
+			break;
+		}
+
+		if (!mock_write_fully(fd, rsp.data, rsp.size)) {
+			break;
+		}
+	}
+
+	mock_conn_remove(ms, fd);
+	close(fd);
+	free(req.data);
+	free(inflated.data);
+	free(rsp.data);
+	return NULL;
+}
+
+static void*
+mock_accept_run(void* udata)
+{
+	mock_server* ms = udata;
+
+	while (ms->running) {
+		int fd = accept(ms->listen_fd, NULL, NULL);
+
+		if (fd < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+
+		int flag = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+		pthread_mutex_lock(&ms->lock);
+
+		if (!ms->running) {
+			pthread_mutex_unlock(&ms->lock);
+			close(fd);
+			break;
+		}
+
+		if (ms->n_conns == ms->conns_capacity) {
+			ms->conns_capacity = ms->conns_capacity ? ms->conns_capacity * 2 : 64;
+			ms->conns = realloc(ms->conns, sizeof(int) * ms->conns_capacity);
+		}
+		ms->conns[ms->n_conns++] = fd;
+		pthread_mutex_unlock(&ms->lock);
+
+		mock_conn* conn = malloc(sizeof(mock_conn));
+		conn->ms = ms;
+		conn->fd = fd;
+
+		pthread_t thread;
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+		if (pthread_create(&thread, &attr, mock_conn_run, conn) != 0) {
+			mock_conn_remove(ms, fd);
+			close(fd);
+			free(conn);
+		}
+		pthread_attr_destroy(&attr);
+	}
+	return NULL;
+}
+
+//---------------------------------
+// Setup Functions
+//---------------------------------
+
+static void
+mock_build_ops(mock_server* ms)
+{
+	mock_buffer b = {0};
+	char name[16];
+	uint8_t* value = malloc(ms->bin_size);
+
+	for (uint32_t i = 0; i < ms->bin_size; i++) {
+		value[i] = (uint8_t)('a' + (i % 26));
+	}
+
+	for (uint32_t i = 0; i < ms->n_bins; i++) {
+		snprintf(name, sizeof(name), "b%u", i);
+		uint8_t name_len = (uint8_t)strlen(name);
+
+		mock_buffer_append_u32(&b, 4 + name_len + ms->bin_size);
+		mock_buffer_append_u8(&b, 1); // read op
+		mock_buffer_append_u8(&b, AS_BYTES_STRING);
+		mock_buffer_append_u8(&b, 0);
+		mock_buffer_append_u8(&b, name_len);
+		mock_buffer_append(&b, name, name_len);
+		mock_buffer_append(&b, value, ms->bin_size);
+	}
+	free(value);
+	ms->ops = b.data;
+	ms->ops_size = b.size;
+}
+
+static void
+mock_build_replicas(mock_server* ms)
+{
+	// Node owns every partition: <ns>:<regime>,<count>,<base64 bitmap>
+	static const char b64[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	uint8_t bitmap[MOCK_PARTITIONS / 8];
+	memset(bitmap, 0xFF, sizeof(bitmap));
+
+	size_t ns_len = strlen(ms->ns);
+	size_t enc_len = ((sizeof(bitmap) + 2) / 3) * 4;
+	char* s = malloc(ns_len + enc_len + 16);
+	char* p = s + sprintf(s, "%s:0,1,", ms->ns);
+
+	for (size_t i = 0; i < sizeof(bitmap); i += 3) {
+		uint32_t n = (uint32_t)bitmap[i] << 16;
+		size_t left = sizeof(bitmap) - i;
+
+		if (left > 1) {
+			n |= (uint32_t)bitmap[i + 1] << 8;
+		}
+
+		if (left > 2) {
+			n |= bitmap[i + 2];
+		}
+
+		*p++ = b64[(n >> 18) & 63];
+		*p++ = b64[(n >> 12) & 63];
+		*p++ = (left > 1) ? b64[(n >> 6) & 63] : '=';
+		*p++ = (left > 2) ? b64[n & 63] : '=';
+	}
+	*p++ = ';';
+	*p = 0;
+	ms->replicas = s;
+}
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+bool
+mock_server_start(mock_server* ms)
+{
+	ms->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+
+	if (ms->listen_fd < 0) {
+		return false;
+	}
+
+	int flag = 1;
+	setsockopt(ms->listen_fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+
+	if (bind(ms->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+		listen(ms->listen_fd, 1024) != 0) {
+		close(ms->listen_fd);
+		return false;
+	}
+
+	socklen_t len = sizeof(addr);
+	getsockname(ms->listen_fd, (struct sockaddr*)&addr, &len);
+	ms->port = ntohs(addr.sin_port);
+
+	mock_build_ops(ms);
+	mock_build_replicas(ms);
+
+	pthread_mutex_init(&ms->lock, NULL);
+	ms->conns = NULL;
+	ms->n_conns = 0;
+	ms->conns_capacity = 0;
+	ms->running = true;
+
+	if (pthread_create(&ms->accept_thread, NULL, mock_accept_run, ms) != 0) {
+		ms->running = false;
+		close(ms->listen_fd);
+		return false;
+	}
+	return true;
+}
+
+void
+mock_server_stop(mock_server* ms)
+{
+	pthread_mutex_lock(&ms->lock);
+	ms->running = false;
+
+	// Wake connection threads. Each thread closes its own descriptor.
+	for (uint32_t i = 0; i < ms->n_conns; i++) {
+		shutdown(ms->conns[i], SHUT_RDWR);
+	}
+	pthread_mutex_unlock(&ms->lock);
+
+	shutdown(ms->listen_fd, SHUT_RDWR);
+	close(ms->listen_fd);
+	pthread_join(ms->accept_thread, NULL);
+
+	// Wait for connection threads to exit.
+	for (int i = 0; i < 1000; i++) {
+		pthread_mutex_lock(&ms->lock);
+		uint32_t n = ms->n_conns;
+		pthread_mutex_unlock(&ms->lock);
+
+		if (n == 0) {
+			break;
+		}
+		usleep(1000);
+	}
+
+	free(ms->conns);
+	free(ms->ops);
+	free(ms->replicas);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//==========================================================
+// In-process mock Aerospike server.
+//
+// Listens on a loopback port and speaks enough of the wire protocol for a
+// single node cluster that owns every partition of one namespace:
+// - Info requests used by cluster tending (node, build, peers, replicas ...).
+// - Single record reads, writes, deletes and operates.
+// - Batch index requests. The node owns every key, so batch offsets are 0..n-1.
+// - Partition scans and queries, which return a fixed number of records.
+//
+// Every read returns the same prebuilt record and every write succeeds. The
+// server only exists to measure client side overhead without a real cluster.
+//
+
+//---------------------------------
+// Types
+//---------------------------------
+
+typedef struct mock_server_s {
+	const char* ns;
+	uint32_t n_bins;
+	uint32_t bin_size;
+	uint32_t scan_records;
+
+	int listen_fd;
+	uint16_t port;
+	volatile bool running;
+	pthread_t accept_thread;
+
+	pthread_mutex_t lock;
+	int* conns;
+	uint32_t n_conns;
+	uint32_t conns_capacity;
+
+	// Prebuilt record ops returned by reads.
+	uint8_t* ops;
+	size_t ops_size;
+
+	// Prebuilt replicas info value.
+	char* replicas;
+} mock_server;
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+/**
+ * Start mock server on an ephemeral loopback port. The port is stored in ms->port.
+ * ns, n_bins, bin_size and scan_records must be set before calling.
+ */
+bool
+mock_server_start(mock_server* ms);
+
+/**
+ * Close all connections and stop mock server.
+ */
+void
+mock_server_stop(mock_server* ms);
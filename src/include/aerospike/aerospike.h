@@ -335,6 +335,34 @@ aerospike_cluster_is_connected(aerospike* as);
 AS_EXTERN void
 aerospike_stop_on_interrupt(bool stop);
 
+/**
+ * Enable low latency mode for synchronous commands. Default is disabled.
+ *
+ * When spin_us is greater than zero, socket reads and writes retry the non-blocking
+ * call for up to spin_us microseconds before waiting on poll. This avoids a poll system
+ * call and thread wakeup when responses arrive quickly, at the cost of burning CPU on
+ * the calling thread while waiting. A value near the typical server response time
+ * (50-100 microseconds for in-memory namespaces) is a good starting point.
+ *
+ * When busy_poll_us is greater than zero, SO_BUSY_POLL is set to this value on new
+ * sockets (Linux only). This requires net.core.busy_read to be at least busy_poll_us
+ * or CAP_NET_ADMIN. Existing pooled connections are not affected, so call this function
+ * before aerospike_connect().
+ *
+ * Async commands and TLS connections are not affected.
+ *
+ * @code
+ * aerospike_socket_spin(100, 50);
+ * @endcode
+ *
+ * @param spin_us		Microseconds to spin on a socket before polling. Zero disables spinning.
+ * @param busy_poll_us	SO_BUSY_POLL value in microseconds. Zero leaves SO_BUSY_POLL unset.
+ *
+ * @relates aerospike
+ */
+AS_EXTERN void
+aerospike_socket_spin(uint32_t spin_us, uint32_t busy_poll_us);
+
 /**
  * Remove records in specified namespace/set efficiently.  This method is many orders of magnitude
  * faster than deleting records one at a time.
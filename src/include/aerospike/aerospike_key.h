@@ -125,6 +125,52 @@ aerospike_key_get_async(
 	as_pipe_listener pipe_listener
 	);
 
+/**
+ * Asynchronously look up multiple records by key and return all bins. Each key is read by a
+ * separate single record command and the listener is called once per key.
+ *
+ * All commands run on the same event loop. When called from a non event loop thread, the
+ * commands are queued to the event loop with one lock acquisition and one wakeup instead of
+ * one per command. This reduces submission overhead for fan-out workloads.
+ *
+ * If this function returns an error before any command is queued, the listener is not called
+ * for any key.
+ *
+ * @code
+ * void my_listener(as_error* err, as_record* record, void* udata, as_event_loop* event_loop)
+ * {
+ *     my_request* req = udata;
+ *
+ *     if (err) {
+ *         printf("Command %u failed: %d %s\n", req->index, err->code, err->message);
+ *         return;
+ *     }
+ *     // Process record bins
+ * }
+ *
+ * as_status status = aerospike_key_get_async_many(&as, &err, NULL, keys, n_keys, my_listener,
+ *     udata, NULL);
+ * @endcode
+ *
+ * @param as				The aerospike instance to use for this operation.
+ * @param err				The as_error to be populated if an error occurs.
+ * @param policy			The policy to use for this operation. If NULL, then the default policy will be used.
+ * @param keys				Array of record keys.
+ * @param n_keys			Number of keys.
+ * @param listener			User function to be called with command results.
+ * @param udata 			Array of n_keys user data pointers forwarded to user callback. May be NULL.
+ * @param event_loop 		Event loop assigned to run these commands. If NULL, an event loop will be chosen by round-robin.
+ *
+ * @return AEROSPIKE_OK if async commands successfully queued. Otherwise an error.
+ *
+ * @ingroup key_operations
+ */
+AS_EXTERN as_status
+aerospike_key_get_async_many(
+	aerospike* as, as_error* err, const as_policy_read* policy, const as_key* keys,
+	uint32_t n_keys, as_async_record_listener listener, void* udata[], as_event_loop* event_loop
+	);
+
 /**
  * Read a record's bins given the NULL terminated bins array argument.
  *
@@ -87,6 +87,7 @@
 #include <aerospike/as_policy.h>
 #include <aerospike/as_query.h>
 #include <aerospike/as_record.h>
+#include <aerospike/as_record_stream.h>
 #include <aerospike/as_status.h>
 #include <aerospike/as_stream.h>
 
@@ -217,6 +218,53 @@ aerospike_query_foreach(
 	aerospike_query_foreach_callback callback, void* udata
 	);
 
+/**
+ * Start a query and return a record stream that the application drains with
+ * as_record_stream_next(). Records are buffered in a queue of size
+ * "policy.record_queue_size". When the queue is full, node query threads stop reading
+ * from their sockets until records are consumed. Aggregation queries are not supported.
+ *
+ * The query runs in a background thread, so "query" and any policy expression must remain
+ * valid until as_record_stream_close() is called.
+ *
+ * @code
+ * as_query query;
+ * as_query_init(&query, "test", "demo");
+ * as_query_where(&query, "bin2", as_integer_equals(100));
+ *
+ * as_record_stream* stream;
+ *
+ * if (aerospike_query_stream(&as, &err, NULL, &query, &stream) == AEROSPIKE_OK) {
+ *     as_record* rec;
+ *
+ *     while (as_record_stream_next(stream, &err, &rec) == AEROSPIKE_OK && rec) {
+ *         // Process record
+ *         as_record_destroy(rec);
+ *     }
+ *
+ *     if (err.code != AEROSPIKE_OK) {
+ *         fprintf(stderr, "error(%d) %s at [%s:%d]", err.code, err.message, err.file, err.line);
+ *     }
+ *     as_record_stream_close(stream);
+ * }
+ * as_query_destroy(&query);
+ * @endcode
+ *
+ * @param as			Aerospike cluster instance.
+ * @param err			Error detail structure that is populated if an error occurs.
+ * @param policy		Query policy configuration parameters, pass in NULL for default.
+ * @param query			Query definition.
+ * @param stream		The record stream. Must be closed with as_record_stream_close().
+ *
+ * @return AEROSPIKE_OK on success, otherwise an error.
+ * @ingroup query_operations
+ */
+AS_EXTERN as_status
+aerospike_query_stream(
+	aerospike* as, as_error* err, const as_policy_query* policy, as_query* query,
+	as_record_stream** stream
+	);
+
 /**
  * Query records with a partition filter. Multiple threads will likely be calling the callback
  * in parallel. Therefore, your callback implementation should be thread safe.
@@ -161,6 +161,26 @@ typedef struct as_cluster_stats_s {
 	*/
 	uint64_t retry_count;
 
+	/**
+	 * Count of hedged reads since cluster was started.
+	 */
+	uint64_t hedge_count;
+
+	/**
+	 * Count of hedged reads where the hedge command answered first.
+	 */
+	uint64_t hedge_win_count;
+
+	/**
+	 * Count of TLS connections that resumed a cached session.
+	 */
+	uint64_t tls_session_hit_count;
+
+	/**
+	 * Count of TLS connections that performed a full handshake.
+	 */
+	uint64_t tls_session_miss_count;
+
 	/**
 	 * Node count.
 	 */
@@ -181,6 +201,12 @@ typedef struct as_cluster_stats_s {
 	 * Count of sync sockets currently in timeout recovery.
 	 */
 	uint32_t recover_queue_size;
+
+	/**
+	 * Count of partition map entries (partition and replica) that changed node in the most
+	 * recent cluster tend iteration.
+	 */
+	uint32_t partitions_changed;
 } as_cluster_stats;
 
 struct as_cluster_s;
@@ -118,6 +118,7 @@ as_async_write_command_create(
 	cmd->ubuf = ubuf;
 	cmd->ubuf_size = ubuf_size;
 	cmd->latency_type = AS_LATENCY_TYPE_WRITE;
+	cmd->hedge_delay = 0;
 	wcmd->listener = listener;
 	as_cluster_add_command_count(cluster);
 	return cmd;
@@ -174,6 +175,7 @@ as_async_record_command_create(
 	cmd->ubuf = ubuf;
 	cmd->ubuf_size = ubuf_size;
 	cmd->latency_type = latency_type;
+	cmd->hedge_delay = 0;
 	rcmd->listener = listener;
 	as_cluster_add_command_count(cluster);
 	return cmd;
@@ -220,6 +222,7 @@ as_async_value_command_create(
 	cmd->ubuf = ubuf;
 	cmd->ubuf_size = ubuf_size;
 	cmd->latency_type = AS_LATENCY_TYPE_WRITE;
+	cmd->hedge_delay = 0;
 	vcmd->listener = listener;
 	as_cluster_add_command_count(cluster);
 	return cmd;
@@ -263,6 +266,7 @@ as_async_info_command_create(
 	cmd->ubuf = NULL;
 	cmd->ubuf_size = 0;
 	cmd->latency_type = AS_LATENCY_TYPE_NONE;
+	cmd->hedge_delay = 0;
 	icmd->listener = listener;
 	as_cluster_add_command_count(node->cluster);
 	return cmd;
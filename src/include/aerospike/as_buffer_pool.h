@@ -0,0 +1,148 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#pragma once
+
+#include <aerospike/as_std.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+/**
+ * @private
+ * Smallest buffer size class is 16KB (1 << 14).
+ */
+#define AS_BUFFER_POOL_MIN_SHIFT 14
+
+/**
+ * @private
+ * Number of power of 2 size classes. The largest size class is 16MB (1 << 24).
+ * Larger buffers are allocated and freed directly.
+ */
+#define AS_BUFFER_POOL_CLASSES 11
+
+/**
+ * @private
+ * Maximum number of cached buffers per size class.
+ */
+#define AS_BUFFER_POOL_CLASS_CAPACITY 4
+
+/**
+ * @private
+ * Maximum total bytes of cached buffers per pool.
+ */
+#define AS_BUFFER_POOL_MAX_BYTES (32 * 1024 * 1024)
+
+/**
+ * @private
+ * Maximum total bytes of cached buffers per pool when no buffers are handed out.
+ */
+#define AS_BUFFER_POOL_IDLE_BYTES (4 * 1024 * 1024)
+
+/**
+ * @private
+ * Number of pool gets and puts between high-water trims.
+ */
+#define AS_BUFFER_POOL_TRIM_INTERVAL 1024
+
+//---------------------------------
+// Types
+//---------------------------------
+
+/**
+ * @private
+ * Cached buffers of one size class.
+ */
+typedef struct as_buffer_pool_class_s {
+	uint8_t* buffers[AS_BUFFER_POOL_CLASS_CAPACITY];
+
+	// Number of cached buffers.
+	uint32_t size;
+
+	// Number of buffers currently handed out.
+	uint32_t in_use;
+
+	// Maximum buffers handed out at the same time since last trim.
+	uint32_t high_water;
+} as_buffer_pool_class;
+
+/**
+ * @private
+ * Size classed buffer cache. A pool is not thread-safe. Each sync command thread uses its own
+ * thread-local pool and each event loop has its own pool.
+ *
+ * Every AS_BUFFER_POOL_TRIM_INTERVAL gets and puts, each size class releases cached buffers
+ * that were not needed since the last trim, so memory returns to the allocator when large
+ * batch/query responses stop. When the last handed out buffer is returned, the largest cached
+ * buffers are also released until at most AS_BUFFER_POOL_IDLE_BYTES remain, so a thread that
+ * goes idle does not hold up to AS_BUFFER_POOL_MAX_BYTES.
+ */
+typedef struct as_buffer_pool_s {
+	as_buffer_pool_class classes[AS_BUFFER_POOL_CLASSES];
+	size_t cached_bytes;
+	uint32_t in_use;
+	uint32_t ops;
+} as_buffer_pool;
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+/**
+ * @private
+ * Initialize buffer pool.
+ */
+void
+as_buffer_pool_init(as_buffer_pool* pool);
+
+/**
+ * @private
+ * Free all cached buffers.
+ */
+void
+as_buffer_pool_destroy(as_buffer_pool* pool);
+
+/**
+ * @private
+ * Get buffer with at least the requested size. The buffer's full capacity is returned in
+ * capacity when not NULL.
+ */
+uint8_t*
+as_buffer_pool_get(as_buffer_pool* pool, size_t size, size_t* capacity);
+
+/**
+ * @private
+ * Return buffer to pool. Size can be either the size passed to as_buffer_pool_get() or the
+ * returned capacity.
+ */
+void
+as_buffer_pool_put(as_buffer_pool* pool, uint8_t* buf, size_t size);
+
+/**
+ * @private
+ * Return buffer pool for the current thread. The pool is freed when the thread exits.
+ */
+as_buffer_pool*
+as_buffer_pool_thread(void);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
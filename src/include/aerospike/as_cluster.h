@@ -198,6 +198,13 @@ typedef struct as_cluster_s {
 	 * Pool of threads used to query server nodes in parallel for batch, scan and query.
 	 */
 	as_thread_pool thread_pool;
+
+	/**
+	 * @private
+	 * Pool of threads used to tend nodes in parallel. Only initialized when
+	 * tend_thread_pool_size is greater than zero.
+	 */
+	as_thread_pool tend_thread_pool;
 		
 	/**
 	 * @private
@@ -337,7 +344,7 @@ typedef struct as_cluster_s {
 
 	/**
 	 * @private
-	 * AS_POLICY_REPLICA_ANY index counter.
+	 * AS_POLICY_REPLICA_ANY and AS_POLICY_REPLICA_FASTEST index counter.
 	 */
 	uint32_t replica_index_any;
 
@@ -353,12 +360,32 @@ typedef struct as_cluster_s {
 	 */
 	uint32_t invalid_node_count;
 
+	/**
+	 * @private
+	 * Count of partition map entries that changed node in the most recent cluster tend
+	 * iteration.
+	 */
+	uint32_t partitions_changed;
+
+	/**
+	 * @private
+	 * Count of partition map entries changed so far in the current cluster tend iteration.
+	 * Only accessed by the tend thread.
+	 */
+	uint32_t tend_partitions_changed;
+
 	/**
 	 * @private
 	 * Assign tend thread to this specific CPU ID.
 	 */
 	int tend_thread_cpu;
 
+	/**
+	 * @private
+	 * Number of threads in tend_thread_pool. Zero means nodes are tended sequentially.
+	 */
+	uint32_t tend_thread_pool_size;
+
 	/**
 	 * @private
 	 * Authentication mode.
@@ -371,6 +398,18 @@ typedef struct as_cluster_s {
 	 */
 	uint16_t n_partitions;
 	
+	/**
+	 * @private
+	 * Select sync connection pool by calling thread instead of round-robin.
+	 */
+	bool conn_pool_thread_affinity;
+
+	/**
+	 * @private
+	 * zlib compression level for compressed commands.
+	 */
+	int compression_level;
+
 	/**
 	 * @private
 	 * If alternate services info commands should be used.
@@ -442,6 +481,12 @@ typedef struct as_cluster_s {
 	 */
 	uint8_t metrics_latency_shift;
 
+	/**
+	 * @private
+	 * Use microsecond log-linear latency histograms. This is set using as_policy_metrics.
+	 */
+	bool metrics_latency_micros;
+
 	/**
 	 * @private
 	 * Number of cluster tend iterations between metrics notification events. One tend iteration
@@ -481,6 +526,19 @@ typedef struct as_cluster_s {
 	 */
 	uint64_t delay_queue_timeout_count;
 
+	/**
+	 * @private
+	 * Hedged read count. The value is cumulative and not reset per metrics interval.
+	 */
+	uint64_t hedge_count;
+
+	/**
+	 * @private
+	 * Count of hedged reads where the hedge command answered first.
+	 * The value is cumulative and not reset per metrics interval.
+	 */
+	uint64_t hedge_win_count;
+
 	/**
 	 * @private
 	 * Aerospike back pointer.
@@ -737,6 +795,46 @@ as_cluster_get_delay_queue_timeout_count(const as_cluster* cluster)
 	return as_load_uint64(&cluster->delay_queue_timeout_count);
 }
 
+/**
+ * @private
+ * Increment hedged read count.
+ */
+static inline void
+as_cluster_add_hedge(as_cluster* cluster)
+{
+	as_incr_uint64(&cluster->hedge_count);
+}
+
+/**
+ * @private
+ * Return hedged read count. The value is cumulative and not reset per metrics interval.
+ */
+static inline uint64_t
+as_cluster_get_hedge_count(const as_cluster* cluster)
+{
+	return as_load_uint64(&cluster->hedge_count);
+}
+
+/**
+ * @private
+ * Increment count of hedged reads where the hedge command answered first.
+ */
+static inline void
+as_cluster_add_hedge_win(as_cluster* cluster)
+{
+	as_incr_uint64(&cluster->hedge_win_count);
+}
+
+/**
+ * @private
+ * Return count of hedged reads where the hedge command answered first.
+ */
+static inline uint64_t
+as_cluster_get_hedge_win_count(const as_cluster* cluster)
+{
+	return as_load_uint64(&cluster->hedge_win_count);
+}
+
 /**
  * @private
  * Get a count of the number of sockets currently waiting for timeout recovery.
@@ -18,6 +18,7 @@
 
 #include <aerospike/as_bin.h>
 #include <aerospike/as_buffer.h>
+#include <aerospike/as_buffer_pool.h>
 #include <aerospike/as_cluster.h>
 #include <aerospike/as_key.h>
 #include <aerospike/as_operations.h>
@@ -40,6 +41,7 @@ extern "C" {
 #define AS_COMMAND_FLAGS_LINEARIZE 4
 #define AS_COMMAND_FLAGS_SPLIT_RETRY 8
 #define AS_COMMAND_FLAGS_TXN_MONITOR 16
+#define AS_COMMAND_FLAGS_GATHER 32
 
 // Field IDs
 #define AS_FIELD_NAMESPACE 0
@@ -151,15 +153,29 @@ local_free(void* memory)
 
 /**
  * @private
- * Allocate command buffer on stack or heap depending on given size.
+ * Allocate command buffer on stack or from the thread's buffer pool depending on given size.
  */
-#define as_command_buffer_init(_sz) (_sz > AS_STACK_BUF_SIZE) ? (uint8_t*)local_malloc(_sz) : (uint8_t*)alloca(_sz)
+#define as_command_buffer_init(_sz) (_sz > AS_STACK_BUF_SIZE) ? as_buffer_pool_get(as_buffer_pool_thread(), _sz, NULL) : (uint8_t*)alloca(_sz)
 
 /**
  * @private
- * Free command buffer.
+ * Free command buffer. Must be called on the thread that allocated the buffer.
  */
-#define as_command_buffer_free(_buf, _sz) if (_sz > AS_STACK_BUF_SIZE) {local_free(_buf);}
+#define as_command_buffer_free(_buf, _sz) if (_sz > AS_STACK_BUF_SIZE) {as_buffer_pool_put(as_buffer_pool_thread(), _buf, _sz);}
+
+/**
+ * @private
+ * Minimum string or blob bin value size that is sent from the caller's memory instead of
+ * being copied into the command buffer.
+ */
+#define AS_COMMAND_GATHER_MIN (16 * 1024)
+
+/**
+ * @private
+ * Maximum number of bin values sent by reference in one command. Each value splits the
+ * command buffer, so a command needs up to two segments per value plus the trailing segment.
+ */
+#define AS_COMMAND_GATHER_MAX ((AS_SOCKET_IOV_MAX - 1) / 2)
 
 //---------------------------------
 // Types
@@ -174,6 +190,18 @@ typedef size_t (*as_write_fn) (void* udata, uint8_t* buf);
 struct as_command_s;
 struct as_txn;
 
+/**
+ * @private
+ * Command buffer segments interleaved with large bin values that are sent in place.
+ */
+typedef struct as_command_gather_s {
+	as_iovec iov[AS_SOCKET_IOV_MAX];
+	uint8_t* begin; // Start of the command buffer segment not yet added to iov.
+	size_t size; // Total size of bin values sent in place.
+	uint32_t iov_size;
+	uint32_t n_values;
+} as_command_gather;
+
 /**
  * @private
  * Parse results callback used in as_command_execute().
@@ -197,6 +225,7 @@ typedef struct as_command_s {
 	void* udata;
 	uint8_t* buf;
 	size_t buf_size;
+	as_command_gather* gather; // Only valid when AS_COMMAND_FLAGS_GATHER is set.
 	uint32_t partition_id;
 	as_policy_replica replica;
 	uint64_t deadline_ms;
@@ -205,6 +234,7 @@ typedef struct as_command_s {
 	uint32_t max_retries;
 	uint32_t iteration;
 	uint32_t sent;
+	uint32_t hedge_delay;
 	uint8_t flags;
 	uint8_t replica_size;
 	uint8_t replica_index;
@@ -229,6 +259,7 @@ typedef struct as_command_txn_data_s {
 typedef struct as_command_parse_result_data_s {
 	as_record** record;
 	bool deserialize;
+	bool bin_arena;
 } as_command_parse_result_data;
 
 //---------------------------------
@@ -561,6 +592,38 @@ as_command_write_bin(
 	uint8_t* begin, as_operator operation_type, const as_bin* bin, as_queue* buffers
 	);
 
+/**
+ * @private
+ * Write bin. String and blob values of at least AS_COMMAND_GATHER_MIN bytes are added to
+ * gather by reference instead of being copied into the command buffer.
+ */
+uint8_t*
+as_command_write_bin_gather(
+	uint8_t* begin, as_operator operation_type, const as_bin* bin, as_queue* buffers,
+	as_command_gather* gather
+	);
+
+/**
+ * @private
+ * Return total size of bin values that as_command_write_bin_gather() will send by reference.
+ * Bins must be written in the same order.
+ */
+size_t
+as_command_gather_size(const as_bin* bins, uint16_t n_bins);
+
+/**
+ * @private
+ * Start gathering a command that is written to the given buffer.
+ */
+static inline void
+as_command_gather_init(as_command_gather* gather, uint8_t* buf)
+{
+	gather->begin = buf;
+	gather->size = 0;
+	gather->iov_size = 0;
+	gather->n_values = 0;
+}
+
 /**
  * @private
  * Finish writing command.
@@ -574,6 +637,26 @@ as_command_write_end(uint8_t* begin, uint8_t* end)
 	return len;
 }
 
+/**
+ * @private
+ * Finish writing gathered command. The proto size includes the bin values sent by reference.
+ * Return full command size.
+ */
+static inline size_t
+as_command_gather_write_end(as_command_gather* gather, uint8_t* begin, uint8_t* end)
+{
+	if (end > gather->begin) {
+		as_iovec* iov = &gather->iov[gather->iov_size++];
+		iov->iov_base = gather->begin;
+		iov->iov_len = end - gather->begin;
+	}
+
+	uint64_t len = (end - begin) + gather->size;
+	uint64_t proto = (len - 8) | ((uint64_t)AS_PROTO_VERSION << 56) | ((uint64_t)AS_MESSAGE_TYPE << 48);
+	*(uint64_t*)begin = cf_swap_to_be64(proto);
+	return len;
+}
+
 /**
  * @private
  * Finish writing compressed command.
@@ -600,7 +683,10 @@ as_command_compress_max_size(size_t cmd_sz);
  * Compress command buffer.
  */
 as_status
-as_command_compress(as_error* err, uint8_t* cmd, size_t cmd_sz, uint8_t* compressed_cmd, size_t* compressed_size);
+as_command_compress(
+	as_error* err, uint8_t* cmd, size_t cmd_sz, uint8_t* compressed_cmd, size_t* compressed_size,
+	int level
+	);
 
 /**
  * @private
@@ -650,6 +736,16 @@ as_command_send(
 	as_command* cmd, as_error* err, uint32_t comp_threshold, as_write_fn write_fn, void* udata
 	);
 
+/**
+ * @private
+ * Write gathered command and send it to the server without compression.
+ * The command buffer size must exclude the bin values sent by reference.
+ */
+as_status
+as_command_send_gather(
+	as_command* cmd, as_error* err, as_command_gather* gather, as_write_fn write_fn, void* udata
+	);
+
 /**
  * @private
  * Send command to the server.
@@ -735,10 +831,14 @@ as_command_parse_success_failure_bins(uint8_t** pp, as_error* err, as_msg* msg,
 
 /**
  * @private
- * Parse bins received from the server.
+ * Parse bins received from the server.  If borrow is true, blob values and undeserialized
+ * list/map bytes reference the response buffer instead of being copied.  Borrowed values are
+ * only valid until the response buffer is released.
  */
 as_status
-as_command_parse_bins(uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bins, bool deserialize);
+as_command_parse_bins(
+	uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bins, bool deserialize, bool borrow
+	);
 
 /**
  * @private
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#pragma once
+
+#include <aerospike/as_std.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+/**
+ * Fastest zlib compression level.
+ */
+#define AS_COMPRESS_LEVEL_MIN 1
+
+/**
+ * Best ratio zlib compression level.
+ */
+#define AS_COMPRESS_LEVEL_MAX 9
+
+/**
+ * Default zlib compression level (Z_BEST_SPEED).
+ */
+#define AS_COMPRESS_LEVEL_DEFAULT AS_COMPRESS_LEVEL_MIN
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+/**
+ * @private
+ * Return upper bound of compressed size for the given source size.
+ */
+size_t
+as_compress_bound(size_t src_sz);
+
+/**
+ * @private
+ * Compress src into trg using zlib format. On input, trg_sz is the capacity of trg.
+ * On output, trg_sz is the compressed size. Return zlib status code (0 on success).
+ *
+ * Each thread keeps its own deflate stream, which is reset instead of reallocated
+ * between calls.
+ */
+int
+as_compress(uint8_t* trg, size_t* trg_sz, const uint8_t* src, size_t src_sz, int level);
+
+/**
+ * @private
+ * Decompress zlib format src into trg. On input, trg_sz is the capacity of trg.
+ * On output, trg_sz is the decompressed size. Return zlib status code (0 on success).
+ *
+ * Each thread keeps its own inflate stream, which is reset instead of reallocated
+ * between calls.
+ */
+int
+as_decompress(uint8_t* trg, size_t* trg_sz, const uint8_t* src, size_t src_sz);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
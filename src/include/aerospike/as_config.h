@@ -16,6 +16,7 @@
  */
 #pragma once 
 
+#include <aerospike/as_compress.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_host.h>
 #include <aerospike/as_policy.h>
@@ -353,6 +354,23 @@ typedef struct as_config_tls_s {
 	 */
 	bool for_login_only;
 
+	/**
+	 * Install TLS session keys into the kernel (kTLS) after the handshake, so
+	 * encryption is done by the kernel and TLS sockets are read and written as
+	 * plain sockets. Requires Linux kTLS support and OpenSSL 3.0+ built with kTLS.
+	 * Connections fall back to user space TLS when offload is not available.
+	 * The libuv event loop always uses user space TLS.
+	 * Default: false
+	 */
+	bool ktls;
+
+	/**
+	 * Cache TLS sessions per node address and TLS name and resume them on new sync,
+	 * async and pipeline connections. Resumed connections skip the full handshake.
+	 * Default: true
+	 */
+	bool session_cache;
+
 } as_config_tls;
 
 /**
@@ -608,6 +626,20 @@ typedef struct as_config_s {
 	 */
 	uint32_t conn_pools_per_node;
 
+	/**
+	 * Assign each calling thread a home synchronous connection pool when conn_pools_per_node
+	 * is greater than one.  By default, a pool is selected round-robin on every command.
+	 *
+	 * When enabled, a thread always starts with the same pool, so threads are spread evenly
+	 * over the pool locks and a connection tends to be reused by the same thread.  If the
+	 * home pool is empty, an idle connection is borrowed from one of the node's other pools
+	 * that is not currently locked before a new connection is created.  Borrowed connections
+	 * are returned to the pool they came from, so min/max connection limits are unchanged.
+	 *
+	 * Default: false
+	 */
+	bool conn_pool_thread_affinity;
+
 	/**
 	 * Cluster tend info command timeout in milliseconds.
 	 *
@@ -690,12 +722,50 @@ typedef struct as_config_s {
 	 */
 	uint32_t thread_pool_size;
 
+	/**
+	 * Run concurrent synchronous batch commands (as_policy_batch.concurrent) that use
+	 * as_batch_records on the async event loops instead of the thread pool.  Node commands
+	 * are sent with non-blocking sockets on an event loop and the calling thread waits once
+	 * for the entire batch, so batch fan-out is limited by async connections instead of
+	 * thread_pool_size.
+	 *
+	 * Event loops must be created before this field takes effect.  Batches issued from an
+	 * event loop thread and batches that use as_batch keys still use the thread pool.
+	 *
+	 * Default: false
+	 */
+	bool sync_batch_event_loops;
+
 	/**
 	 * Assign tend thread to this specific CPU ID.
 	 * Default: -1 (Any CPU).
 	 */
 	int tend_thread_cpu;
 
+	/**
+	 * Number of threads used to tend cluster nodes in parallel.  If zero, the tend thread
+	 * refreshes nodes one at a time, so a slow node delays the refresh of every node after it.
+	 * If greater than zero, node status, peers, partition map and rack info requests are sent
+	 * to all nodes concurrently from a dedicated thread pool of this size.  The tend thread
+	 * then applies peers and partition map updates in node order after all nodes have replied.
+	 *
+	 * Parallel tend is recommended for large clusters.  Shared memory (use_shm) prole tenders
+	 * are not affected by this setting.
+	 *
+	 * Default: 0
+	 */
+	uint32_t tend_thread_pool_size;
+
+	/**
+	 * zlib compression level (1-9) used for commands when the policy compress option is enabled.
+	 * Lower levels use less cpu and produce larger commands.  Level 1 (Z_BEST_SPEED) is usually
+	 * the best choice on fast networks.  Server responses are compressed by the server and are
+	 * not affected by this setting.
+	 *
+	 * Default: 1
+	 */
+	int compression_level;
+
 	/**
 	 * Client policies
 	 */
@@ -106,8 +106,11 @@ extern "C" {
 #define AS_BATCH_ALLOW_INLINE_SSD 11
 #define AS_BATCH_RESPOND_ALL_KEYS 12
 
-// 112 total bits / 8 = 14 bytes
-#define AS_CONFIG_BITMAP_SIZE 14
+#define AS_METRICS_LATENCY_MICROS 112
+#define AS_METRICS_LATENCY_DELTA 113
+
+// 114 total bits / 8 = 15 bytes (rounded up)
+#define AS_CONFIG_BITMAP_SIZE 15
 
 //---------------------------------
 // Types
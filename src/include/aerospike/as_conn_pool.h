@@ -78,6 +78,24 @@ as_conn_pool_pop_head(as_conn_pool* pool, as_socket* sock)
 	return status;
 }
 
+/**
+ * @private
+ * Pop connection from head of pool only if the pool lock is not held by another thread.
+ * Used when borrowing connections from a node's other pools, so a thread never blocks
+ * on a pool that is not its own.
+ */
+static inline bool
+as_conn_pool_try_pop_head(as_conn_pool* pool, as_socket* sock)
+{
+	if (pthread_mutex_trylock(&pool->lock) != 0) {
+		return false;
+	}
+
+	bool status = as_queue_pop(&pool->queue, sock);
+	pthread_mutex_unlock(&pool->lock);
+	return status;
+}
+
 /**
  * @private
  * Pop connection from tail of pool.
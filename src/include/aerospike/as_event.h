@@ -26,7 +26,7 @@
  * Generic asynchronous events abstraction.  Designed to support multiple event libraries.
  * Only one library is supported per build.
  */
-#if defined(AS_USE_LIBEV) || defined(AS_USE_LIBUV) || defined(AS_USE_LIBEVENT)
+#if defined(AS_USE_LIBEV) || defined(AS_USE_LIBUV) || defined(AS_USE_LIBEVENT) || defined(AS_USE_LIBURING)
 #define AS_EVENT_LIB_DEFINED 1
 #endif
 
@@ -37,6 +37,9 @@
 #elif defined(AS_USE_LIBEVENT)
 #include <event2/event_struct.h>
 #include <aerospike/as_vector.h>
+#elif defined(AS_USE_LIBURING)
+struct io_uring;
+struct as_uring_loop;
 #else
 #endif
 
@@ -116,6 +119,9 @@ typedef struct as_event_loop {
 	struct event wakeup;
 	struct event trim;
 	as_vector clusters;
+#elif defined(AS_USE_LIBURING)
+	struct io_uring* loop;
+	struct as_uring_loop* uring;
 #else
 	void* loop;
 #endif
@@ -133,6 +139,9 @@ typedef struct as_event_loop {
 	// Count of consecutive errors occurring before event loop registration.
 	// Used to prevent deep recursion.
 	uint32_t errors;
+	// Size classed pool for command read buffers that exceed the command's inline capacity.
+	// Only accessed from the event loop thread.
+	struct as_buffer_pool_s* buffer_pool;
 	bool using_delay_queue;
 	bool pipe_cb_calling;
 } as_event_loop;
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <aerospike/as_admin.h>
+#include <aerospike/as_buffer_pool.h>
 #include <aerospike/as_cluster.h>
 #include <aerospike/as_listener.h>
 #include <aerospike/as_queue.h>
@@ -32,6 +33,8 @@
 struct as_uv_tls;
 #elif defined(AS_USE_LIBEVENT)
 #include <event2/event.h>
+#elif defined(AS_USE_LIBURING)
+#include <liburing.h>
 #else
 #endif
 
@@ -77,7 +80,59 @@ extern "C" {
 struct as_event_command;
 struct as_event_executor;
 
-typedef struct {
+#if defined(AS_USE_LIBURING)
+
+// Receive buffer ring size per event loop. Count must be a power of 2.
+#define AS_URING_RECV_COUNT 256
+#define AS_URING_RECV_SIZE (16 * 1024)
+#define AS_URING_RECV_GROUP 0
+
+// Send buffers per event loop. Larger sends use a heap buffer.
+#define AS_URING_SEND_COUNT 256
+#define AS_URING_SEND_SIZE (4 * 1024)
+
+#define AS_URING_BUF_NONE 0xFFFF
+
+// Connection flags.
+#define AS_URING_CONN_RECV 1
+#define AS_URING_CONN_SEND 2
+#define AS_URING_CONN_POLL_IN 4
+#define AS_URING_CONN_POLL_OUT 8
+#define AS_URING_CONN_OPS 15
+#define AS_URING_CONN_CONNECTING 16
+#define AS_URING_CONN_EOF 32
+#define AS_URING_CONN_CLOSED 64
+
+typedef struct as_uring_timer {
+	void* data;
+	uint64_t deadline;
+	uint64_t repeat;
+	uint32_t index;
+} as_uring_timer;
+
+typedef struct as_uring_loop {
+	struct io_uring ring;
+	struct io_uring_buf_ring* recv_ring;
+	uint8_t* recv_bufs;
+	uint8_t* send_bufs;
+	struct as_event_connection_s* current;
+	as_uring_timer** timers;
+	uint32_t timers_size;
+	uint32_t timers_capacity;
+	uint32_t send_free_size;
+	uint32_t closing;
+	uint64_t wakeup_value;
+	int wakeup_fd;
+	bool closed;
+	// Staged receive buffer chains. Indexed by buffer id.
+	uint16_t recv_next[AS_URING_RECV_COUNT];
+	uint16_t recv_len[AS_URING_RECV_COUNT];
+	uint16_t send_free[AS_URING_SEND_COUNT];
+} as_uring_loop;
+
+#endif
+
+typedef struct as_event_connection_s {
 #if defined(AS_USE_LIBEV)
 	struct ev_io watcher;
 	as_socket socket;
@@ -93,6 +148,19 @@ typedef struct {
 #elif defined(AS_USE_LIBEVENT)
 	struct event watcher;
 	as_socket socket;
+#elif defined(AS_USE_LIBURING)
+	as_socket socket;
+	as_event_loop* event_loop;
+	// Send buffer owned by connection while a send is in flight.
+	uint8_t* send_buf;
+	// Received bytes not yet consumed by a command.
+	uint32_t staged;
+	uint32_t stage_offset;
+	uint16_t stage_head;
+	uint16_t stage_tail;
+	uint16_t send_slot;
+	uint16_t flags;
+	int error;
 #else
 #endif
 	int watching;
@@ -120,6 +188,8 @@ typedef struct as_event_command {
 	uv_timer_t timer;
 #elif defined(AS_USE_LIBEVENT)
 	struct event timer;
+#elif defined(AS_USE_LIBURING)
+	as_uring_timer timer;
 #else
 #endif
 	uint64_t total_deadline;
@@ -167,6 +237,14 @@ typedef struct as_event_command {
 	uint32_t bytes_in;
 	uint32_t bytes_out;
 	as_latency_type latency_type;
+	bool inflight; // Counted in node inflight. Used by AS_POLICY_REPLICA_FASTEST and hedging.
+
+	// Hedged reads. Used by AS_ASYNC_TYPE_RECORD only.
+	struct as_event_command* hedge; // Sibling command while both original and hedge are active.
+	uint32_t hedge_delay; // as_policy_read.hedge_delay.
+	bool hedge_armed; // Command timer is the hedge timer.
+	bool hedged; // Hedge has fired. Do not hedge again.
+	bool hedge_clone; // Command is the hedge copy of the original command.
 } as_event_command;
 
 typedef struct {
@@ -188,6 +266,7 @@ typedef struct as_event_executor {
 	uint32_t count;
 	uint32_t queued;
 	bool notify;
+	bool notify_cancel;
 	bool valid;
 } as_event_executor;
 
@@ -201,6 +280,14 @@ as_event_command_execute(as_event_command* cmd, as_error* err);
 void
 as_event_command_schedule(as_event_command* cmd);
 
+as_status
+as_event_command_execute_many(
+	as_event_loop* event_loop, as_event_command** cmds, uint32_t n_cmds, as_error* err
+	);
+
+void
+as_event_process_queue(as_event_loop* event_loop);
+
 void
 as_event_set_timeout(as_event_command* cmd);
 
@@ -314,6 +401,13 @@ as_event_register_external_loop(as_event_loop* event_loop);
 bool
 as_event_execute(as_event_loop* event_loop, as_event_executable executable, void* udata);
 
+/**
+ * Schedule execution of multiple functions on specified event loop with one queue lock
+ * acquisition and one wakeup. Return number of functions queued.
+ */
+uint32_t
+as_event_execute_many(as_event_loop* event_loop, as_event_commander* cmds, uint32_t n_cmds);
+
 void
 as_event_command_write_start(as_event_command* cmd);
 
@@ -616,6 +710,109 @@ as_event_command_release(as_event_command* cmd)
 	as_event_command_free(cmd);
 }
 
+//----------------------------------
+// Liburing Inline Functions
+//----------------------------------
+
+#elif defined(AS_USE_LIBURING)
+
+#define AS_URING_TIMER_NONE 0xFFFFFFFF
+
+void as_uring_timer_start(as_event_loop* event_loop, as_uring_timer* timer, uint64_t timeout, uint64_t repeat);
+void as_uring_timer_stop(as_event_loop* event_loop, as_uring_timer* timer);
+void as_event_close_connection(as_event_connection* conn);
+
+static inline bool
+as_event_conn_current_trim(as_event_connection* conn, uint64_t max_socket_idle_ns)
+{
+	return as_socket_current_trim(conn->socket.last_used, max_socket_idle_ns);
+}
+
+static inline bool
+as_event_conn_current_tran(as_event_connection* conn, uint64_t max_socket_idle_ns)
+{
+	return as_socket_current_tran(conn->socket.last_used, max_socket_idle_ns);
+}
+
+static inline int
+as_event_conn_validate(as_event_connection* conn)
+{
+	// Received data is moved out of the socket by multishot receive, so check staged bytes
+	// before peeking the socket.
+	if (conn->staged > 0) {
+		return (int)conn->staged;
+	}
+
+	if (conn->flags & (AS_URING_CONN_EOF | AS_URING_CONN_SEND)) {
+		return -1;
+	}
+	return as_socket_validate_fd(conn->socket.fd);
+}
+
+static inline void
+as_event_set_conn_last_used(as_event_connection* conn)
+{
+	conn->socket.last_used = cf_getns();
+}
+
+static inline void
+as_event_timer_once(as_event_command* cmd, uint64_t timeout)
+{
+	if (!(cmd->flags & AS_ASYNC_FLAGS_HAS_TIMER)) {
+		cmd->timer.index = AS_URING_TIMER_NONE;
+		cmd->timer.data = cmd;
+	}
+	as_uring_timer_start(cmd->event_loop, &cmd->timer, timeout, 0);
+	cmd->flags |= AS_ASYNC_FLAGS_HAS_TIMER;
+}
+
+static inline void
+as_event_timer_repeat(as_event_command* cmd, uint64_t repeat)
+{
+	if (!(cmd->flags & AS_ASYNC_FLAGS_HAS_TIMER)) {
+		cmd->timer.index = AS_URING_TIMER_NONE;
+		cmd->timer.data = cmd;
+	}
+	as_uring_timer_start(cmd->event_loop, &cmd->timer, repeat, repeat);
+	cmd->flags |= AS_ASYNC_FLAGS_HAS_TIMER | AS_ASYNC_FLAGS_USING_SOCKET_TIMER;
+}
+
+static inline void
+as_event_timer_again(as_event_command* cmd)
+{
+	// liburing socket timers automatically repeat.
+}
+
+static inline void
+as_event_timer_stop(as_event_command* cmd)
+{
+	if (cmd->flags & AS_ASYNC_FLAGS_HAS_TIMER) {
+		as_uring_timer_stop(cmd->event_loop, &cmd->timer);
+	}
+}
+
+static inline void
+as_event_stop_watcher(as_event_command* cmd, as_event_connection* conn)
+{
+	// Operations in flight stay armed. Their completions are ignored until the connection
+	// is watched again.
+	conn->watching = 0;
+}
+
+static inline void
+as_event_stop_read(as_event_connection* conn)
+{
+	// This method only needed for libuv pipelined connections.
+}
+
+static inline void
+as_event_command_release(as_event_command* cmd)
+{
+	// Timer heap references the command, so remove timer before free.
+	as_event_timer_stop(cmd);
+	as_event_command_free(cmd);
+}
+
 //---------------------------------------
 // EVENT_LIB Not Defined Inline Functions
 //---------------------------------------
@@ -862,6 +1059,40 @@ as_event_loop_destroy(as_event_loop* event_loop)
 	as_queue_destroy(&event_loop->delay_queue);
 	as_queue_destroy(&event_loop->pipe_cb_queue);
 	pthread_mutex_destroy(&event_loop->lock);
+
+	if (event_loop->buffer_pool) {
+		as_buffer_pool_destroy(event_loop->buffer_pool);
+		cf_free(event_loop->buffer_pool);
+		event_loop->buffer_pool = NULL;
+	}
+}
+
+static inline void
+as_event_free_read_buffer(as_event_command* cmd)
+{
+	// Heap read buffers are owned by the event loop's buffer pool.
+	if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
+		as_buffer_pool* pool = cmd->event_loop->buffer_pool;
+
+		if (pool) {
+			as_buffer_pool_put(pool, cmd->buf, cmd->read_capacity);
+		}
+		else {
+			// Event loop already closed.
+			cf_free(cmd->buf);
+		}
+	}
+}
+
+static inline void
+as_event_set_read_buffer(as_event_command* cmd, size_t size)
+{
+	as_event_free_read_buffer(cmd);
+
+	size_t capacity;
+	cmd->buf = as_buffer_pool_get(cmd->event_loop->buffer_pool, size, &capacity);
+	cmd->read_capacity = (uint32_t)capacity;
+	cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
 }
 
 #ifdef __cplusplus
@@ -654,6 +654,37 @@ as_key_digest(as_key* key);
 AS_EXTERN as_status
 as_key_set_digest(as_error* err, as_key* key);
 
+/**
+ * Set the digest values of an array of keys. Keys that already have a digest are skipped.
+ * Digests are computed several keys at a time with a multi-buffer RIPEMD-160 kernel when
+ * the platform supports SIMD. Keys must be integer, string or blob. Otherwise, an error is
+ * returned.
+ *
+ * @code
+ * as_key keys[100];
+ * // ... initialize keys ...
+ * as_keys_set_digests(&err, keys, 100);
+ * @endcode
+ *
+ * @param err Error message that is populated on error.
+ * @param keys The keys to set digests for.
+ * @param n_keys The number of keys.
+ *
+ * @return Status code.
+ *
+ * @relates as_key
+ */
+AS_EXTERN as_status
+as_keys_set_digests(as_error* err, as_key* keys, uint32_t n_keys);
+
+/**
+ * @private
+ * Set the digest values of keys that are embedded in an array of larger structures.
+ * The first key is at keys and each following key is stride bytes after the previous key.
+ */
+AS_EXTERN as_status
+as_keys_set_digests_stride(as_error* err, void* keys, size_t stride, uint32_t n_keys);
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif
@@ -37,14 +37,46 @@ typedef uint8_t as_latency_type;
 #define AS_LATENCY_TYPE_NONE 5
 #define AS_LATENCY_TYPE_MAX 5
 
+/**
+ * Number of cache line padded stripes used by metrics counters. Threads increment the stripe
+ * assigned to them, so concurrent commands rarely write to the same cache line. Stripes are
+ * summed when metrics are read. Must be a power of 2.
+ */
+#define AS_METRICS_STRIPES 16
+
+/**
+ * Number of 64 bit counters in a cache line.
+ */
+#define AS_METRICS_LINE_COUNTERS 8
+
 /**
  * Latency histogram for a command group.
- * Latency histogram counts are cumulative and not reset on each metrics snapshot interval
+ * Latency histogram counts are cumulative and not reset on each metrics snapshot interval.
+ * Per-interval counts are available through as_latency_get_bucket_delta().
+ *
+ * When micros is false, bucket units are milliseconds and each bucket range is a power of 2
+ * multiple (shift) of the previous bucket range.
+ *
+ * When micros is true, bucket units are microseconds and buckets are log-linear (HDR style).
+ * Each power of 2 range is split into (1 << shift) linear sub-buckets.
+ *
+ * Counts are striped into AS_METRICS_STRIPES cache line aligned rows of stride counters.
  */
 typedef struct as_latency_s {
 	uint32_t ref_count;
 	uint8_t shift;
 	uint8_t size;
+	bool micros;
+	uint8_t pad;
+
+	// Next retired histogram. Replaced histograms are kept until the node is destroyed,
+	// so commands can increment histograms without reserving them.
+	struct as_latency_s* next;
+
+	// Cache line aligned stripe rows.
+	uint64_t* rows;
+	uint32_t stride;
+
 	uint64_t buckets[];
 } as_latency;
 
@@ -52,6 +84,27 @@ typedef struct as_latency_s {
 // Functions
 //---------------------------------
 
+/**
+ * @private
+ * Create latency histogram with ref_count of 1.
+ */
+as_latency*
+as_latency_create(uint8_t size, uint8_t shift, bool micros);
+
+/**
+ * @private
+ * Increment bucket that contains elapsed nanoseconds in the given stripe.
+ */
+void
+as_latency_add(as_latency* latency, uint32_t stripe, uint64_t elapsed_nanos);
+
+/**
+ * @private
+ * Reset all bucket counts.
+ */
+void
+as_latency_clear(as_latency* latency);
+
 /**
  * Reserver latency histogram.
  */
@@ -76,12 +129,32 @@ as_latency_release(as_latency* latency)
 }
 
 /**
- * Retrieve specified bucket using atomics.
+ * Retrieve specified bucket using atomics. Bucket counts are summed across all stripes.
  */
 static inline uint64_t
 as_latency_get_bucket(as_latency* latency, uint32_t index)
 {
-	return as_load_uint64(&latency->buckets[index]);
+	uint64_t count = 0;
+
+	for (uint32_t i = 0; i < AS_METRICS_STRIPES; i++) {
+		count += as_load_uint64(&latency->rows[i * latency->stride + index]);
+	}
+	return count;
+}
+
+/**
+ * Get latency bucket count since the previous snapshot. prev is owned by the caller and holds
+ * the bucket count at the caller's previous snapshot (initially zero). prev is set to the
+ * current count. The histogram is not modified, so multiple consumers can take deltas of the
+ * same histogram as long as each keeps its own prev counts.
+ */
+static inline uint64_t
+as_latency_get_bucket_delta(as_latency* latency, uint32_t index, uint64_t* prev)
+{
+	uint64_t count = as_latency_get_bucket(latency, index);
+	uint64_t delta = count - *prev;
+	*prev = count;
+	return delta;
 }
 
 /**
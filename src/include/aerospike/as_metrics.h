@@ -148,10 +148,43 @@ typedef struct as_metrics_policy_s {
 	 * <=1ms >1ms >8ms >64ms >512ms
 	 * @endcode
 	 *
+	 * If latency_micros is true, latency_shift is instead the number of bits used to split each
+	 * power of 2 range into linear sub-buckets.
+	 *
 	 * Default: 1
 	 */
 	uint8_t latency_shift;
 
+	/**
+	 * Use microsecond log-linear (HDR style) latency histograms instead of millisecond power of
+	 * 2 histograms. The first (1 << latency_shift) buckets are 1us wide. Each following power of 2
+	 * range is split into (1 << latency_shift) equal width buckets. Example:
+	 *
+	 * @code
+	 * // latencyColumns=12 latencyShift=2
+	 * 0us 1us 2us 3us 4us 5us 6us 7us 8-9us 10-11us 12-13us >=14us
+	 * @endcode
+	 *
+	 * Sub-millisecond percentiles require enough columns to cover the expected latency range.
+	 * For example, latency_columns=56 and latency_shift=2 covers up to 32ms with 25% precision.
+	 *
+	 * Can also be set by the dynamic configuration file as metrics.latency_micros.
+	 *
+	 * Default: false
+	 */
+	bool latency_micros;
+
+	/**
+	 * Report latency bucket counts for the current metrics interval only instead of cumulative
+	 * counts since metrics were enabled. Only applies to the default metrics writer. Custom
+	 * listeners keep their own previous counts and call as_latency_get_bucket_delta().
+	 *
+	 * Can also be set by the dynamic configuration file as metrics.latency_delta.
+	 *
+	 * Default: false
+	 */
+	bool latency_delta;
+
 	/**
 	 * @private
 	 * Should metrics be started as part of dynamic configuration. If aerospike_enable_metrics()
@@ -35,6 +35,25 @@ extern "C" {
 // Types
 //---------------------------------
 
+/**
+ * @private
+ * Latency bucket counts of one histogram at the previous snapshot.
+ */
+typedef struct as_metrics_latency_prev_s {
+	as_latency* latency;
+	uint64_t* counts;
+} as_metrics_latency_prev;
+
+/**
+ * @private
+ * Previous latency bucket counts of one node, indexed by namespace metrics index and latency type.
+ */
+typedef struct as_metrics_node_prev_s {
+	struct as_node_s* node;
+	as_metrics_latency_prev* latencies;
+	uint32_t ns_size;
+} as_metrics_node_prev;
+
 /**
  * Default metrics listener. This implementation writes periodic metrics snapshots to a file which
  * will later be read and forwarded to OpenTelemetry by a separate offline application.
@@ -47,6 +66,9 @@ typedef struct as_metrics_writer_s {
 	uint64_t size;
 	uint8_t latency_columns;
 	uint8_t latency_shift;
+	bool latency_micros;
+	bool latency_delta;
+	as_vector* latency_prev;
 #ifdef _MSC_VER
 	FILETIME prev_process_times_kernel;
 	FILETIME prev_system_times_kernel;
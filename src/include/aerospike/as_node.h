@@ -202,7 +202,25 @@ typedef struct as_async_conn_pool_s {
 } as_async_conn_pool;
 
 /**
- * Namespace metrics.
+ * @private
+ * Namespace metrics counters for one stripe. Padded to a cache line.
+ */
+typedef struct as_ns_metrics_stripe_s {
+	uint64_t bytes_in;
+	uint64_t bytes_out;
+	uint64_t error_count;
+	uint64_t timeout_count;
+	uint64_t key_busy_count;
+	uint64_t pad[AS_METRICS_LINE_COUNTERS - 5];
+} as_ns_metrics_stripe;
+
+/**
+ * Namespace metrics. Counters are striped to avoid cache line contention between threads.
+ *
+ * The bytes_in, bytes_out, error_count, timeout_count and key_busy_count fields were moved
+ * into stripes. Code that read those fields directly must call as_node_get_bytes_in(),
+ * as_node_get_bytes_out(), as_node_get_error_count(), as_node_get_timeout_count() and
+ * as_node_get_key_busy_count() instead, which return the summed values.
  */
 typedef struct {
 	/**
@@ -211,36 +229,31 @@ typedef struct {
 	const char* ns;
 
 	/**
-	 * Bytes received from the server.
-	 */
-	uint64_t bytes_in;
-
-	/**
-	 * Bytes sent to the server.
+	 * Cache line aligned counter stripes. Each stripe contains bytes received from the server,
+	 * bytes sent to the server, command error count, command timeout count and command key busy
+	 * error count since node was initialized. If the error or timeout is retryable, multiple
+	 * errors or timeouts per command may occur.
 	 */
-	uint64_t bytes_out;
+	as_ns_metrics_stripe* stripes;
 
 	/**
-	 * Command error count since node was initialized. If the error is retryable, multiple errors per
-	 * command may occur.
-	 */
-	uint64_t error_count;
-
-	/**
-	 * Command timeout count since node was initialized. If the timeout is retryable (ie socketTimeout),
-	 * multiple timeouts per command may occur.
+	 * Latency histograms.
 	 */
-	uint64_t timeout_count;
+	as_latency* latency[AS_LATENCY_TYPE_MAX];
 
 	/**
-	 * Command key busy error count since node was initialized.
+	 * @private
+	 * Latency histograms that were replaced when metrics were re-enabled with a different
+	 * histogram layout. Commands may still hold them, so they are only freed when the node
+	 * is destroyed. A retired histogram is reused when its layout is enabled again.
 	 */
-	uint64_t key_busy_count;
+	as_latency* retired;
 
 	/**
-	 * Latency histograms.
+	 * @private
+	 * Stripes allocation. Stripes are aligned inside this allocation.
 	 */
-	as_latency* latency[AS_LATENCY_TYPE_MAX];
+	void* stripes_mem;
 
 } as_ns_metrics;
 
@@ -341,6 +354,12 @@ typedef struct as_node_s {
 	 */
 	as_racks* racks;
 
+	/**
+	 * Partition bitmaps received in the last replicas response, one entry per namespace.
+	 * Used to only update partitions that changed. Only accessed by the tend thread.
+	 */
+	as_partition_bitmaps* partition_bitmaps;
+
 	/**
 	 * Socket used exclusively for cluster tend thread info requests.
 	 */
@@ -406,6 +425,23 @@ typedef struct as_node_s {
 	 */
 	uint32_t failures;
 
+	/**
+	 * Moving average of single record read latency in microseconds.
+	 * Used by AS_POLICY_REPLICA_FASTEST. Zero indicates no samples.
+	 */
+	uint32_t latency_ewma;
+
+	/**
+	 * Number of AS_POLICY_REPLICA_FASTEST read commands currently in flight on this node.
+	 */
+	uint32_t inflight;
+
+	/**
+	 * Streaming estimate of 95th percentile single record read latency in microseconds.
+	 * Used by as_policy_read.hedge_delay AS_POLICY_HEDGE_DELAY_P95. Zero indicates no samples.
+	 */
+	uint32_t latency_p95;
+
 	/**
 	 * Shared memory node array index.
 	 */
@@ -421,6 +457,11 @@ typedef struct as_node_s {
 	 */
 	uint8_t metrics_size;
 
+	/**
+	 * Number of partition_bitmaps entries.
+	 */
+	uint8_t partition_bitmaps_size;
+
 	/**
 	 * Should user login to avoid session expiration.
 	 */
@@ -441,6 +482,18 @@ typedef struct as_node_s {
 	 */
 	bool rebalance_changed;
 
+	/**
+	 * Was a quick node restart detected in current cluster tend. Connection pools are
+	 * rebalanced by the tend thread after all node refresh requests complete.
+	 */
+	bool restarted;
+
+	/**
+	 * Are partition_bitmaps out of date because another node took over a partition
+	 * from this node. If true, the next replicas response is applied in full.
+	 */
+	bool partition_bitmaps_stale;
+
 	/**
 	 * Should user-agent-set info command be retried.
 	 */
@@ -800,6 +853,48 @@ as_node_prepare_metrics(as_node* node, const char* ns);
 void
 as_node_add_latency(as_ns_metrics* metrics, as_latency_type latency_type, uint64_t elapsed_nanos);
 
+/**
+ * @private
+ * Add read latency sample to node's moving average used by AS_POLICY_REPLICA_FASTEST.
+ */
+void
+as_node_add_replica_latency(as_node* node, uint64_t elapsed_nanos);
+
+/**
+ * @private
+ * Decay node's moving average latency so slow nodes are eventually tried again.
+ */
+void
+as_node_decay_replica_latency(as_node* node);
+
+/**
+ * @private
+ * Return expected latency of a new read command on this node. Lower is better.
+ */
+static inline uint64_t
+as_node_replica_score(as_node* node)
+{
+	// Add one to latency so in-flight commands still count when no samples exist.
+	uint64_t latency = (uint64_t)as_load_uint32(&node->latency_ewma) + 1;
+	return latency * (as_load_uint32(&node->inflight) + 1);
+}
+
+/**
+ * @private
+ * Return hedged read delay in milliseconds for this node. Zero indicates do not hedge.
+ */
+static inline uint32_t
+as_node_hedge_delay(as_node* node, uint32_t hedge_delay)
+{
+	if (hedge_delay != AS_POLICY_HEDGE_DELAY_P95) {
+		return hedge_delay;
+	}
+
+	// Round up to milliseconds. Zero p95 indicates no samples, so do not hedge.
+	uint32_t p95 = as_load_uint32(&node->latency_p95);
+	return (p95 > 0)? (p95 + 999) / 1000 : 0;
+}
+
 struct as_metrics_policy_s;
 
 /**
@@ -809,13 +904,50 @@ struct as_metrics_policy_s;
 void
 as_node_enable_metrics(as_node* node, const struct as_metrics_policy_s* policy);
 
+#if !defined(_MSC_VER)
+/**
+ * @private
+ * Current thread id used to select a home sync connection pool and metrics stripe.
+ * Zero means the thread has not been assigned an id yet.
+ */
+extern __thread uint32_t as_node_thread_id;
+#endif
+
+/**
+ * @private
+ * Assign an id to the current thread if it does not have one and return it.
+ */
+AS_EXTERN uint32_t
+as_node_thread_assign(void);
+
+/**
+ * @private
+ * Return metrics stripe assigned to the current thread. Stripes are selected by thread id,
+ * so threads beyond AS_METRICS_STRIPES share stripes.
+ */
+static inline uint32_t
+as_node_metrics_stripe(void)
+{
+#if defined(_MSC_VER)
+	// Thread local variables can not be imported from a DLL.
+	uint32_t id = as_node_thread_assign();
+#else
+	uint32_t id = as_node_thread_id;
+
+	if (id == 0) {
+		id = as_node_thread_assign();
+	}
+#endif
+	return (id - 1) & (AS_METRICS_STRIPES - 1);
+}
+
 /**
  * Add bytes received metrics to node/namespace.
  */
 static inline void
 as_node_add_bytes_in(as_ns_metrics* metrics, uint64_t bytes_in)
 {
-	as_add_uint64(&metrics->bytes_in, bytes_in);
+	as_add_uint64(&metrics->stripes[as_node_metrics_stripe()].bytes_in, bytes_in);
 }
 
 /**
@@ -824,7 +956,12 @@ as_node_add_bytes_in(as_ns_metrics* metrics, uint64_t bytes_in)
 static inline uint64_t
 as_node_get_bytes_in(as_ns_metrics* metrics)
 {
-	return as_load_uint64(&metrics->bytes_in);
+	uint64_t total = 0;
+
+	for (uint32_t i = 0; i < AS_METRICS_STRIPES; i++) {
+		total += as_load_uint64(&metrics->stripes[i].bytes_in);
+	}
+	return total;
 }
 
 /**
@@ -833,7 +970,7 @@ as_node_get_bytes_in(as_ns_metrics* metrics)
 static inline void
 as_node_add_bytes_out(as_ns_metrics* metrics, uint64_t bytes_out)
 {
-	as_add_uint64(&metrics->bytes_out, bytes_out);
+	as_add_uint64(&metrics->stripes[as_node_metrics_stripe()].bytes_out, bytes_out);
 }
 
 /**
@@ -842,7 +979,12 @@ as_node_add_bytes_out(as_ns_metrics* metrics, uint64_t bytes_out)
 static inline uint64_t
 as_node_get_bytes_out(as_ns_metrics* metrics)
 {
-	return as_load_uint64(&metrics->bytes_out);
+	uint64_t total = 0;
+
+	for (uint32_t i = 0; i < AS_METRICS_STRIPES; i++) {
+		total += as_load_uint64(&metrics->stripes[i].bytes_out);
+	}
+	return total;
 }
 
 /**
@@ -851,7 +993,12 @@ as_node_get_bytes_out(as_ns_metrics* metrics)
 static inline uint64_t
 as_node_get_error_count(as_ns_metrics* metrics)
 {
-	return as_load_uint64(&metrics->error_count);
+	uint64_t total = 0;
+
+	for (uint32_t i = 0; i < AS_METRICS_STRIPES; i++) {
+		total += as_load_uint64(&metrics->stripes[i].error_count);
+	}
+	return total;
 }
 
 /**
@@ -867,7 +1014,12 @@ as_node_add_error(as_node* node, const char* ns, as_ns_metrics* metrics);
 static inline uint64_t
 as_node_get_timeout_count(as_ns_metrics* metrics)
 {
-	return as_load_uint64(&metrics->timeout_count);
+	uint64_t total = 0;
+
+	for (uint32_t i = 0; i < AS_METRICS_STRIPES; i++) {
+		total += as_load_uint64(&metrics->stripes[i].timeout_count);
+	}
+	return total;
 }
 
 /**
@@ -883,7 +1035,12 @@ as_node_add_timeout(as_node* node, const char* ns, as_ns_metrics* metrics);
 static inline uint64_t
 as_node_get_key_busy_count(as_ns_metrics* metrics)
 {
-	return as_load_uint64(&metrics->key_busy_count);
+	uint64_t total = 0;
+
+	for (uint32_t i = 0; i < AS_METRICS_STRIPES; i++) {
+		total += as_load_uint64(&metrics->stripes[i].key_busy_count);
+	}
+	return total;
 }
 
 /**
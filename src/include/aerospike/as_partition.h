@@ -49,6 +49,11 @@ extern "C" {
  */
 #define AS_MAX_REPLICATION_FACTOR 3
 
+/**
+ * Namespace hash index slot count. Must be a power of 2 and greater than AS_MAX_NAMESPACES.
+ */
+#define AS_PARTITION_NS_INDEX_SIZE 64
+
 //---------------------------------
 // Types
 //---------------------------------
@@ -80,6 +85,17 @@ typedef struct as_partition_table_s {
 	as_partition partitions[];
 } as_partition_table;
 
+/**
+ * @private
+ * Partition bitmaps of one namespace from a node's last replicas response.
+ * Only accessed by the cluster tend thread.
+ */
+typedef struct as_partition_bitmaps_s {
+	char ns[AS_MAX_NAMESPACE_SIZE];
+	uint32_t regime[AS_MAX_REPLICATION_FACTOR];
+	uint8_t* bitmaps[AS_MAX_REPLICATION_FACTOR];
+} as_partition_bitmaps;
+
 /**
  * @private
  * Array of partition table pointers.
@@ -87,6 +103,15 @@ typedef struct as_partition_table_s {
 typedef struct as_partition_tables_s {
 	as_partition_table* tables[AS_MAX_NAMESPACES];
 	uint32_t size;
+
+	// Namespace hash of each table.
+	uint32_t hashes[AS_MAX_NAMESPACES];
+
+	// Open addressing index of namespace hash to table offset + 1 (zero indicates empty slot).
+	// Slots are only written by the tend thread and published with release semantics after
+	// the table is fully initialized. Tables are never removed until the cluster is destroyed,
+	// so an as_partition_table pointer can be cached for the lifetime of the cluster.
+	uint8_t index[AS_PARTITION_NS_INDEX_SIZE];
 } as_partition_tables;
 
 /**
@@ -114,7 +139,9 @@ as_partition_tables_destroy(as_partition_tables* tables);
 
 /**
  * @private
- * Get partition table given namespace.
+ * Get partition table given namespace. The namespace hash index is used to avoid scanning
+ * all tables. The returned table is valid until the cluster is destroyed, so callers may
+ * cache it.
  */
 AS_EXTERN as_partition_table*
 as_partition_tables_get(as_partition_tables* tables, const char* ns);
@@ -126,6 +153,23 @@ as_partition_tables_get(as_partition_tables* tables, const char* ns);
 AS_EXTERN const char*
 as_partition_tables_get_ns(struct as_cluster_s* cluster, const char* ns);
 
+/**
+ * @private
+ * Return namespace hash (32 bit FNV-1a) used to index partition tables.
+ */
+static inline uint32_t
+as_partition_ns_hash(const char* ns)
+{
+	uint32_t hash = 2166136261u;
+	const uint8_t* p = (const uint8_t*)ns;
+
+	while (*p) {
+		hash ^= *p++;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
 /**
  * @private
  * Return partition ID given digest.
@@ -147,6 +191,27 @@ as_partition_info_init(
 	const struct as_key_s* key
 	);
 
+/**
+ * @private
+ * Decode a node's base64 encoded partition bitmap and write the ids of partitions that must be
+ * applied to the partition map into ids. When the node's previous bitmap for the same namespace,
+ * replica index and regime is still valid (full is false), only partitions that the node did not
+ * claim in the previous bitmap are returned. Otherwise, all claimed partitions are returned.
+ * Return number of partition ids written.
+ */
+uint32_t
+as_partition_bitmap_decode(
+	struct as_node_s* node, const char* ns, char* bitmap_b64, uint32_t len, uint32_t n_partitions,
+	uint8_t replica_index, uint32_t regime, bool full, uint32_t* ids
+	);
+
+/**
+ * @private
+ * Release partition bitmaps cached for a node.
+ */
+void
+as_partition_bitmaps_destroy(struct as_node_s* node);
+
 /**
  * @private
  * Log all partition maps in the cluster.
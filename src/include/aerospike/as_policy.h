@@ -141,6 +141,14 @@ extern "C" {
  */
 #define AS_POLICY_COMMIT_LEVEL_DEFAULT AS_POLICY_COMMIT_LEVEL_ALL
 
+/**
+ * as_policy_read.hedge_delay value that hedges reads at the target node's observed
+ * 95th percentile read latency.
+ *
+ * @ingroup client_policies
+ */
+#define AS_POLICY_HEDGE_DELAY_P95 0xFFFFFFFF
+
 //---------------------------------
 // Types
 //---------------------------------
@@ -319,7 +327,18 @@ typedef enum as_policy_replica_e {
 	 *
 	 * This option can also be used to test server proxies.
 	 */
-	AS_POLICY_REPLICA_RANDOM
+	AS_POLICY_REPLICA_RANDOM,
+
+	/**
+	 * For reads, pick two nodes containing key's master or replicated partitions and use
+	 * the node with the lowest expected latency. Expected latency is the node's moving
+	 * average of recent single record read latency multiplied by the number of reads
+	 * already in flight on that node. Use SEQUENCE for writes.
+	 *
+	 * This option is useful when a node is temporarily slow (garbage collection, defrag,
+	 * network congestion) and replicas are able to serve the same data.
+	 */
+	AS_POLICY_REPLICA_FASTEST
 
 } as_policy_replica;
 
@@ -702,6 +721,34 @@ typedef struct as_policy_read_s {
 	 */
 	bool async_heap_rec;
 
+	/**
+	 * Allocate the bin array and all string, geojson and bytes bin values of a returned record
+	 * in a single heap block (arena) instead of one allocation per value.  as_record_destroy()
+	 * releases the whole block in one step.  This field only applies to sync commands where the
+	 * client allocates the record (the record pointer passed in points to NULL).
+	 *
+	 * Bin values must not be detached from a record allocated this way, because the value
+	 * memory belongs to the record.  For example, do not clear as_string.free and keep
+	 * as_string.value after the record is destroyed.
+	 *
+	 * Default: false
+	 */
+	bool bin_arena;
+
+	/**
+	 * Delay in milliseconds before a read that has not received a response is also sent
+	 * to the next replica (hedged read). The first response is used and the other command
+	 * is cancelled. If AS_POLICY_HEDGE_DELAY_P95, the delay is the target node's observed
+	 * 95th percentile read latency and reads are not hedged until latency has been observed.
+	 *
+	 * Hedging applies to get, select and exists on the first attempt. Reads are not hedged
+	 * when the partition has one replica, replica is AS_POLICY_REPLICA_MASTER, the command
+	 * is pipelined or the delay is not less than socket_timeout and total_timeout.
+	 *
+	 * Default: 0 (do not hedge)
+	 */
+	uint32_t hedge_delay;
+
 } as_policy_read;
 	
 /**
@@ -973,6 +1020,20 @@ typedef struct as_policy_operate_s {
 	 */
 	bool async_heap_rec;
 
+	/**
+	 * Allocate the bin array and all string, geojson and bytes bin values of a returned record
+	 * in a single heap block (arena) instead of one allocation per value.  as_record_destroy()
+	 * releases the whole block in one step.  This field only applies to sync commands where the
+	 * client allocates the record (the record pointer passed in points to NULL).
+	 *
+	 * Bin values must not be detached from a record allocated this way, because the value
+	 * memory belongs to the record.  For example, do not clear as_string.free and keep
+	 * as_string.value after the record is destroyed.
+	 *
+	 * Default: false
+	 */
+	bool bin_arena;
+
 	/**
 	 * Should the client return a result for every operation.
 	 *
@@ -1155,6 +1216,19 @@ typedef struct as_policy_batch_s {
 	 */
 	bool respond_all_keys;
 
+	/**
+	 * Maximum number of keys sent in a single command to a server node. Keys that map to
+	 * the same node are split into sub-batches of at most this size. Sub-batches are sent
+	 * as separate commands on separate connections, so a very large batch does not
+	 * serialize on one connection. Sub-batches run in parallel when concurrent is true
+	 * or the command is async. Results are still returned in the original key order.
+	 *
+	 * If zero, all keys for a node are sent in one command.
+	 *
+	 * Default: 0
+	 */
+	uint32_t max_records_per_command;
+
 	/**
 	 * This method is deprecated and will eventually be removed.
 	 * The set name is now always sent for every distinct namespace/set in the batch.
@@ -1454,6 +1528,24 @@ typedef struct as_policy_query_s {
 	 */
 	as_query_duration expected_duration;
 
+	/**
+	 * Maximum number of aggregation results buffered between the node query threads and the
+	 * Lua aggregation thread(s).  Node query threads block when the buffer is full, so client
+	 * memory stays bounded when Lua aggregation is slower than the server nodes.  Zero means
+	 * unbounded.  This field is only used for aggregation queries.
+	 *
+	 * Default: 5000
+	 */
+	uint32_t aggregate_queue_capacity;
+
+	/**
+	 * Maximum number of records buffered by aerospike_query_stream() before the node query
+	 * threads stop reading from their sockets and wait for the application to consume records.
+	 *
+	 * Default: 5000
+	 */
+	uint32_t record_queue_size;
+
 	/**
 	 * Terminate query if cluster is in migration state. If the server supports partition
 	 * queries or the query filter is null (scan), this field is ignored.
@@ -1470,6 +1562,33 @@ typedef struct as_policy_query_s {
 	 */
 	bool deserialize;
 
+	/**
+	 * Should blob bin values and undeserialized list/map bytes reference the server response
+	 * buffer directly instead of being copied to the heap.  This avoids an allocation and copy
+	 * per bin for large queries.
+	 *
+	 * Borrowed values are only valid until the record callback returns.  Use
+	 * as_record_copy() to keep a record after the callback returns.  This field is ignored for
+	 * aggregation queries.
+	 *
+	 * Default: false
+	 */
+	bool borrow_bytes;
+
+	/**
+	 * Run the client side stages of an aggregation stream UDF (the final reduce/aggregate and
+	 * any stages after it) on each node's results in parallel Lua states.  The stream UDF is then
+	 * applied once more to the per node outputs to combine them into the final result.
+	 *
+	 * Only enable when the client side stages are associative reductions, for example when the
+	 * stream UDF ends with reduce().  A map() or filter() after the reduce would be applied twice.
+	 * Parallel aggregation requires 2 * (server nodes) + 1 threads in the client thread pool.
+	 * If the thread pool is smaller, the query runs with a single aggregation thread.
+	 *
+	 * Default: false
+	 */
+	bool aggregate_parallel;
+
 	/**
 	 * This field is deprecated and will eventually be removed. Use expected_duration instead.
 	 *
@@ -1547,6 +1666,18 @@ typedef struct as_policy_scan_s {
 	 */
 	bool durable_delete;
 
+	/**
+	 * Should blob bin values and undeserialized list/map bytes reference the server response
+	 * buffer directly instead of being copied to the heap.  This avoids an allocation and copy
+	 * per bin for large scans.
+	 *
+	 * Borrowed values are only valid until the record callback returns.  Use
+	 * as_record_copy() to keep a record after the callback returns.
+	 *
+	 * Default: false
+	 */
+	bool borrow_bytes;
+
 } as_policy_scan;
 
 /**
@@ -1805,6 +1936,8 @@ as_policy_read_init(as_policy_read* p)
 	p->read_touch_ttl_percent = 0;
 	p->deserialize = true;
 	p->async_heap_rec = false;
+	p->bin_arena = false;
+	p->hedge_delay = 0;
 	return p;
 }
 
@@ -1885,6 +2018,7 @@ as_policy_operate_init(as_policy_operate* p)
 	p->durable_delete = false;
 	p->on_locking_only = false;
 	p->async_heap_rec = false;
+	p->bin_arena = false;
 	p->respond_all_ops = false;
 	return p;
 }
@@ -1993,6 +2127,7 @@ as_policy_batch_init(as_policy_batch* p)
 	p->allow_inline = true;
 	p->allow_inline_ssd = false;
 	p->respond_all_keys = true;
+	p->max_records_per_command = 0;
 	p->send_set_name = true;
 	p->deserialize = true;
 	return p;
@@ -2109,6 +2244,7 @@ as_policy_scan_init(as_policy_scan* p)
 	p->replica = AS_POLICY_REPLICA_SEQUENCE;
 	p->ttl = 0; // AS_RECORD_DEFAULT_TTL
 	p->durable_delete = false;
+	p->borrow_bytes = false;
 	return p;
 }
 
@@ -2141,8 +2277,12 @@ as_policy_query_init(as_policy_query* p)
 	p->info_timeout = 10000;
 	p->replica = AS_POLICY_REPLICA_SEQUENCE;
 	p->expected_duration = AS_QUERY_DURATION_LONG;
+	p->aggregate_queue_capacity = 5000;
+	p->record_queue_size = 5000;
 	p->fail_on_cluster_change = false;
 	p->deserialize = true;
+	p->borrow_bytes = false;
+	p->aggregate_parallel = false;
 	p->short_query = false;
 	return p;
 }
@@ -2249,6 +2389,7 @@ as_policy_txn_verify_init(as_policy_txn_verify* p)
 	p->allow_inline = true;
 	p->allow_inline_ssd = false;
 	p->respond_all_keys = true;
+	p->max_records_per_command = 0;
 	p->send_set_name = true;
 	p->deserialize = true;
 	return p;
@@ -2293,6 +2434,7 @@ as_policy_txn_roll_init(as_policy_txn_roll* p)
 	p->allow_inline = true;
 	p->allow_inline_ssd = false;
 	p->respond_all_keys = true;
+	p->max_records_per_command = 0;
 	p->send_set_name = true;
 	p->deserialize = true;
 	return p;
@@ -316,6 +316,30 @@ as_record_init(as_record* rec, uint16_t nbins);
 AS_EXTERN void
 as_record_destroy(as_record* rec);
 
+/**
+ * Create a new heap record that contains a deep copy of the key, metadata and bin values of
+ * an existing record.  String, geojson and bytes values are copied.  List and map values are
+ * shared by reference count.
+ *
+ * This is required to keep a record passed to a scan/query callback when
+ * as_policy_scan.borrow_bytes or as_policy_query.borrow_bytes is enabled, because borrowed
+ * bin values reference the command response buffer.
+ *
+ * @code
+ * as_record* copy = as_record_copy(rec);
+ * ...
+ * as_record_destroy(copy);
+ * @endcode
+ *
+ * @param rec	The record to copy.
+ *
+ * @return a pointer to the new as_record if successful, otherwise NULL.
+ *
+ * @relates as_record
+ */
+AS_EXTERN as_record*
+as_record_copy(const as_record* rec);
+
 /**
  * Get the number of bins in the record.
  *
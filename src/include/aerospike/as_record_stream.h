@@ -0,0 +1,220 @@
+/*
+ * Copyright 2008-2026 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#pragma once
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_status.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//---------------------------------
+// Types
+//---------------------------------
+
+struct aerospike_s;
+struct as_record_stream_s;
+
+/**
+ * @private
+ * Function that runs the query and feeds records to the stream.
+ */
+typedef as_status (*as_record_stream_producer)(struct as_record_stream_s* stream, as_error* err);
+
+/**
+ * Record stream returned by aerospike_query_stream().
+ *
+ * The query runs in a background thread. Records are buffered in a bounded queue
+ * that the application drains with as_record_stream_next(). When the queue is full, node
+ * threads stop reading from their sockets until the application consumes records, so
+ * a slow consumer applies flow control to the servers instead of growing client memory.
+ *
+ * @code
+ * as_record_stream* stream;
+ *
+ * if (aerospike_query_stream(&as, &err, NULL, &query, &stream) != AEROSPIKE_OK) {
+ *     return;
+ * }
+ *
+ * as_record* rec;
+ *
+ * while (as_record_stream_next(stream, &err, &rec) == AEROSPIKE_OK && rec) {
+ *     // Process record
+ *     as_record_destroy(rec);
+ * }
+ * as_record_stream_close(stream);
+ * @endcode
+ *
+ * A consumer that stalls longer than the server's socket timeout will cause the server to
+ * abort the query.
+ *
+ * @ingroup client_objects
+ */
+typedef struct as_record_stream_s {
+	/**
+	 * @private
+	 * Aerospike instance.
+	 */
+	struct aerospike_s* as;
+
+	/**
+	 * @private
+	 * Query. Must remain valid until the stream is closed.
+	 */
+	void* cmd;
+
+	/**
+	 * @private
+	 * Copy of query policy.
+	 */
+	as_policy_query policy;
+
+	/**
+	 * @private
+	 * Runs query in background thread.
+	 */
+	as_record_stream_producer producer;
+
+	/**
+	 * @private
+	 * Background thread.
+	 */
+	pthread_t thread;
+
+	/**
+	 * @private
+	 * Lock for queue and state below.
+	 */
+	pthread_mutex_t lock;
+
+	/**
+	 * @private
+	 * Signaled when a record is added or the producer finishes.
+	 */
+	pthread_cond_t not_empty;
+
+	/**
+	 * @private
+	 * Signaled when a record is removed or the stream is closed.
+	 */
+	pthread_cond_t not_full;
+
+	/**
+	 * @private
+	 * Circular queue of records.
+	 */
+	as_record** records;
+
+	/**
+	 * @private
+	 * Queue capacity.
+	 */
+	uint32_t capacity;
+
+	/**
+	 * @private
+	 * Queue head offset.
+	 */
+	uint32_t head;
+
+	/**
+	 * @private
+	 * Number of records in queue.
+	 */
+	uint32_t size;
+
+	/**
+	 * @private
+	 * Query result. Valid when done is true.
+	 */
+	as_status status;
+
+	/**
+	 * @private
+	 * Query error. Valid when done is true.
+	 */
+	as_error err;
+
+	/**
+	 * @private
+	 * Has query finished.
+	 */
+	bool done;
+
+	/**
+	 * @private
+	 * Has application closed the stream.
+	 */
+	bool closed;
+} as_record_stream;
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+/**
+ * Wait for the next record. On success, rec is set to the next record or NULL when all
+ * records have been returned. The caller owns the returned record and must call
+ * as_record_destroy() on it.
+ *
+ * Records received before a query error are returned before the error.
+ *
+ * @param stream		Record stream.
+ * @param err			The as_error to be populated if the query failed.
+ * @param rec			Next record or NULL when the stream has ended.
+ *
+ * @return AEROSPIKE_OK on success. Otherwise the query failed.
+ *
+ * @relates as_record_stream
+ */
+AS_EXTERN as_status
+as_record_stream_next(as_record_stream* stream, as_error* err, as_record** rec);
+
+/**
+ * Stop the query if still running, wait for the background thread to finish and
+ * release the stream. Unread records are destroyed.
+ *
+ * @relates as_record_stream
+ */
+AS_EXTERN void
+as_record_stream_close(as_record_stream* stream);
+
+/**
+ * @private
+ * Create stream and start producer in a background thread.
+ */
+as_status
+as_record_stream_start(
+	struct aerospike_s* as, as_error* err, void* cmd, const void* policy, size_t policy_size,
+	uint32_t capacity, as_record_stream_producer producer, as_record_stream** stream
+	);
+
+/**
+ * @private
+ * Query callback that copies the record to the stream. Blocks while the stream is full.
+ * Return false when the stream was closed by the application.
+ */
+bool
+as_record_stream_callback(const as_val* val, void* udata);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
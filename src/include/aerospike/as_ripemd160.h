@@ -0,0 +1,83 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#pragma once
+
+#include <aerospike/as_std.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(__ARM_NEON)
+#define AS_RIPEMD160_SIMD 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+/**
+ * @private
+ * Number of messages hashed in parallel by as_ripemd160_lanes().
+ */
+#define AS_RIPEMD160_LANES 4
+
+/**
+ * @private
+ * RIPEMD-160 block size in bytes.
+ */
+#define AS_RIPEMD160_BLOCK_SIZE 64
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+/**
+ * @private
+ * Append RIPEMD-160 padding to the len byte message at the start of buf. buf must hold at
+ * least as_ripemd160_blocks(len) blocks. Return number of padded blocks.
+ */
+uint32_t
+as_ripemd160_pad(uint8_t* buf, size_t len);
+
+/**
+ * @private
+ * Return number of blocks required to hold a message of the given length after padding.
+ */
+static inline uint32_t
+as_ripemd160_blocks(size_t len)
+{
+	return (uint32_t)((len + 8) / AS_RIPEMD160_BLOCK_SIZE + 1);
+}
+
+#if defined(AS_RIPEMD160_SIMD)
+/**
+ * @private
+ * Hash AS_RIPEMD160_LANES padded messages that all have the same number of blocks.
+ * Each message is processed in its own SIMD lane. The 20 byte digests are written to
+ * digests[lane].
+ */
+void
+as_ripemd160_lanes(
+	const uint8_t* blocks[AS_RIPEMD160_LANES], uint32_t n_blocks,
+	uint8_t* digests[AS_RIPEMD160_LANES]
+	);
+#endif
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
@@ -240,6 +240,17 @@ typedef struct as_shm_info_s {
 	 * Array index offsets are synchronized with shared memory node offsets.
 	 */
 	as_node** local_nodes;
+
+	/**
+	 * Process local namespace hash index into shared memory partition tables.
+	 * Each slot contains partition table offset + 1 (zero indicates empty slot).
+	 */
+	uint32_t* ns_index;
+
+	/**
+	 * Namespace index slot count minus one. Slot count is a power of 2.
+	 */
+	uint32_t ns_index_mask;
 	
 	/**
 	 * Shared memory identifier.
@@ -310,12 +321,21 @@ as_shm_find_partition_table(as_cluster_shm* cluster_shm, const char* ns);
 
 /**
  * @private
- * Update shared memory partition tables for given namespace.
+ * Find partition table for namespace in shared memory using the process local namespace index.
+ * Namespaces not yet in the index are found by scanning shared memory and then added to the index.
  */
-void
+as_partition_table_shm*
+as_shm_lookup_partition_table(as_shm_info* shm_info, const char* ns);
+
+/**
+ * @private
+ * Update shared memory partition tables for given namespace. Only partitions newly claimed
+ * by the node are updated unless full is true. Return number of partition entries changed.
+ */
+uint32_t
 as_shm_update_partitions(
 	as_shm_info* shm_info, const char* ns, char* bitmap_b64, int64_t len, as_node* node,
-	uint8_t replica_size, uint8_t replica_index, uint32_t regime
+	uint8_t replica_size, uint8_t replica_index, uint32_t regime, bool full
 	);
 
 /**
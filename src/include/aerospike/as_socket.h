@@ -27,9 +27,11 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <errno.h>
 
 #define as_socket_fd int
+#define as_iovec struct iovec
 #define as_socket_data_t void
 #define as_socket_size_t size_t
 #define AS_CONNECTING EINPROGRESS
@@ -48,6 +50,11 @@
 #define SHUT_RDWR SD_BOTH
 #define as_close(_fd) closesocket((_fd))
 #define as_last_error() WSAGetLastError()
+
+typedef struct as_iovec_s {
+	void* iov_base;
+	size_t iov_len;
+} as_iovec;
 #endif
 
 #ifdef __cplusplus
@@ -57,6 +64,7 @@ extern "C" {
 struct ssl_ctx_st;
 struct evp_pkey_st;
 struct as_cluster_s;
+struct as_tls_session_s;
 
 /**
  * @private
@@ -92,8 +100,14 @@ typedef struct as_tls_context_s {
 	struct ssl_ctx_st* ssl_ctx;
 	struct evp_pkey_st* pkey;
 	void* cert_blacklist;
+	struct as_tls_session_s* sessions; // Resumable sessions keyed by node address.
+	uint32_t sessions_size;
+	uint32_t sessions_evict;
+	uint64_t session_hit_count;
+	uint64_t session_miss_count;
 	bool log_session_info;
 	bool for_login_only;
+	bool ktls;
 } as_tls_context;
 
 struct as_conn_pool_s;
@@ -101,6 +115,7 @@ struct as_node_s;
 
 /**
  * Socket fields for both regular and TLS sockets.
+ * A TLS socket that was offloaded to kernel TLS keeps ssl, but tls is NULL.
  */
 typedef struct as_socket_s {
 #if !defined(_MSC_VER)
@@ -275,6 +290,24 @@ as_socket_write_deadline(
 	uint32_t socket_timeout, uint64_t deadline
 	);
 
+/**
+ * @private
+ * Maximum number of buffer segments passed to as_socket_writev_deadline().
+ */
+#define AS_SOCKET_IOV_MAX 32
+
+/**
+ * @private
+ * Write buffer segments in order with future deadline in milliseconds.
+ * Plain sockets use a single gather write per socket event. TLS sockets write
+ * each segment separately. If deadline is zero, do not set deadline.
+ */
+as_status
+as_socket_writev_deadline(
+	as_error* err, as_socket* sock, struct as_node_s* node, as_iovec* iov, uint32_t iov_size,
+	uint32_t socket_timeout, uint64_t deadline
+	);
+
 /**
  * @private
  * Read socket data with future deadline in milliseconds.
@@ -45,6 +45,14 @@ void as_tls_set_name(as_socket* sock, const char* tls_name);
 struct ssl_st;
 void as_tls_set_context_name(struct ssl_st* ssl, as_tls_context* ctx, const char* tls_name);
 
+void as_tls_session_resume(
+	as_tls_context* ctx, struct ssl_st* ssl, struct sockaddr* addr, const char* tls_name
+	);
+
+void as_tls_session_save(
+	as_tls_context* ctx, struct ssl_st* ssl, struct sockaddr* addr, const char* tls_name
+	);
+
 int as_tls_connect_once(as_socket* sock);
 
 int as_tls_connect(as_socket* sock, uint64_t deadline);
@@ -17,6 +17,7 @@
 #pragma once 
 
 #include <aerospike/as_std.h>
+#include <aerospike/as_atomic.h>
 #include <aerospike/as_key.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_status.h>
@@ -40,6 +41,11 @@ extern "C" {
  */
 #define AS_TXN_WRITE_CAPACITY_DEFAULT 128
 
+/**
+ * Number of independently locked segments in each transaction hash.
+ */
+#define AS_TXN_HASH_SEGMENTS 16
+
 //---------------------------------
 // Types
 //---------------------------------
@@ -67,25 +73,27 @@ typedef struct as_txn_key {
 	as_digest_value digest;
 	char set[64];
 	uint64_t version;
-	struct as_txn_key* next;
+	bool used;
 } as_txn_key;
 
 /**
- * Transaction hash map row.
+ * Transaction hash map segment. Keys are stored inline in an open addressing table
+ * (linear probing) that doubles in size when three quarters full.
  */
 typedef struct {
-	bool used;
-	as_txn_key head;
-} as_txn_hash_row;
+	pthread_mutex_t lock;
+	uint32_t n_eles;
+	uint32_t n_slots;
+	as_txn_key* table;
+} as_txn_hash_segment;
 
 /**
- * Transaction hash map.
+ * Transaction hash map. Keys are distributed over segments by digest, so commands
+ * in a parallel batch rarely contend on the same segment lock.
  */
 typedef struct {
-	pthread_mutex_t lock;
 	uint32_t n_eles;
-	uint32_t n_rows;
-	as_txn_hash_row* table;
+	as_txn_hash_segment segments[AS_TXN_HASH_SEGMENTS];
 } as_txn_hash;
 
 /**
@@ -109,8 +117,7 @@ typedef struct as_txn {
  */
 typedef struct {
 	as_txn_hash* khash;
-	as_txn_hash_row* row;
-	as_txn_key* ele;
+	uint32_t segment;
 	uint32_t idx;
 } as_txn_iter;
 
@@ -199,7 +206,7 @@ as_txn_set_timeout(as_txn* txn, uint32_t timeout)
 static inline uint32_t
 as_txn_reads_size(as_txn* txn)
 {
-	return txn->reads.n_eles;
+	return as_load_uint32(&txn->reads.n_eles);
 }
 
 /**
@@ -220,7 +227,7 @@ as_txn_get_read_version(as_txn* txn, const uint8_t* digest);
 static inline uint32_t
 as_txn_writes_size(as_txn* txn)
 {
-	return txn->writes.n_eles;
+	return as_load_uint32(&txn->writes.n_eles);
 }
 
 /**
@@ -286,8 +293,7 @@ static inline void
 as_txn_iter_reads(as_txn_iter* iter, as_txn* txn)
 {
 	iter->khash = &txn->reads;
-	iter->row = txn->reads.table;
-	iter->ele = NULL;
+	iter->segment = 0;
 	iter->idx = 0;
 }
 
@@ -298,8 +304,7 @@ static inline void
 as_txn_iter_writes(as_txn_iter* iter, as_txn* txn)
 {
 	iter->khash = &txn->writes;
-	iter->row = txn->writes.table;
-	iter->ele = NULL;
+	iter->segment = 0;
 	iter->idx = 0;
 }
 
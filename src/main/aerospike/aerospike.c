@@ -365,6 +365,16 @@ aerospike_stop_on_interrupt(bool stop)
 	as_socket_stop_on_interrupt = stop;
 }
 
+extern uint32_t as_socket_spin_us;
+extern uint32_t as_socket_busy_poll_us;
+
+void
+aerospike_socket_spin(uint32_t spin_us, uint32_t busy_poll_us)
+{
+	as_socket_spin_us = spin_us;
+	as_socket_busy_poll_us = busy_poll_us;
+}
+
 as_status
 aerospike_truncate(
 	aerospike* as, as_error* err, as_policy_info* policy, const char* ns, const char* set,
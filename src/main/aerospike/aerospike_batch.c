@@ -25,6 +25,7 @@
 #include <aerospike/as_key.h>
 #include <aerospike/as_list.h>
 #include <aerospike/as_log_macros.h>
+#include <aerospike/as_monitor.h>
 #include <aerospike/as_msgpack.h>
 #include <aerospike/as_operations.h>
 #include <aerospike/as_policy.h>
@@ -160,6 +161,13 @@ typedef struct {
 	bool error_row;
 } as_async_batch_executor;
 
+typedef struct {
+	as_monitor monitor;
+	as_error err;
+	as_status status;
+	bool error_row;
+} as_batch_sync_wait;
+
 typedef struct as_async_batch_command {
 	as_event_command command;
 	uint8_t space[];
@@ -216,6 +224,12 @@ as_batch_keys_prepare_txn(as_txn* txn, const as_batch* batch, as_error* err, uin
 	}
 
 	uint32_t n_keys = batch->keys.size;
+	status = as_keys_set_digests(err, batch->keys.entries, n_keys);
+
+	if (status != AEROSPIKE_OK) {
+		return status;
+	}
+
 	uint64_t* versions = cf_malloc(sizeof(uint64_t) * n_keys);
 
 	for (uint32_t i = 0; i < n_keys; i++) {
@@ -227,19 +241,23 @@ as_batch_keys_prepare_txn(as_txn* txn, const as_batch* batch, as_error* err, uin
 			return status;
 		}
 
-		status = as_key_set_digest(err, key);
-
-		if (status != AEROSPIKE_OK) {
-			destroy_versions(versions);
-			return status;
-		}
-
 		versions[i] = as_txn_get_read_version(txn, key->digest.value);
 	}
 	*versions_pp = versions;
 	return AEROSPIKE_OK;
 }
 
+static inline as_status
+as_batch_records_set_digests(as_error* err, as_vector* list)
+{
+	if (list->size == 0) {
+		return AEROSPIKE_OK;
+	}
+
+	as_batch_base_record* rec = as_vector_get(list, 0);
+	return as_keys_set_digests_stride(err, &rec->key, list->item_size, list->size);
+}
+
 static as_status
 as_batch_records_prepare_txn(
 	as_txn* txn, as_batch_records* records, as_error* err, uint64_t** versions_pp
@@ -253,6 +271,12 @@ as_batch_records_prepare_txn(
 
 	as_vector* list = &records->list;
 	uint32_t n_keys = records->list.size;
+	status = as_batch_records_set_digests(err, list);
+
+	if (status != AEROSPIKE_OK) {
+		return status;
+	}
+
 	uint64_t* versions = cf_malloc(sizeof(uint64_t) * n_keys);
 
 	for (uint32_t i = 0; i < n_keys; i++) {
@@ -264,13 +288,6 @@ as_batch_records_prepare_txn(
 			return status;
 		}
 
-		status = as_key_set_digest(err, &rec->key);
-
-		if (status != AEROSPIKE_OK) {
-			destroy_versions(versions);
-			return status;
-		}
-
 		versions[i] = as_txn_get_read_version(txn, rec->key.digest.value);
 	}
 	*versions_pp = versions;
@@ -284,7 +301,7 @@ as_batch_parse_record(uint8_t** pp, as_error* err, as_msg* msg, as_record* rec,
 	rec->gen = msg->generation;
 	rec->ttl = cf_server_void_time_to_ttl(msg->record_ttl);
 
-	as_status status = as_command_parse_bins(pp, err, rec, msg->n_ops, deserialize);
+	as_status status = as_command_parse_bins(pp, err, rec, msg->n_ops, deserialize, false);
 
 	if (status != AEROSPIKE_OK) {
 		as_record_destroy(rec);
@@ -312,6 +329,22 @@ as_batch_complete_async(as_event_executor* executor)
 	}
 }
 
+static void
+as_batch_complete_sync(as_event_executor* executor)
+{
+	as_async_batch_executor* e = (as_async_batch_executor*)executor;
+	as_batch_sync_wait* wait = executor->udata;
+
+	// Errors are not notified when the executor was cancelled, because the error has
+	// already been returned by as_batch_execute_async().
+	if (executor->notify && executor->err) {
+		as_error_copy(&wait->err, executor->err);
+		wait->status = executor->err->code;
+	}
+	wait->error_row = e->error_row;
+	as_monitor_notify(&wait->monitor);
+}
+
 static inline bool
 as_batch_set_error_row(uint8_t res)
 {
@@ -2084,7 +2117,8 @@ as_batch_execute_records(as_batch_task_records* btr, as_error* err, as_command*
 		size_t comp_capacity = as_command_compress_max_size(size);
 		size_t comp_size = comp_capacity;
 		uint8_t* comp_buf = as_command_buffer_init(comp_capacity);
-		status = as_command_compress(err, buf, size, comp_buf, &comp_size);
+		status = as_command_compress(err, buf, size, comp_buf, &comp_size,
+			task->as->cluster->compression_level);
 		as_command_buffer_free(buf, capacity);
 
 		if (status != AEROSPIKE_OK) {
@@ -2343,7 +2377,8 @@ as_batch_execute_keys(as_batch_task_keys* btk, as_error* err, as_command* parent
 		size_t comp_capacity = as_command_compress_max_size(size);
 		size_t comp_size = comp_capacity;
 		uint8_t* comp_buf = as_command_buffer_init(comp_capacity);
-		status = as_command_compress(err, buf, size, comp_buf, &comp_size);
+		status = as_command_compress(err, buf, size, comp_buf, &comp_size,
+			task->as->cluster->compression_level);
 		as_command_buffer_free(buf, capacity);
 
 		if (status != AEROSPIKE_OK) {
@@ -3033,6 +3068,50 @@ as_batch_node_find(as_vector* batch_nodes, as_node* node)
 	return NULL;
 }
 
+static void
+as_batch_split_nodes(as_vector* batch_nodes, uint32_t max_keys)
+{
+	if (max_keys == 0) {
+		return;
+	}
+
+	// Split node key groups into sub-batches of at most max_keys keys. Each sub-batch is
+	// sent as a separate command. Results are stored at the original key offsets, so
+	// result order is not affected.
+	uint32_t n_batch_nodes = batch_nodes->size;
+
+	for (uint32_t i = 0; i < n_batch_nodes; i++) {
+		as_batch_node* batch_node = as_vector_get(batch_nodes, i);
+		uint32_t size = batch_node->offsets.size;
+
+		if (size <= max_keys) {
+			continue;
+		}
+
+		as_node* node = batch_node->node;
+		uint32_t* offsets = batch_node->offsets.list;
+
+		for (uint32_t begin = max_keys; begin < size; begin += max_keys) {
+			uint32_t count = size - begin;
+
+			if (count > max_keys) {
+				count = max_keys;
+			}
+
+			// Vector may be reallocated, so batch_node is not valid after this call.
+			as_batch_node* sub = as_vector_reserve(batch_nodes);
+			as_node_reserve(node);
+			sub->node = node;
+			as_vector_init(&sub->offsets, sizeof(uint32_t), count);
+			memcpy(sub->offsets.list, offsets + begin, sizeof(uint32_t) * count);
+			sub->offsets.size = count;
+		}
+
+		batch_node = as_vector_get(batch_nodes, i);
+		batch_node->offsets.size = max_keys;
+	}
+}
+
 static void
 as_batch_release_nodes(as_vector* batch_nodes)
 {
@@ -3149,13 +3228,20 @@ as_batch_keys_execute(
 		return as_error_set_message(err, AEROSPIKE_ERR_SERVER, cluster_empty_error);
 	}
 
+	// Compute all digests before mapping keys to nodes, so keys are hashed in SIMD lanes.
+	as_status status = as_keys_set_digests(err, batch->keys.entries, n_keys);
+
+	if (status != AEROSPIKE_OK) {
+		destroy_versions(versions);
+		return status;
+	}
+
 	as_batch_result* results = batch_results_init(sizeof(as_batch_result), n_keys);
 
 	as_vector batch_nodes;
 	as_vector_inita(&batch_nodes, sizeof(as_batch_node), n_nodes);
 
 	char* ns = batch->keys.entries[0].ns;
-	as_status status = AEROSPIKE_OK;
 	
 	// Create initial key capacity for each node as average + 25%.
 	uint32_t offsets_capacity = n_keys / n_nodes;
@@ -3181,15 +3267,6 @@ as_batch_keys_execute(
 		result->in_doubt = false;
 		as_record_init(&result->record, 0);
 
-		status = as_key_set_digest(err, key);
-		
-		if (status != AEROSPIKE_OK) {
-			destroy_versions(versions);
-			batch_results_free(results, n_keys);
-			as_batch_release_nodes(&batch_nodes);
-			return status;
-		}
-
 		as_node* node;
 		status = as_batch_get_node(cluster, key, &rep, rec->has_write, NULL, &node);
 
@@ -3230,6 +3307,8 @@ as_batch_keys_execute(
 		return as_error_set_message(err, AEROSPIKE_BATCH_FAILED, "Batch failed");
 	}
 
+	as_batch_split_nodes(&batch_nodes, policy->max_records_per_command);
+
 	uint32_t error_mutex = 0;
 
 	// Initialize task.
@@ -3264,12 +3343,14 @@ as_batch_keys_execute(
 		btk.base.complete_q = cf_queue_create(sizeof(as_batch_complete_task), true);
 		
 		uint32_t n_wait_nodes = 0;
-		
+
+		// Node groups may have been split by max_records_per_command, so the task count is
+		// not bounded by the node count. Allocate all tasks at once on the heap.
+		as_batch_task_keys* tasks = cf_malloc(sizeof(as_batch_task_keys) * batch_nodes.size);
+
 		// Run task for each node.
 		for (uint32_t i = 0; i < batch_nodes.size; i++) {
-			// Stack allocate task for each node.  It should be fine since the task
-			// only needs to be valid within this function.
-			as_batch_task_keys* btk_node = alloca(sizeof(as_batch_task_keys));
+			as_batch_task_keys* btk_node = &tasks[i];
 			memcpy(btk_node, &btk, sizeof(as_batch_task_keys));
 			
 			as_batch_node* batch_node = as_vector_get(&batch_nodes, i);
@@ -3302,6 +3383,7 @@ as_batch_keys_execute(
 		
 		// Release temporary queue.
 		cf_queue_destroy(btk.base.complete_q);
+		cf_free(tasks);
 	}
 	else {
 		// Run batch requests sequentially in same thread.
@@ -3373,12 +3455,14 @@ as_batch_execute_sync(
 		btr.base.complete_q = cf_queue_create(sizeof(as_batch_complete_task), true);
 		
 		uint32_t n_wait_nodes = 0;
-		
+
+		// Node groups may have been split by max_records_per_command, so the task count is
+		// not bounded by the node count. Allocate all tasks at once on the heap.
+		as_batch_task_records* tasks = cf_malloc(sizeof(as_batch_task_records) * n_batch_nodes);
+
 		// Run task for each node.
 		for (uint32_t i = 0; i < n_batch_nodes; i++) {
-			// Stack allocate task for each node.  It should be fine since the task
-			// only needs to be valid within this function.
-			as_batch_task_records* btr_node = alloca(sizeof(as_batch_task_records));
+			as_batch_task_records* btr_node = &tasks[i];
 			memcpy(btr_node, &btr, sizeof(as_batch_task_records));
 			
 			as_batch_node* batch_node = as_vector_get(batch_nodes, i);
@@ -3411,6 +3495,7 @@ as_batch_execute_sync(
 		
 		// Release temporary queue.
 		cf_queue_destroy(btr.base.complete_q);
+		cf_free(tasks);
 	}
 	else {
 		// Run batch requests sequentially in same thread.
@@ -3586,7 +3671,8 @@ as_batch_execute_async(
 				as_event_command* cmd = &bc->command;
 
 				// Compress buffer and execute.
-				status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size);
+				status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size,
+					cmd->cluster->compression_level);
 
 				if (status != AEROSPIKE_OK) {
 					as_event_executor_cancel(exec, i);
@@ -3613,6 +3699,87 @@ as_batch_execute_async(
 	return status;
 }
 
+static bool
+as_batch_use_event_loops(as_config* config, const as_policy_batch* policy, uint32_t n_batch_nodes)
+{
+	if (! (config->sync_batch_event_loops && policy->concurrent && n_batch_nodes > 1 &&
+		   as_event_loop_size > 0)) {
+		return false;
+	}
+
+	// Waiting in an event loop thread would block the commands that are being waited on.
+	pthread_t self = pthread_self();
+
+	for (uint32_t i = 0; i < as_event_loop_size; i++) {
+		if (pthread_equal(as_event_loops[i].thread, self)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static as_status
+as_batch_execute_event_loop(
+	aerospike* as, as_error* err, const as_policy_batch* policy, as_txn* txn, uint64_t* versions,
+	uint8_t txn_attr, bool has_write, as_batch_replica* rep, as_batch_records* records,
+	as_vector* batch_nodes, bool* error_row
+	)
+{
+	// Run node commands on an event loop with non-blocking sockets and wait once for the
+	// whole batch, instead of occupying a thread pool thread per node.
+	as_batch_sync_wait wait;
+	as_monitor_init(&wait.monitor);
+	as_error_init(&wait.err);
+	wait.status = AEROSPIKE_OK;
+	wait.error_row = false;
+
+	as_async_batch_executor* be = cf_malloc(sizeof(as_async_batch_executor));
+	be->records = records;
+	be->txn = txn;
+	be->versions = versions;
+	be->listener = NULL;
+	be->read_mode_sc = policy->read_mode_sc;
+	be->txn_attr = txn_attr;
+	be->has_write = has_write;
+	be->error_row = *error_row;
+
+	as_event_executor* exec = &be->executor;
+	pthread_mutex_init(&exec->lock, NULL);
+	exec->commands = 0;
+	exec->event_loop = as_event_assign(NULL);
+	exec->complete_fn = as_batch_complete_sync;
+	exec->udata = &wait;
+	exec->err = NULL;
+	exec->ns = NULL;
+	exec->cluster_key = 0;
+	exec->max_concurrent = 0;
+	exec->max = 0;
+	exec->count = 0;
+	exec->queued = 0;
+	exec->notify = true;
+	exec->notify_cancel = true;
+	exec->valid = true;
+
+	as_status status = as_batch_execute_async(as, err, policy, rep, &records->list, batch_nodes, be);
+
+	// Wait even when as_batch_execute_async() failed, because commands that were already
+	// queued still reference the records.
+	as_monitor_wait(&wait.monitor);
+	as_monitor_destroy(&wait.monitor);
+
+	if (status != AEROSPIKE_OK) {
+		return status;
+	}
+
+	if (wait.status != AEROSPIKE_OK) {
+		as_error_copy(err, &wait.err);
+		return wait.status;
+	}
+
+	*error_row = wait.error_row;
+	return AEROSPIKE_OK;
+}
+
 static void
 as_batch_records_cleanup(
 	uint64_t* versions, as_async_batch_executor* async_executor, as_vector* batch_nodes
@@ -3656,11 +3823,17 @@ as_batch_records_execute(
 		as_batch_records_cleanup(versions, async_executor, NULL);
 		return as_error_set_message(err, AEROSPIKE_ERR_SERVER, cluster_empty_error);
 	}
+
+	// Compute all digests before mapping keys to nodes, so keys are hashed in SIMD lanes.
+	as_status status = as_batch_records_set_digests(err, list);
+
+	if (status != AEROSPIKE_OK) {
+		as_batch_records_cleanup(versions, async_executor, NULL);
+		return status;
+	}
 	
 	as_vector batch_nodes;
 	as_vector_inita(&batch_nodes, sizeof(as_batch_node), n_nodes);
-
-	as_status status = AEROSPIKE_OK;
 	
 	// Create initial key capacity for each node as average + 25%.
 	uint32_t offsets_capacity = n_keys / n_nodes;
@@ -3684,13 +3857,6 @@ as_batch_records_execute(
 		rec->result = AEROSPIKE_NO_RESPONSE;
 		as_record_init(&rec->record, 0);
 		
-		status = as_key_set_digest(err, key);
-		
-		if (status != AEROSPIKE_OK) {
-			as_batch_records_cleanup(versions, async_executor, &batch_nodes);
-			return status;
-		}
-		
 		as_node* node;
 		status = as_batch_get_node(cluster, key, &rep, rec->has_write, NULL, &node);
 
@@ -3726,13 +3892,23 @@ as_batch_records_execute(
 		return as_error_set_message(err, AEROSPIKE_BATCH_FAILED, "Batch failed");
 	}
 
+	as_batch_split_nodes(&batch_nodes, policy->max_records_per_command);
+
 	if (async_executor) {
 		async_executor->error_row = error_row;
 		return as_batch_execute_async(as, err, policy, &rep, list, &batch_nodes, async_executor);
 	}
 	else {
-		status = as_batch_execute_sync(as, err, policy, txn, versions, txn_attr, has_write, &rep, list,
-			n_keys, &batch_nodes, NULL, &error_row);
+		as_config* config = aerospike_load_config(as);
+
+		if (as_batch_use_event_loops(config, policy, batch_nodes.size)) {
+			status = as_batch_execute_event_loop(as, err, policy, txn, versions, txn_attr, has_write,
+				&rep, records, &batch_nodes, &error_row);
+		}
+		else {
+			status = as_batch_execute_sync(as, err, policy, txn, versions, txn_attr, has_write, &rep,
+				list, n_keys, &batch_nodes, NULL, &error_row);
+		}
 
 		destroy_versions(versions);
 
@@ -3790,6 +3966,7 @@ as_batch_records_execute_async(
 	exec->count = 0;
 	exec->queued = 0;
 	exec->notify = true;
+	exec->notify_cancel = false;
 	exec->valid = true;
 
 	return as_batch_records_execute(as, err, policy, records, txn, versions, be, txn_attr, has_write);
@@ -4396,7 +4573,8 @@ as_batch_retry_async(as_event_command* parent, bool timeout)
 
 			// Compress buffer and execute.
 			as_error err;
-			as_status status = as_command_compress(&err, ubuf, size, cmd->buf, &comp_size);
+			as_status status = as_command_compress(&err, ubuf, size, cmd->buf, &comp_size,
+				cmd->cluster->compression_level);
 
 			if (status != AEROSPIKE_OK) {
 				as_event_executor_error(e, &err, bnodes.size - i);
@@ -4516,6 +4694,7 @@ as_policy_batch_parent_read_merge(aerospike* as, const as_policy_batch* src, as_
 		mrg->base.compress = src->base.compress;
 		mrg->base.error_detail_verbosity = src->base.error_detail_verbosity;
 		mrg->read_touch_ttl_percent = src->read_touch_ttl_percent;
+		mrg->max_records_per_command = src->max_records_per_command;
 		mrg->send_set_name = src->send_set_name;
 		mrg->deserialize = src->deserialize;
 		return mrg;
@@ -4569,6 +4748,7 @@ as_policy_batch_parent_write_merge(aerospike* as, const as_policy_batch* src, as
 		mrg->base.compress = src->base.compress;
 		mrg->base.error_detail_verbosity = src->base.error_detail_verbosity;
 		mrg->read_touch_ttl_percent = src->read_touch_ttl_percent;
+		mrg->max_records_per_command = src->max_records_per_command;
 		mrg->send_set_name = src->send_set_name;
 		mrg->deserialize = src->deserialize;
 		return mrg;
@@ -142,6 +142,7 @@ as_command_init_read(
 	cmd->buf_size = size;
 	cmd->partition_id = pi->partition_id;
 	cmd->latency_type = AS_LATENCY_TYPE_READ;
+	cmd->hedge_delay = 0;
 	as_cluster_add_command_count(cluster);
 
 	if (pi->sc_mode) {
@@ -174,14 +175,15 @@ as_command_init_read(
 static inline as_status
 as_command_execute_read(
 	as_cluster* cluster, as_error* err, const as_policy_base* policy, as_policy_replica replica,
-	as_policy_read_mode_sc read_mode_sc, const as_key* key, uint8_t* buf, size_t size,
-	as_partition_info* pi, const as_parse_results_fn fn, void* udata
+	as_policy_read_mode_sc read_mode_sc, uint32_t hedge_delay, const as_key* key, uint8_t* buf,
+	size_t size, as_partition_info* pi, const as_parse_results_fn fn, void* udata
 	)
 {
 	as_command cmd;
 	as_command_init_read(&cmd, cluster, policy, replica, read_mode_sc, key, size, pi,
 						 fn, udata);
 
+	cmd.hedge_delay = hedge_delay;
 	cmd.buf = buf;
 	as_command_start_timer(&cmd);
 	return as_command_execute(&cmd, err);
@@ -208,6 +210,7 @@ as_command_init_write(
 	cmd->replica_size = pi->replica_size;
 	cmd->replica_index = as_replica_index_init_write(cluster, cmd->replica);
 	cmd->latency_type = AS_LATENCY_TYPE_WRITE;
+	cmd->hedge_delay = 0;
 	as_cluster_add_command_count(cluster);
 }
 
@@ -297,7 +300,8 @@ as_txn_monitor_callback(as_error* err, as_record* rec, void* udata, as_event_loo
 		*(uint32_t*)(cmd->ubuf + cmd->pos) = cmd->txn->deadline;
 
 		size_t comp_size = cmd->write_len;
-		as_status status = as_command_compress(err, cmd->ubuf, cmd->len, cmd->buf, &comp_size);
+		as_status status = as_command_compress(err, cmd->ubuf, cmd->len, cmd->buf, &comp_size,
+			cmd->cluster->compression_level);
 
 		if (status == AEROSPIKE_OK) {
 			cmd->write_len = (uint32_t)comp_size;
@@ -378,7 +382,8 @@ as_async_compress_command_execute(
 	}
 	else {
 		// Compress buffer and execute.
-		as_status status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size);
+		as_status status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size,
+			cmd->cluster->compression_level);
 
 		if (status != AEROSPIKE_OK) {
 			as_event_command_destroy(cmd);
@@ -442,6 +447,8 @@ as_policy_read_merge(aerospike* as, const as_policy_read* src, as_policy_read* m
 		mrg->read_touch_ttl_percent = src->read_touch_ttl_percent;
 		mrg->deserialize = src->deserialize;
 		mrg->async_heap_rec = src->async_heap_rec;
+		mrg->bin_arena = src->bin_arena;
+		mrg->hedge_delay = src->hedge_delay;
 		return mrg;
 	}
 	else {
@@ -483,25 +490,23 @@ aerospike_key_get(
 	as_command_parse_result_data data;
 	data.record = rec;
 	data.deserialize = policy->deserialize;
+	data.bin_arena = policy->bin_arena;
 
 	status = as_command_execute_read(cluster, err, &policy->base, policy->replica,
-				policy->read_mode_sc, key, buf, size, &pi, as_command_parse_result, &data);
+				policy->read_mode_sc, policy->hedge_delay, key, buf, size, &pi,
+				as_command_parse_result, &data);
 
 	as_command_buffer_free(buf, size);
 	return status;
 }
 
-as_status
-aerospike_key_get_async(
-	aerospike* as, as_error* err, const as_policy_read* policy, const as_key* key,
+static as_status
+as_key_get_async_create(
+	as_cluster* cluster, as_error* err, const as_policy_read* policy, const as_key* key,
 	as_async_record_listener listener, void* udata, as_event_loop* event_loop,
-	as_pipe_listener pipe_listener
+	as_pipe_listener pipe_listener, as_event_command** cmd_out
 	)
 {
-	as_policy_read merged;
-	policy = as_policy_read_merge(as, policy, &merged);
-
-	as_cluster* cluster = as->cluster;
 	as_partition_info pi;
 	as_status status = as_command_prepare(cluster, err, &policy->base, key, &pi);
 
@@ -521,6 +526,7 @@ aerospike_key_get_async(
 		cluster, &policy->base, &pi, ri.replica, ri.replica_index, policy->deserialize,
 		policy->async_heap_rec, ri.flags, listener, udata, event_loop, pipe_listener, size,
 		as_event_command_parse_result, AS_ASYNC_TYPE_RECORD, AS_LATENCY_TYPE_READ, NULL, 0);
+	cmd->hedge_delay = policy->hedge_delay;
 
 	uint32_t timeout = as_command_server_timeout(&policy->base);
 	uint8_t* p = as_command_write_header_read(cmd->buf, &policy->base, policy->read_mode_ap,
@@ -530,9 +536,67 @@ aerospike_key_get_async(
 	p = as_command_write_key(p, &policy->base, policy->key, key, &tdata);
 	p = as_command_write_filter(&policy->base, filter_size, p);
 	cmd->write_len = (uint32_t)as_command_write_end(cmd->buf, p);
+	*cmd_out = cmd;
+	return AEROSPIKE_OK;
+}
+
+as_status
+aerospike_key_get_async(
+	aerospike* as, as_error* err, const as_policy_read* policy, const as_key* key,
+	as_async_record_listener listener, void* udata, as_event_loop* event_loop,
+	as_pipe_listener pipe_listener
+	)
+{
+	as_policy_read merged;
+	policy = as_policy_read_merge(as, policy, &merged);
+
+	as_event_command* cmd;
+	as_status status = as_key_get_async_create(as->cluster, err, policy, key, listener, udata,
+		event_loop, pipe_listener, &cmd);
+
+	if (status != AEROSPIKE_OK) {
+		return status;
+	}
 	return as_event_command_execute(cmd, err);
 }
 
+as_status
+aerospike_key_get_async_many(
+	aerospike* as, as_error* err, const as_policy_read* policy, const as_key* keys,
+	uint32_t n_keys, as_async_record_listener listener, void* udata[], as_event_loop* event_loop
+	)
+{
+	if (n_keys == 0) {
+		return AEROSPIKE_OK;
+	}
+
+	as_policy_read merged;
+	policy = as_policy_read_merge(as, policy, &merged);
+
+	// Run all commands on the same event loop, so they can be queued together.
+	event_loop = as_event_assign(event_loop);
+
+	as_event_command** cmds = cf_malloc(sizeof(as_event_command*) * n_keys);
+
+	for (uint32_t i = 0; i < n_keys; i++) {
+		as_status status = as_key_get_async_create(as->cluster, err, policy, &keys[i], listener,
+			udata ? udata[i] : NULL, event_loop, NULL, &cmds[i]);
+
+		if (status != AEROSPIKE_OK) {
+			// No commands have been queued yet.
+			for (uint32_t j = 0; j < i; j++) {
+				as_event_command_destroy(cmds[j]);
+			}
+			cf_free(cmds);
+			return status;
+		}
+	}
+
+	as_status status = as_event_command_execute_many(event_loop, cmds, n_keys, err);
+	cf_free(cmds);
+	return status;
+}
+
 //---------------------------------
 // Read Selected Bins
 //---------------------------------
@@ -586,9 +650,11 @@ aerospike_key_select(
 	as_command_parse_result_data data;
 	data.record = rec;
 	data.deserialize = policy->deserialize;
+	data.bin_arena = policy->bin_arena;
 
 	status = as_command_execute_read(cluster, err, &policy->base, policy->replica,
-				policy->read_mode_sc, key, buf, size, &pi, as_command_parse_result, &data);
+				policy->read_mode_sc, policy->hedge_delay, key, buf, size, &pi,
+				as_command_parse_result, &data);
 
 	as_command_buffer_free(buf, size);
 	return status;
@@ -633,6 +699,7 @@ aerospike_key_select_async(
 		cluster, &policy->base, &pi, ri.replica, ri.replica_index, policy->deserialize,
 		policy->async_heap_rec, ri.flags, listener, udata, event_loop, pipe_listener, size,
 		as_event_command_parse_result, AS_ASYNC_TYPE_RECORD, AS_LATENCY_TYPE_READ, NULL, 0);
+	cmd->hedge_delay = policy->hedge_delay;
 
 	uint32_t timeout = as_command_server_timeout(&policy->base);
 	uint8_t* p = as_command_write_header_read(cmd->buf, &policy->base, policy->read_mode_ap,
@@ -696,9 +763,11 @@ aerospike_key_select_bins(
 	as_command_parse_result_data data;
 	data.record = rec;
 	data.deserialize = policy->deserialize;
+	data.bin_arena = policy->bin_arena;
 
 	status = as_command_execute_read(cluster, err, &policy->base, policy->replica,
-				policy->read_mode_sc, key, buf, size, &pi, as_command_parse_result, &data);
+				policy->read_mode_sc, policy->hedge_delay, key, buf, size, &pi,
+				as_command_parse_result, &data);
 
 	as_command_buffer_free(buf, size);
 	return status;
@@ -742,6 +811,7 @@ aerospike_key_select_bins_async(
 		cluster, &policy->base, &pi, ri.replica, ri.replica_index, policy->deserialize,
 		policy->async_heap_rec, ri.flags, listener, udata, event_loop, pipe_listener, size,
 		as_event_command_parse_result, AS_ASYNC_TYPE_RECORD, AS_LATENCY_TYPE_READ, NULL, 0);
+	cmd->hedge_delay = policy->hedge_delay;
 
 	uint32_t timeout = as_command_server_timeout(&policy->base);
 	uint8_t* p = as_command_write_header_read(cmd->buf, &policy->base, policy->read_mode_ap,
@@ -793,7 +863,8 @@ aerospike_key_exists(
 	size = as_command_write_end(buf, p);
 
 	status = as_command_execute_read(cluster, err, &policy->base, policy->replica,
-				policy->read_mode_sc, key, buf, size, &pi, as_command_parse_header, rec);
+				policy->read_mode_sc, policy->hedge_delay, key, buf, size, &pi,
+				as_command_parse_header, rec);
 
 	as_command_buffer_free(buf, size);
 
@@ -833,6 +904,7 @@ aerospike_key_exists_async(
 		cluster, &policy->base, &pi, ri.replica, ri.replica_index, false, policy->async_heap_rec,
 		ri.flags, listener, udata, event_loop, pipe_listener, size, as_event_command_parse_result,
 		AS_ASYNC_TYPE_RECORD, AS_LATENCY_TYPE_READ, NULL, 0);
+	cmd->hedge_delay = policy->hedge_delay;
 
 	uint8_t* p = as_command_write_header_read_header(cmd->buf, &policy->base, policy->read_mode_ap,
 		policy->read_mode_sc, policy->read_touch_ttl_percent, tdata.n_fields, 0,
@@ -853,6 +925,7 @@ typedef struct as_put_s {
 	const as_key* key;
 	as_record* rec;
 	as_queue* buffers;
+	as_command_gather* gather;
 	size_t size;
 	as_command_txn_data tdata;
 	uint32_t filter_size;
@@ -869,6 +942,7 @@ as_put_init(
 	put->key = key;
 	put->rec = rec;
 	put->buffers = buffers;
+	put->gather = NULL;
 	put->size = as_command_key_size(&policy->base, policy->key, key, true, &put->tdata);
 	put->filter_size = as_command_filter_size(&policy->base, &put->tdata.n_fields);
 	put->size += put->filter_size;
@@ -905,11 +979,17 @@ as_put_write(void* udata, uint8_t* buf)
 	uint16_t n_bins = put->n_bins;
 	as_queue* buffers = put->buffers;
 
+	as_command_gather* gather = put->gather;
+
+	if (gather) {
+		as_command_gather_init(gather, buf);
+	}
+
 	for (uint16_t i = 0; i < n_bins; i++) {
-		p = as_command_write_bin(p, AS_OPERATOR_WRITE, &bins[i], buffers);
+		p = as_command_write_bin_gather(p, AS_OPERATOR_WRITE, &bins[i], buffers, gather);
 	}
 	as_buffers_destroy(buffers);
-	return as_command_write_end(buf, p);
+	return gather ? as_command_gather_write_end(gather, buf, p) : as_command_write_end(buf, p);
 }
 
 const as_policy_write*
@@ -997,6 +1077,19 @@ aerospike_key_put(
 	as_command_init_write(&cmd, as->cluster, &policy->base, policy->replica, key, put.size, &pi,
 						  as_command_parse_header, NULL);
 
+	if (compression_threshold == 0 || put.size <= compression_threshold) {
+		size_t gather_size = as_command_gather_size(rec->bins.entries, put.n_bins);
+
+		if (gather_size > 0) {
+			// Send large string and blob values from the record instead of copying them
+			// into the command buffer. Compressed commands still require a contiguous buffer.
+			as_command_gather gather;
+			put.gather = &gather;
+			cmd.buf_size = put.size - gather_size;
+			return as_command_send_gather(&cmd, err, &gather, as_put_write, &put);
+		}
+	}
+
 	status = as_command_send(&cmd, err, compression_threshold, as_put_write, &put);
 	return status;
 }
@@ -1297,6 +1390,7 @@ as_policy_operate_merge(aerospike* as, bool is_write, const as_policy_operate* s
 		mrg->deserialize = src->deserialize;
 		mrg->on_locking_only = src->on_locking_only;
 		mrg->async_heap_rec = src->async_heap_rec;
+		mrg->bin_arena = src->bin_arena;
 		mrg->respond_all_ops = src->respond_all_ops;
 		return mrg;
 	}
@@ -1476,6 +1570,7 @@ aerospike_key_operate(
 	as_command_parse_result_data data;
 	data.record = rec;
 	data.deserialize = policy->deserialize;
+	data.bin_arena = policy->bin_arena;
 
 	as_command cmd;
 
@@ -1600,7 +1695,8 @@ aerospike_key_operate_async(
 				comp_size, as_event_command_parse_result, AS_ASYNC_TYPE_RECORD, AS_LATENCY_TYPE_READ, ubuf, (uint32_t)size);
 
 			// Compress buffer and execute.
-			status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size);
+			status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size,
+				cmd->cluster->compression_level);
 
 			if (status != AEROSPIKE_OK) {
 				as_event_command_destroy(cmd);
@@ -2056,7 +2152,8 @@ as_txn_monitor_operate_async(
 			ubuf, (uint32_t)size);
 
 		// Compress buffer and execute.
-		status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size);
+		status = as_command_compress(err, ubuf, size, cmd->buf, &comp_size,
+			cmd->cluster->compression_level);
 
 		if (status != AEROSPIKE_OK) {
 			as_event_command_destroy(cmd);
@@ -2132,7 +2229,7 @@ as_txn_verify_single(
 	size = as_command_write_end(buf, p);
 
 	status = as_command_execute_read(cluster, err, &policy->base, policy->replica,
-			policy->read_mode_sc, key, buf, size, &pi, parse_result_code, NULL);
+			policy->read_mode_sc, 0, key, buf, size, &pi, parse_result_code, NULL);
 
 	as_command_buffer_free(buf, size);
 	return status;
@@ -32,6 +32,7 @@
 #include <aerospike/as_policy.h>
 #include <aerospike/as_query.h>
 #include <aerospike/as_query_validate.h>
+#include <aerospike/as_record_stream.h>
 #include <aerospike/as_random.h>
 #include <aerospike/as_serializer.h>
 #include <aerospike/as_sleep.h>
@@ -41,6 +42,7 @@
 #include <aerospike/as_thread_pool.h>
 #include <aerospike/as_udf_context.h>
 #include <aerospike/mod_lua.h>
+#include <pthread.h>
 
 //---------------------------------
 // Imports
@@ -55,6 +57,23 @@ extern bool as_op_is_write[];
 #define QUERY_FOREGROUND 1
 #define QUERY_BACKGROUND 2
 
+/**
+ * Blocking queue of aggregation values read by a Lua stream UDF. Writers block when a bounded
+ * queue is full. The queue is closed when the reader finishes, so blocked writers can abort.
+ */
+typedef struct as_query_stream_s {
+	as_stream stream;
+	pthread_mutex_t lock;
+	pthread_cond_t not_empty;
+	pthread_cond_t not_full;
+	as_val** vals;
+	uint32_t capacity;
+	uint32_t max;
+	uint32_t head;
+	uint32_t size;
+	bool closed;
+} as_query_stream;
+
 typedef struct as_query_user_callback_s {
 	aerospike_query_foreach_callback callback;
 	void* udata;
@@ -73,7 +92,8 @@ typedef struct as_query_task_s {
 	void* udata;
 	as_error* err;
 	uint32_t* error_mutex;
-	cf_queue* input_queue;
+	as_query_stream* input_queue;
+	as_query_stream* node_queues;
 	cf_queue* complete_q;
 	uint64_t task_id;
 	uint64_t cluster_key;
@@ -86,8 +106,10 @@ typedef struct as_query_task_s {
 
 typedef struct as_query_task_aggr_s {
 	const as_query* query;
-	as_stream* input_stream;
-	as_query_user_callback* callback_data;
+	as_query_stream* input;
+	as_stream* output;
+	as_query_stream* combine;
+	uint32_t* remaining;
 	uint32_t* error_mutex;
 	as_error* err;
 	cf_queue* complete_q;
@@ -113,6 +135,7 @@ typedef struct as_async_query_executor {
 	uint32_t info_timeout;
 	uint16_t n_fields;
 	bool deserialize;
+	bool borrow_bytes;
 	bool has_where;
 } as_async_query_executor;
 
@@ -202,20 +225,60 @@ as_input_stream_destroy(as_stream *s)
 static as_val*
 as_input_stream_read(const as_stream* s)
 {
-	as_val* val = NULL;
-	cf_queue_pop(as_stream_source(s), &val, CF_QUEUE_FOREVER);
+	as_query_stream* qs = as_stream_source(s);
+
+	pthread_mutex_lock(&qs->lock);
+
+	while (qs->size == 0) {
+		pthread_cond_wait(&qs->not_empty, &qs->lock);
+	}
+
+	as_val* val = qs->vals[qs->head];
+	qs->head = (qs->head + 1) % qs->max;
+	qs->size--;
+	pthread_cond_signal(&qs->not_full);
+	pthread_mutex_unlock(&qs->lock);
 	return val;
 }
 
 static as_stream_status
 as_input_stream_write(const as_stream* s, as_val* val)
 {
-    if (cf_queue_push(as_stream_source(s), &val) != CF_QUEUE_OK) {
-        as_log_error("Write to client side stream failed.");
-        as_val_destroy(val);
-        return AS_STREAM_ERR;
-    }
-    return AS_STREAM_OK;
+	as_query_stream* qs = as_stream_source(s);
+
+	pthread_mutex_lock(&qs->lock);
+
+	// Apply backpressure when the reader falls behind.
+	while (qs->capacity && qs->size >= qs->capacity && !qs->closed) {
+		pthread_cond_wait(&qs->not_full, &qs->lock);
+	}
+
+	if (qs->closed) {
+		// Reader has finished or failed. Abort writer.
+		pthread_mutex_unlock(&qs->lock);
+		as_val_destroy(val);
+		return AS_STREAM_ERR;
+	}
+
+	if (qs->size == qs->max) {
+		// Unbounded queue is full. Double size.
+		uint32_t max = qs->max * 2;
+		as_val** vals = cf_malloc(sizeof(as_val*) * max);
+
+		for (uint32_t i = 0; i < qs->size; i++) {
+			vals[i] = qs->vals[(qs->head + i) % qs->max];
+		}
+		cf_free(qs->vals);
+		qs->vals = vals;
+		qs->max = max;
+		qs->head = 0;
+	}
+
+	qs->vals[(qs->head + qs->size) % qs->max] = val;
+	qs->size++;
+	pthread_cond_signal(&qs->not_empty);
+	pthread_mutex_unlock(&qs->lock);
+	return AS_STREAM_OK;
 }
 
 static const as_stream_hooks input_stream_hooks = {
@@ -224,6 +287,47 @@ static const as_stream_hooks input_stream_hooks = {
     .write    = as_input_stream_write
 };
 
+static void
+as_query_stream_init(as_query_stream* qs, uint32_t capacity)
+{
+	as_stream_init(&qs->stream, qs, &input_stream_hooks);
+	pthread_mutex_init(&qs->lock, NULL);
+	pthread_cond_init(&qs->not_empty, NULL);
+	pthread_cond_init(&qs->not_full, NULL);
+	qs->capacity = capacity;
+	qs->max = capacity ? capacity : 256;
+	qs->vals = cf_malloc(sizeof(as_val*) * qs->max);
+	qs->head = 0;
+	qs->size = 0;
+	qs->closed = false;
+}
+
+static void
+as_query_stream_close(as_query_stream* qs)
+{
+	pthread_mutex_lock(&qs->lock);
+	qs->closed = true;
+	pthread_cond_broadcast(&qs->not_full);
+	pthread_mutex_unlock(&qs->lock);
+}
+
+static void
+as_query_stream_destroy(as_query_stream* qs)
+{
+	// Empty input queue.
+	for (uint32_t i = 0; i < qs->size; i++) {
+		as_val* val = qs->vals[(qs->head + i) % qs->max];
+
+		if (val) {
+			as_val_destroy(val);
+		}
+	}
+	cf_free(qs->vals);
+	pthread_cond_destroy(&qs->not_full);
+	pthread_cond_destroy(&qs->not_empty);
+	pthread_mutex_destroy(&qs->lock);
+}
+
 // This callback will populate an intermediate stream, to be used for the aggregation.
 static bool
 as_query_aggregate_callback(const as_val* v, void* udata)
@@ -345,7 +449,7 @@ as_query_parse_record_async(
 	*pp = as_command_parse_key(*pp, msg->n_fields, &rec.key, &bval);
 
 	as_status status = as_command_parse_bins(pp, err, &rec, msg->n_ops,
-		qc->command.flags & AS_ASYNC_FLAGS_DESERIALIZE);
+		qc->command.flags & AS_ASYNC_FLAGS_DESERIALIZE, qe->borrow_bytes);
 
 	if (status != AEROSPIKE_OK) {
 		as_record_destroy(&rec);
@@ -482,7 +586,8 @@ as_query_parse_record(uint8_t** pp, as_msg* msg, as_query_task* task, as_error*
 		uint64_t bval = 0;
 		*pp = as_command_parse_key(*pp, msg->n_fields, &rec.key, &bval);
 
-		as_status status = as_command_parse_bins(pp, err, &rec, msg->n_ops, task->query_policy->deserialize);
+		as_status status = as_command_parse_bins(pp, err, &rec, msg->n_ops,
+			task->query_policy->deserialize, task->query_policy->borrow_bytes);
 
 		if (status != AEROSPIKE_OK) {
 			as_record_destroy(&rec);
@@ -1366,6 +1471,11 @@ as_query_worker_old(void* data)
 		complete_task.result = AEROSPIKE_ERR_QUERY_ABORTED;
 	}
 
+	if (task->node_queues) {
+		// Signal end of this node's aggregation stream.
+		task->callback(NULL, task->udata);
+	}
+
 	cf_queue_push(task->complete_q, &complete_task);
 }
 
@@ -1447,6 +1557,12 @@ as_query_execute(as_query_task* task, const as_query* query, as_nodes* nodes)
 		as_query_task* task_node = alloca(sizeof(as_query_task));
 		memcpy(task_node, task, sizeof(as_query_task));
 		task_node->node = nodes->array[i];
+
+		if (task->node_queues) {
+			// Each node has its own aggregation stream.
+			task_node->input_queue = &task->node_queues[i];
+			task_node->udata = &task->node_queues[i].stream;
+		}
 		
 		// If the thread pool size is > 0 farm out the tasks to the pool, otherwise run in current thread.
 		if (thread_pool_size > 0) {
@@ -1488,7 +1604,13 @@ as_query_execute(as_query_task* task, const as_query* query, as_nodes* nodes)
 	}
 	
 	// Make the callback that signals completion.
-	if (task->callback) {
+	if (task->node_queues) {
+		// Node workers signal end of their own stream. Signal streams of nodes that were not run.
+		for (uint32_t i = n_wait_nodes; i < nodes->size; i++) {
+			task->callback(NULL, &task->node_queues[i].stream);
+		}
+	}
+	else if (task->callback) {
 		task->callback(NULL, task->udata);
 	}
 	
@@ -1516,16 +1638,11 @@ as_query_aggregate(void* data)
 		.timer = NULL
 	};
 
-	// The callback stream provides the ability to write to a user callback function
-	// when as_stream_write is called.
-	as_stream output_stream;
-	as_stream_init(&output_stream, task->callback_data, &output_stream_hooks);
-	
 	// Apply the UDF to the result stream
 	as_result res;
 	as_result_init(&res);
-	
-	as_status status = as_module_apply_stream(&mod_lua, &ctx, query->apply.module, query->apply.function, task->input_stream, query->apply.arglist, &output_stream, &res);
+
+	as_status status = as_module_apply_stream(&mod_lua, &ctx, query->apply.module, query->apply.function, &task->input->stream, query->apply.arglist, task->output, &res);
 	
 	if (status) {
 		// Aggregation failed. Abort entire query.
@@ -1553,6 +1670,14 @@ as_query_aggregate(void* data)
 		}
 	}
 	as_result_destroy(&res);
+
+	// Release node threads that are blocked writing to a full input queue.
+	as_query_stream_close(task->input);
+
+	if (task->combine && as_faa_uint32(task->remaining, -1) == 1) {
+		// Last node aggregation signals end of the combine stream.
+		as_stream_write(&task->combine->stream, NULL);
+	}
 	cf_queue_push(task->complete_q, &status);
 }
 
@@ -1596,6 +1721,7 @@ as_query_partitions(
 			.err = err,
 			.error_mutex = &error_mutex,
 			.input_queue = NULL,
+			.node_queues = NULL,
 			.complete_q = NULL,
 			.task_id = task_id,
 			.cluster_key = 0,
@@ -1917,6 +2043,7 @@ as_query_partition_async(
 	qe->info_timeout = policy->info_timeout;
 	qe->n_fields = qb.n_fields;
 	qe->deserialize = policy->deserialize;
+	qe->borrow_bytes = policy->borrow_bytes;
 	qe->has_where = query->where.size > 0;
 
 	uint32_t n_nodes = pt->node_parts.size;
@@ -1935,6 +2062,7 @@ as_query_partition_async(
 	ee->count = 0;
 	ee->queued = 0;
 	ee->notify = true;
+	ee->notify_cancel = false;
 	ee->valid = true;
 
 	return as_query_partition_execute_async(qe, pt, err);
@@ -1956,6 +2084,7 @@ as_query_partition_retry_async(as_async_query_executor* qe_old, as_error* err)
 	qe->info_timeout = qe_old->info_timeout;
 	qe->n_fields = qe_old->n_fields;
 	qe->deserialize = qe_old->deserialize;
+	qe->borrow_bytes = qe_old->borrow_bytes;
 	qe->has_where = qe_old->has_where;
 
 	// Must change task_id each round. Otherwise, server rejects command.
@@ -1981,6 +2110,7 @@ as_query_partition_retry_async(as_async_query_executor* qe_old, as_error* err)
 	ee->count = 0;
 	ee->queued = 0;
 	ee->notify = true;
+	ee->notify_cancel = false;
 	ee->valid = true;
 	as_cluster_add_retry(qe->cluster);
 
@@ -1997,6 +2127,7 @@ convert_query_to_scan(
 	memcpy(&scan_policy->base, &query_policy->base, sizeof(as_policy_base));
 	scan_policy->max_records = query->max_records;
 	scan_policy->records_per_second = query->records_per_second;
+	scan_policy->borrow_bytes = query_policy->borrow_bytes;
 
 	as_scan_init(scan, query->ns, query->set);
 	scan->select.entries = query->select.entries;
@@ -2054,6 +2185,10 @@ as_policy_query_merge(aerospike* as, const as_policy_query* src, as_policy_query
 		mrg->base.error_detail_verbosity = src->base.error_detail_verbosity;
 		mrg->fail_on_cluster_change = src->fail_on_cluster_change;
 		mrg->deserialize = src->deserialize;
+		mrg->aggregate_queue_capacity = src->aggregate_queue_capacity;
+		mrg->borrow_bytes = src->borrow_bytes;
+		mrg->aggregate_parallel = src->aggregate_parallel;
+		mrg->record_queue_size = src->record_queue_size;
 		mrg->short_query = src->short_query;
 		return mrg;
 	}
@@ -2158,6 +2293,7 @@ aerospike_query_foreach(
 		.err = err,
 		.error_mutex = &error_mutex,
 		.input_queue = NULL,
+		.node_queues = NULL,
 		.complete_q = NULL,
 		.task_id = task_id,
 		.cluster_key = 0,
@@ -2169,59 +2305,123 @@ aerospike_query_foreach(
 		
 	if (query->apply.function[0]) {
 		// Query with aggregation.
-		task.input_queue = cf_queue_create(sizeof(void*), true);
-		
-		// Stream for results from each node
-		as_stream input_stream;
-		as_stream_init(&input_stream, task.input_queue, &input_stream_hooks);
-		
-		task.callback = as_query_aggregate_callback;
-		task.udata = &input_stream;
-		
+		uint32_t capacity = policy->aggregate_queue_capacity;
+		uint32_t n_nodes = nodes->size;
+		bool parallel = policy->aggregate_parallel && n_nodes > 1 &&
+			cluster->thread_pool.thread_size >= n_nodes * 2 + 1;
+
+		// The callback stream provides the ability to write to a user callback function
+		// when as_stream_write is called.
 		as_query_user_callback callback_data;
 		callback_data.callback = callback;
 		callback_data.udata = udata;
 
-		as_query_task_aggr task_aggr;
-		task_aggr.query = query;
-		task_aggr.input_stream = &input_stream;
-		task_aggr.callback_data = &callback_data;
-		task_aggr.error_mutex = &error_mutex;
-		task_aggr.err = err;
-		task_aggr.complete_q = cf_queue_create(sizeof(as_status), true);
-		
-		// Run lua aggregation in separate thread.
-		int rc = as_thread_pool_queue_task(&cluster->thread_pool, as_query_aggregate, &task_aggr);
-		
+		as_stream output_stream;
+		as_stream_init(&output_stream, &callback_data, &output_stream_hooks);
+
+		// Stream for results from each node, or combined results of each node in parallel mode.
+		as_query_stream input;
+		as_query_stream_init(&input, capacity);
+
+		uint32_t n_aggr = parallel ? n_nodes + 1 : 1;
+		as_query_task_aggr* tasks_aggr = cf_malloc(sizeof(as_query_task_aggr) * n_aggr);
+		uint32_t remaining = n_nodes;
+		cf_queue* complete_q = cf_queue_create(sizeof(as_status), true);
+
+		tasks_aggr[0].query = query;
+		tasks_aggr[0].input = &input;
+		tasks_aggr[0].output = &output_stream;
+		tasks_aggr[0].combine = NULL;
+		tasks_aggr[0].remaining = NULL;
+		tasks_aggr[0].error_mutex = &error_mutex;
+		tasks_aggr[0].err = err;
+		tasks_aggr[0].complete_q = complete_q;
+
+		task.callback = as_query_aggregate_callback;
+
+		if (parallel) {
+			// Run client side aggregation of each node's results in a separate Lua state.
+			// Node outputs are written to the input stream of the final aggregation.
+			task.node_queues = cf_malloc(sizeof(as_query_stream) * n_nodes);
+			task.input_queue = task.node_queues;
+			task.udata = NULL;
+
+			for (uint32_t i = 0; i < n_nodes; i++) {
+				as_query_stream_init(&task.node_queues[i], capacity);
+
+				as_query_task_aggr* ta = &tasks_aggr[i + 1];
+				ta->query = query;
+				ta->input = &task.node_queues[i];
+				ta->output = &input.stream;
+				ta->combine = &input;
+				ta->remaining = &remaining;
+				ta->error_mutex = &error_mutex;
+				ta->err = err;
+				ta->complete_q = complete_q;
+			}
+		}
+		else {
+			task.input_queue = &input;
+			task.udata = &input.stream;
+		}
+
+		// Run lua aggregation in separate threads.
+		uint32_t n_wait = 0;
+		int rc = 0;
+
+		for (uint32_t i = 0; i < n_aggr; i++) {
+			rc = as_thread_pool_queue_task(&cluster->thread_pool, as_query_aggregate, &tasks_aggr[i]);
+
+			if (rc) {
+				break;
+			}
+			n_wait++;
+		}
+
 		if (rc == 0) {
 			status = as_query_execute(&task, query, nodes);
-			
-			// Wait for aggregation thread to finish.
+		}
+		else {
+			status = as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add aggregate thread: %d", rc);
+
+			// Release aggregation threads that were started.
+			if (parallel) {
+				for (uint32_t i = 0; i < n_nodes; i++) {
+					as_stream_write(&task.node_queues[i].stream, NULL);
+				}
+
+				// The combine stream is only ended by node aggregation threads.
+				if (n_wait <= n_nodes) {
+					as_stream_write(&input.stream, NULL);
+				}
+			}
+		}
+
+		// Wait for aggregation threads to finish.
+		for (uint32_t i = 0; i < n_wait; i++) {
 			as_status complete_status = AEROSPIKE_OK;
-			cf_queue_pop(task_aggr.complete_q, &complete_status, CF_QUEUE_FOREVER);
-			
+			cf_queue_pop(complete_q, &complete_status, CF_QUEUE_FOREVER);
+
 			if (complete_status != AEROSPIKE_OK && status == AEROSPIKE_OK) {
 				status = complete_status;
 			}
 		}
-		else {
-			status = as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add aggregate thread: %d", rc);
-		}
-			
-		cf_queue_destroy(task_aggr.complete_q);
-		
-		// Empty input queue.
-		as_val* val = NULL;
-		while (cf_queue_pop(task.input_queue, &val, CF_QUEUE_NOWAIT) == CF_QUEUE_OK) {
-			as_val_destroy(val);
+		cf_queue_destroy(complete_q);
+
+		if (parallel) {
+			for (uint32_t i = 0; i < n_nodes; i++) {
+				as_query_stream_destroy(&task.node_queues[i]);
+			}
+			cf_free(task.node_queues);
 		}
-		cf_queue_destroy(task.input_queue);
+		as_query_stream_destroy(&input);
+		cf_free(tasks_aggr);
 	}
 	else {
 		// Normal query without aggregation.
 		task.callback = callback;
 		task.udata = udata;
-		task.input_queue = 0;
+		task.input_queue = NULL;
 		status = as_query_execute(&task, query, nodes);
 	}
 
@@ -2229,6 +2429,33 @@ aerospike_query_foreach(
 	return status;
 }
 
+static as_status
+as_query_stream_run(as_record_stream* stream, as_error* err)
+{
+	return aerospike_query_foreach(stream->as, err, &stream->policy, stream->cmd,
+		as_record_stream_callback, stream);
+}
+
+as_status
+aerospike_query_stream(
+	aerospike* as, as_error* err, const as_policy_query* policy, as_query* query,
+	as_record_stream** stream
+	)
+{
+	as_error_reset(err);
+
+	if (query->apply.function[0]) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM,
+			"Aggregation queries are not supported by record streams");
+	}
+
+	as_policy_query merged;
+	policy = as_policy_query_merge(as, policy, &merged);
+
+	return as_record_stream_start(as, err, query, policy, sizeof(as_policy_query),
+		policy->record_queue_size, as_query_stream_run, stream);
+}
+
 as_status
 aerospike_query_partitions(
 	aerospike* as, as_error* err, const as_policy_query* policy, as_query* query,
@@ -2387,6 +2614,7 @@ aerospike_query_async(
 	exec->count = 0;
 	exec->queued = 0;
 	exec->notify = true;
+	exec->notify_cancel = false;
 	exec->valid = true;
 	executor->listener = listener;
 	executor->info_timeout = policy->info_timeout;
@@ -2567,6 +2795,7 @@ aerospike_query_background(
 		.err = err,
 		.error_mutex = &error_mutex,
 		.input_queue = NULL,
+		.node_queues = NULL,
 		.complete_q = NULL,
 		.task_id = task_id,
 		.cluster_key = 0,
@@ -83,6 +83,7 @@ typedef struct as_async_scan_executor {
 	uint16_t n_fields;
 	bool concurrent;
 	bool deserialize_list_map;
+	bool borrow_bytes;
 } as_async_scan_executor;
 
 typedef struct as_async_scan_command {
@@ -202,7 +203,8 @@ as_scan_parse_record_async(
 	*pp = as_command_parse_key(*pp, msg->n_fields, &rec.key, &bval);
 
 	as_status status = as_command_parse_bins(pp, err, &rec, msg->n_ops,
-											 sc->command.flags & AS_ASYNC_FLAGS_DESERIALIZE);
+											 sc->command.flags & AS_ASYNC_FLAGS_DESERIALIZE,
+											 se->borrow_bytes);
 
 	if (status != AEROSPIKE_OK) {
 		as_record_destroy(&rec);
@@ -306,7 +308,8 @@ as_scan_parse_record(uint8_t** pp, as_msg* msg, as_scan_task* task, as_error* er
 	uint64_t bval = 0;
 	*pp = as_command_parse_key(*pp, msg->n_fields, &rec.key, &bval);
 
-	as_status status = as_command_parse_bins(pp, err, &rec, msg->n_ops, task->scan->deserialize_list_map);
+	as_status status = as_command_parse_bins(pp, err, &rec, msg->n_ops,
+		task->scan->deserialize_list_map, task->policy->borrow_bytes);
 
 	if (status != AEROSPIKE_OK) {
 		as_record_destroy(&rec);
@@ -1222,6 +1225,7 @@ as_scan_partition_retry_async(as_async_scan_executor* se_old, as_error* err)
 	se->n_fields = se_old->n_fields;
 	se->concurrent = se_old->concurrent;
 	se->deserialize_list_map = se_old->deserialize_list_map;
+	se->borrow_bytes = se_old->borrow_bytes;
 
 	// Must change task_id each round. Otherwise, server rejects command.
 	uint64_t task_id = as_random_get_uint64();
@@ -1246,6 +1250,7 @@ as_scan_partition_retry_async(as_async_scan_executor* se_old, as_error* err)
 	ee->count = 0;
 	ee->queued = 0;
 	ee->notify = true;
+	ee->notify_cancel = false;
 	ee->valid = true;
 	as_cluster_add_retry(se->cluster);
 
@@ -1316,6 +1321,7 @@ as_scan_partition_async(
 	se->n_fields = sb.n_fields;
 	se->concurrent = scan->concurrent;
 	se->deserialize_list_map = scan->deserialize_list_map;
+	se->borrow_bytes = policy->borrow_bytes;
 
 	uint32_t n_nodes = pt->node_parts.size;
 
@@ -1333,6 +1339,7 @@ as_scan_partition_async(
 	ee->count = 0;
 	ee->queued = 0;
 	ee->notify = true;
+	ee->notify_cancel = false;
 	ee->valid = true;
 
 	return as_scan_partition_execute_async(se, pt, err);
@@ -1377,6 +1384,7 @@ as_policy_scan_merge(aerospike* as, const as_policy_scan* src, as_policy_scan* m
 		mrg->records_per_second = src->records_per_second;
 		mrg->ttl = src->ttl;
 		mrg->durable_delete = src->durable_delete;
+		mrg->borrow_bytes = src->borrow_bytes;
 		return mrg;
 	}
 	else {
@@ -85,7 +85,19 @@ aerospike_cluster_stats(as_cluster* cluster, as_cluster_stats* stats)
 	// cf_queue applies locks, so we are safe here.
 	stats->thread_pool_queued_tasks = cf_queue_sz(cluster->thread_pool.dispatch_queue);
 	stats->retry_count = cluster->retry_count;
+	stats->hedge_count = as_cluster_get_hedge_count(cluster);
+	stats->hedge_win_count = as_cluster_get_hedge_win_count(cluster);
+
+	if (cluster->tls_ctx) {
+		stats->tls_session_hit_count = as_load_uint64(&cluster->tls_ctx->session_hit_count);
+		stats->tls_session_miss_count = as_load_uint64(&cluster->tls_ctx->session_miss_count);
+	}
+	else {
+		stats->tls_session_hit_count = 0;
+		stats->tls_session_miss_count = 0;
+	}
 	stats->recover_queue_size = as_cluster_recover_queue_size(cluster);
+	stats->partitions_changed = as_load_uint32(&cluster->partitions_changed);
 }
 
 void
@@ -205,12 +217,32 @@ aerospike_stats_to_string(as_cluster_stats* stats)
 	as_string_builder_append_uint64(&sb, stats->retry_count);
 	as_string_builder_append_newline(&sb);
 
+	as_string_builder_append(&sb, "hedge_count: ");
+	as_string_builder_append_uint64(&sb, stats->hedge_count);
+	as_string_builder_append_newline(&sb);
+
+	as_string_builder_append(&sb, "hedge_win_count: ");
+	as_string_builder_append_uint64(&sb, stats->hedge_win_count);
+	as_string_builder_append_newline(&sb);
+
+	as_string_builder_append(&sb, "tls_session_hit_count: ");
+	as_string_builder_append_uint64(&sb, stats->tls_session_hit_count);
+	as_string_builder_append_newline(&sb);
+
+	as_string_builder_append(&sb, "tls_session_miss_count: ");
+	as_string_builder_append_uint64(&sb, stats->tls_session_miss_count);
+	as_string_builder_append_newline(&sb);
+
 	as_string_builder_append(&sb, "thread_pool_queued_tasks: ");
 	as_string_builder_append_uint(&sb, stats->thread_pool_queued_tasks);
 	as_string_builder_append_newline(&sb);
 
 	as_string_builder_append(&sb, "recover_queue_size: ");
 	as_string_builder_append_uint(&sb, stats->recover_queue_size);
+	as_string_builder_append_newline(&sb);
+
+	as_string_builder_append(&sb, "partitions_changed: ");
+	as_string_builder_append_uint(&sb, stats->partitions_changed);
 
 	return sb.data;
 }
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/as_buffer_pool.h>
+#include <citrusleaf/alloc.h>
+#include <pthread.h>
+#include <string.h>
+
+//---------------------------------
+// Globals
+//---------------------------------
+
+static pthread_once_t as_buffer_pool_once = PTHREAD_ONCE_INIT;
+static pthread_key_t as_buffer_pool_key;
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static inline uint32_t
+as_buffer_pool_class_index(size_t size)
+{
+	uint32_t index = 0;
+	size_t class_size = (size_t)1 << AS_BUFFER_POOL_MIN_SHIFT;
+
+	while (class_size < size && index < AS_BUFFER_POOL_CLASSES) {
+		class_size <<= 1;
+		index++;
+	}
+	return index;
+}
+
+static inline size_t
+as_buffer_pool_class_size(uint32_t index)
+{
+	return (size_t)1 << (AS_BUFFER_POOL_MIN_SHIFT + index);
+}
+
+static void
+as_buffer_pool_trim(as_buffer_pool* pool)
+{
+	for (uint32_t i = 0; i < AS_BUFFER_POOL_CLASSES; i++) {
+		as_buffer_pool_class* c = &pool->classes[i];
+
+		// Keep enough cached buffers to cover the high-water mark since the last trim.
+		uint32_t keep = (c->high_water > c->in_use)? c->high_water - c->in_use : 0;
+
+		while (c->size > keep) {
+			cf_free(c->buffers[--c->size]);
+			pool->cached_bytes -= as_buffer_pool_class_size(i);
+		}
+		c->high_water = c->in_use;
+	}
+}
+
+static void
+as_buffer_pool_trim_idle(as_buffer_pool* pool)
+{
+	// Release the largest cached buffers first, because they are the least likely to be reused.
+	uint32_t i = AS_BUFFER_POOL_CLASSES;
+
+	while (i > 0 && pool->cached_bytes > AS_BUFFER_POOL_IDLE_BYTES) {
+		as_buffer_pool_class* c = &pool->classes[--i];
+		size_t class_size = as_buffer_pool_class_size(i);
+
+		while (c->size > 0 && pool->cached_bytes > AS_BUFFER_POOL_IDLE_BYTES) {
+			cf_free(c->buffers[--c->size]);
+			pool->cached_bytes -= class_size;
+		}
+	}
+}
+
+static inline void
+as_buffer_pool_tick(as_buffer_pool* pool)
+{
+	if (++pool->ops >= AS_BUFFER_POOL_TRIM_INTERVAL) {
+		as_buffer_pool_trim(pool);
+		pool->ops = 0;
+	}
+}
+
+static void
+as_buffer_pool_thread_destroy(void* udata)
+{
+	as_buffer_pool* pool = udata;
+	as_buffer_pool_destroy(pool);
+	cf_free(pool);
+}
+
+static void
+as_buffer_pool_key_create(void)
+{
+	pthread_key_create(&as_buffer_pool_key, as_buffer_pool_thread_destroy);
+}
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+void
+as_buffer_pool_init(as_buffer_pool* pool)
+{
+	memset(pool, 0, sizeof(as_buffer_pool));
+}
+
+void
+as_buffer_pool_destroy(as_buffer_pool* pool)
+{
+	for (uint32_t i = 0; i < AS_BUFFER_POOL_CLASSES; i++) {
+		as_buffer_pool_class* c = &pool->classes[i];
+
+		for (uint32_t j = 0; j < c->size; j++) {
+			cf_free(c->buffers[j]);
+		}
+		c->size = 0;
+	}
+	pool->cached_bytes = 0;
+}
+
+uint8_t*
+as_buffer_pool_get(as_buffer_pool* pool, size_t size, size_t* capacity)
+{
+	uint32_t index = as_buffer_pool_class_index(size);
+
+	if (index >= AS_BUFFER_POOL_CLASSES) {
+		// Too large to cache.
+		if (capacity) {
+			*capacity = size;
+		}
+		return cf_malloc(size);
+	}
+
+	as_buffer_pool_tick(pool);
+
+	as_buffer_pool_class* c = &pool->classes[index];
+	size_t class_size = as_buffer_pool_class_size(index);
+	uint8_t* buf;
+
+	if (c->size > 0) {
+		buf = c->buffers[--c->size];
+		pool->cached_bytes -= class_size;
+	}
+	else {
+		buf = cf_malloc(class_size);
+	}
+
+	if (++c->in_use > c->high_water) {
+		c->high_water = c->in_use;
+	}
+	pool->in_use++;
+
+	if (capacity) {
+		*capacity = class_size;
+	}
+	return buf;
+}
+
+void
+as_buffer_pool_put(as_buffer_pool* pool, uint8_t* buf, size_t size)
+{
+	uint32_t index = as_buffer_pool_class_index(size);
+
+	if (index >= AS_BUFFER_POOL_CLASSES) {
+		cf_free(buf);
+		return;
+	}
+
+	as_buffer_pool_tick(pool);
+
+	as_buffer_pool_class* c = &pool->classes[index];
+	size_t class_size = as_buffer_pool_class_size(index);
+
+	if (c->in_use > 0) {
+		c->in_use--;
+	}
+
+	if (pool->in_use > 0) {
+		pool->in_use--;
+	}
+
+	if (c->size < AS_BUFFER_POOL_CLASS_CAPACITY &&
+		pool->cached_bytes + class_size <= AS_BUFFER_POOL_MAX_BYTES) {
+		c->buffers[c->size++] = buf;
+		pool->cached_bytes += class_size;
+	}
+	else {
+		cf_free(buf);
+	}
+
+	if (pool->in_use == 0) {
+		as_buffer_pool_trim_idle(pool);
+	}
+}
+
+as_buffer_pool*
+as_buffer_pool_thread(void)
+{
+	pthread_once(&as_buffer_pool_once, as_buffer_pool_key_create);
+
+	as_buffer_pool* pool = pthread_getspecific(as_buffer_pool_key);
+
+	if (!pool) {
+		pool = cf_malloc(sizeof(as_buffer_pool));
+		as_buffer_pool_init(pool);
+		pthread_setspecific(as_buffer_pool_key, pool);
+	}
+	return pool;
+}
@@ -38,6 +38,7 @@
 #include <citrusleaf/alloc.h>
 #include <citrusleaf/cf_byte_order.h>
 #include <citrusleaf/cf_clock.h>
+#include <citrusleaf/cf_queue.h>
 
 //---------------------------------
 // Globals
@@ -63,6 +64,27 @@ as_node_refresh_partitions(as_cluster* cluster, as_error* err, as_node* node);
 as_status
 as_node_refresh_racks(as_cluster* cluster, as_error* err, as_node* node);
 
+as_status
+as_node_fetch_peers(as_cluster* cluster, as_error* err, as_node* node, char** response);
+
+as_status
+as_node_apply_peers(as_cluster* cluster, as_error* err, as_node* node, char* response, as_peers* peers);
+
+as_status
+as_node_fetch_partitions(as_cluster* cluster, as_error* err, as_node* node, char** response);
+
+as_status
+as_node_apply_partitions(as_cluster* cluster, as_error* err, as_node* node, char* response);
+
+as_status
+as_node_fetch_racks(as_cluster* cluster, as_error* err, as_node* node, char** response);
+
+as_status
+as_node_apply_racks(as_cluster* cluster, as_error* err, as_node* node, char* response);
+
+void
+as_node_restart(as_cluster* cluster, as_node* node);
+
 void
 as_event_balance_connections(as_cluster* cluster);
 
@@ -623,6 +645,7 @@ as_cluster_enable_metrics(as_error* err, as_cluster* cluster, const as_metrics_p
 	cluster->metrics_interval = policy->interval;
 	cluster->metrics_latency_columns = policy->latency_columns;
 	cluster->metrics_latency_shift = policy->latency_shift;
+	cluster->metrics_latency_micros = policy->latency_micros;
 
 	as_nodes* nodes = as_nodes_reserve(cluster);
 	
@@ -765,6 +788,16 @@ as_cluster_reset_error_rate(as_cluster* cluster)
 	}
 }
 
+static void
+as_cluster_decay_replica_latency(as_cluster* cluster)
+{
+	as_nodes* nodes = cluster->nodes;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node_decay_replica_latency(nodes->array[i]);
+	}
+}
+
 static void
 as_cluster_tend_recover_queue(as_cluster* cluster)
 {
@@ -813,6 +846,7 @@ as_cluster_manage(as_cluster* cluster)
 		as_cluster_reset_error_rate(cluster);
 	}
 
+	as_cluster_decay_replica_latency(cluster);
 	as_cluster_tend_recover_queue(cluster);
 
 	// Call metrics listener every metrics_interval when enabled.
@@ -897,6 +931,392 @@ as_cluster_init_error(as_vector* invalid_hosts, as_error* err)
 	return err->code;
 }
 
+static inline void
+as_cluster_restart_node(as_cluster* cluster, as_node* node)
+{
+	// Node restart handling balances connection pools, which is only done in the tend thread.
+	if (node->restarted) {
+		node->restarted = false;
+		as_node_restart(cluster, node);
+	}
+}
+
+static void
+as_cluster_tend_nodes(as_cluster* cluster, as_nodes* nodes, as_peers* peers)
+{
+	as_error error_local;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+
+		if (node->active) {
+			as_status status = as_node_refresh(cluster, &error_local, node, peers);
+
+			as_cluster_restart_node(cluster, node);
+
+			if (status != AEROSPIKE_OK) {
+				// Use info level so aql doesn't see message by default.
+				as_log_info("Node %s refresh failed: %s %s",
+					node->name, as_error_string(status), error_local.message);
+				peers->gen_changed = true;
+				as_cluster_node_failure(node);
+			}
+		}
+	}
+}
+
+static void
+as_cluster_tend_peers(as_cluster* cluster, as_nodes* nodes, as_peers* peers)
+{
+	as_error error_local;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+
+		if (node->failures == 0 && node->active) {
+			as_status status = as_node_refresh_peers(cluster, &error_local, node, peers);
+
+			if (status != AEROSPIKE_OK) {
+				as_log_warn("Node %s peers refresh failed: %s %s",
+					node->name, as_error_string(status), error_local.message);
+				as_cluster_node_failure(node);
+			}
+		}
+	}
+}
+
+static inline bool
+as_cluster_partitions_needed(as_node* node, as_peers* peers)
+{
+	// Avoid "split cluster" case where this node thinks it's a 1-node cluster.
+	// Unchecked, such a node can dominate the partition map and cause all other
+	// nodes to be dropped.
+	return node->partition_changed && node->failures == 0 && node->active &&
+		(node->peers_count > 0 || peers->refresh_count == 1);
+}
+
+static inline bool
+as_cluster_racks_needed(as_node* node)
+{
+	return node->rebalance_changed && node->failures == 0 && node->active;
+}
+
+static bool
+as_cluster_tend_partitions(as_cluster* cluster, as_nodes* nodes, as_peers* peers)
+{
+	as_error error_local;
+	bool rebalance = false;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+
+		if (as_cluster_partitions_needed(node, peers)) {
+			as_status status = as_node_refresh_partitions(cluster, &error_local, node);
+
+			if (status != AEROSPIKE_OK) {
+				as_log_warn("Node %s partition refresh failed: %s %s",
+							node->name, as_error_string(status), error_local.message);
+				as_cluster_node_failure(node);
+			}
+		}
+
+		if (as_cluster_racks_needed(node)) {
+			as_status status = as_node_refresh_racks(cluster, &error_local, node);
+
+			if (status == AEROSPIKE_OK) {
+				if (cluster->shm_info && node->racks && node->racks->size > 0) {
+					rebalance = true;
+				}
+			}
+			else {
+				as_log_warn("Node %s rack refresh failed: %s %s",
+							node->name, as_error_string(status), error_local.message);
+				as_cluster_node_failure(node);
+			}
+		}
+	}
+	return rebalance;
+}
+
+//---------------------------------
+// Parallel Tend
+//---------------------------------
+
+typedef enum {
+	AS_TEND_NODE,
+	AS_TEND_PEERS,
+	AS_TEND_PARTITIONS
+} as_tend_type;
+
+/**
+ * Per node tend request. Info requests are sent from the tend thread pool and
+ * responses are applied by the tend thread after all requests complete.
+ */
+typedef struct {
+	as_cluster* cluster;
+	as_node* node;
+	cf_queue* complete_q;
+	char* peers;
+	char* partitions;
+	char* racks;
+	as_error err;
+	as_status status;
+	uint32_t refresh_count;
+	as_tend_type type;
+	bool gen_changed;
+	bool fetch_partitions;
+	bool fetch_racks;
+} as_tend_task;
+
+static void
+as_tend_task_run(as_tend_task* task)
+{
+	as_cluster* cluster = task->cluster;
+	as_node* node = task->node;
+
+	switch (task->type) {
+		case AS_TEND_NODE: {
+			// as_node_refresh() only updates peers generation flag and refresh count,
+			// so collect them per node and merge after all nodes have been refreshed.
+			as_peers peers;
+			memset(&peers, 0, sizeof(as_peers));
+			task->status = as_node_refresh(cluster, &task->err, node, &peers);
+			task->gen_changed = peers.gen_changed;
+			task->refresh_count = peers.refresh_count;
+			break;
+		}
+
+		case AS_TEND_PEERS:
+			task->status = as_node_fetch_peers(cluster, &task->err, node, &task->peers);
+			break;
+
+		case AS_TEND_PARTITIONS:
+			task->status = AEROSPIKE_OK;
+
+			if (task->fetch_partitions) {
+				task->status = as_node_fetch_partitions(cluster, &task->err, node,
+					&task->partitions);
+			}
+
+			if (task->status == AEROSPIKE_OK && task->fetch_racks) {
+				task->status = as_node_fetch_racks(cluster, &task->err, node, &task->racks);
+			}
+			break;
+	}
+}
+
+static void
+as_tend_worker(void* data)
+{
+	as_tend_task* task = data;
+	as_tend_task_run(task);
+	cf_queue_push(task->complete_q, &task);
+}
+
+static void
+as_cluster_tend_run(as_cluster* cluster, as_tend_task* tasks, uint32_t n_tasks)
+{
+	if (n_tasks == 1) {
+		as_tend_task_run(&tasks[0]);
+		return;
+	}
+
+	cf_queue* complete_q = cf_queue_create(sizeof(as_tend_task*), true);
+	uint32_t n_wait = 0;
+
+	for (uint32_t i = 0; i < n_tasks; i++) {
+		as_tend_task* task = &tasks[i];
+		task->complete_q = complete_q;
+
+		int rc = as_thread_pool_queue_task(&cluster->tend_thread_pool, as_tend_worker, task);
+
+		if (rc == 0) {
+			n_wait++;
+		}
+		else {
+			// Thread could not be added. Run in tend thread.
+			as_tend_task_run(task);
+		}
+	}
+
+	// Wait for tasks to complete.
+	for (uint32_t i = 0; i < n_wait; i++) {
+		as_tend_task* task;
+		cf_queue_pop(complete_q, &task, CF_QUEUE_FOREVER);
+	}
+	cf_queue_destroy(complete_q);
+}
+
+static inline as_tend_task*
+as_tend_task_add(as_tend_task* tasks, uint32_t* n_tasks, as_cluster* cluster, as_node* node,
+	as_tend_type type)
+{
+	as_tend_task* task = &tasks[(*n_tasks)++];
+	task->cluster = cluster;
+	task->node = node;
+	task->complete_q = NULL;
+	task->peers = NULL;
+	task->partitions = NULL;
+	task->racks = NULL;
+	task->status = AEROSPIKE_OK;
+	task->type = type;
+	task->refresh_count = 0;
+	task->gen_changed = false;
+	task->fetch_partitions = false;
+	task->fetch_racks = false;
+	return task;
+}
+
+static void
+as_cluster_tend_nodes_parallel(as_cluster* cluster, as_nodes* nodes, as_peers* peers)
+{
+	as_tend_task* tasks = cf_malloc(sizeof(as_tend_task) * nodes->size);
+	uint32_t n_tasks = 0;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+
+		if (node->active) {
+			as_tend_task_add(tasks, &n_tasks, cluster, node, AS_TEND_NODE);
+		}
+	}
+
+	if (n_tasks > 0) {
+		as_cluster_tend_run(cluster, tasks, n_tasks);
+	}
+
+	// Merge results in node order.
+	for (uint32_t i = 0; i < n_tasks; i++) {
+		as_tend_task* task = &tasks[i];
+
+		as_cluster_restart_node(cluster, task->node);
+
+		if (task->status == AEROSPIKE_OK) {
+			peers->refresh_count += task->refresh_count;
+
+			if (task->gen_changed) {
+				peers->gen_changed = true;
+			}
+		}
+		else {
+			// Use info level so aql doesn't see message by default.
+			as_log_info("Node %s refresh failed: %s %s",
+				task->node->name, as_error_string(task->status), task->err.message);
+			peers->gen_changed = true;
+			as_cluster_node_failure(task->node);
+		}
+	}
+	cf_free(tasks);
+}
+
+static void
+as_cluster_tend_peers_parallel(as_cluster* cluster, as_nodes* nodes, as_peers* peers)
+{
+	as_tend_task* tasks = cf_malloc(sizeof(as_tend_task) * nodes->size);
+	uint32_t n_tasks = 0;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+
+		if (node->failures == 0 && node->active) {
+			as_tend_task_add(tasks, &n_tasks, cluster, node, AS_TEND_PEERS);
+		}
+	}
+
+	if (n_tasks > 0) {
+		as_cluster_tend_run(cluster, tasks, n_tasks);
+	}
+
+	// Parse peers in the tend thread because new peers are added to shared peers vectors.
+	for (uint32_t i = 0; i < n_tasks; i++) {
+		as_tend_task* task = &tasks[i];
+
+		if (task->status == AEROSPIKE_OK) {
+			task->status = as_node_apply_peers(cluster, &task->err, task->node, task->peers,
+				peers);
+			cf_free(task->peers);
+		}
+
+		if (task->status != AEROSPIKE_OK) {
+			as_log_warn("Node %s peers refresh failed: %s %s",
+				task->node->name, as_error_string(task->status), task->err.message);
+			as_cluster_node_failure(task->node);
+		}
+	}
+	cf_free(tasks);
+}
+
+static bool
+as_cluster_tend_partitions_parallel(as_cluster* cluster, as_nodes* nodes, as_peers* peers)
+{
+	as_tend_task* tasks = cf_malloc(sizeof(as_tend_task) * nodes->size);
+	uint32_t n_tasks = 0;
+	bool rebalance = false;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+		bool fetch_partitions = as_cluster_partitions_needed(node, peers);
+		bool fetch_racks = as_cluster_racks_needed(node);
+
+		if (fetch_partitions || fetch_racks) {
+			as_tend_task* task = as_tend_task_add(tasks, &n_tasks, cluster, node,
+				AS_TEND_PARTITIONS);
+			task->fetch_partitions = fetch_partitions;
+			task->fetch_racks = fetch_racks;
+		}
+	}
+
+	if (n_tasks > 0) {
+		as_cluster_tend_run(cluster, tasks, n_tasks);
+	}
+
+	// Apply partition map and rack updates in one step after all nodes have responded.
+	for (uint32_t i = 0; i < n_tasks; i++) {
+		as_tend_task* task = &tasks[i];
+		as_node* node = task->node;
+
+		if (task->fetch_partitions) {
+			if (task->partitions) {
+				as_status status = as_node_apply_partitions(cluster, &task->err, node,
+					task->partitions);
+				cf_free(task->partitions);
+
+				if (status != AEROSPIKE_OK) {
+					task->status = status;
+				}
+			}
+
+			if (task->status != AEROSPIKE_OK) {
+				as_log_warn("Node %s partition refresh failed: %s %s",
+							node->name, as_error_string(task->status), task->err.message);
+				as_cluster_node_failure(node);
+				cf_free(task->racks);
+				continue;
+			}
+		}
+
+		if (task->fetch_racks) {
+			if (task->racks) {
+				task->status = as_node_apply_racks(cluster, &task->err, node, task->racks);
+				cf_free(task->racks);
+			}
+
+			if (task->status == AEROSPIKE_OK) {
+				if (cluster->shm_info && node->racks && node->racks->size > 0) {
+					rebalance = true;
+				}
+			}
+			else {
+				as_log_warn("Node %s rack refresh failed: %s %s",
+							node->name, as_error_string(task->status), task->err.message);
+				as_cluster_node_failure(node);
+			}
+		}
+	}
+	cf_free(tasks);
+	return rebalance;
+}
+
 /**
  * Check health of all nodes in the cluster.
  */
@@ -911,28 +1331,29 @@ as_cluster_tend(as_cluster* cluster, as_error* err, bool is_init)
 	as_cluster_gc(cluster->gc);
 
 	// Initialize tend iteration node statistics.
-	as_error error_local;
 	as_peers peers;
 	as_vector_inita(&peers.nodes, sizeof(as_node*), 16);
 	as_vector_inita(&peers.nodes_to_remove, sizeof(as_node*), 8);
 	as_vector_inita(&peers.invalid_hosts, sizeof(as_host), 4);
 	peers.refresh_count = 0;
 	peers.gen_changed = false;
+	cluster->tend_partitions_changed = 0;
 
 	as_nodes* nodes = cluster->nodes;
-	bool rebalance = false;
-	
+	bool parallel = cluster->tend_thread_pool_size > 0;
+	bool rebalance;
+
 	for (uint32_t i = 0; i < nodes->size; i++) {
 		as_node* node = nodes->array[i];
 		node->friends = 0;
 		node->partition_changed = false;
 		node->rebalance_changed = false;
 	}
-	
+
 	// If active nodes don't exist, seed cluster.
 	if (nodes->size == 0) {
 		as_status status = as_cluster_seed_node(cluster, err, &peers, is_init);
-		
+
 		if (status != AEROSPIKE_OK) {
 			as_cluster_destroy_peers(&peers);
 			return status;
@@ -952,7 +1373,7 @@ as_cluster_tend(as_cluster* cluster, as_error* err, bool is_init)
 		// Retrieve fixed number of partitions only once from any node.
 		if (cluster->n_partitions == 0) {
 			as_status status = as_cluster_set_partition_size(cluster, err);
-			
+
 			if (status != AEROSPIKE_OK) {
 				as_cluster_destroy_peers(&peers);
 				return status;
@@ -963,7 +1384,7 @@ as_cluster_tend(as_cluster* cluster, as_error* err, bool is_init)
 		// Retrieve fixed number of partitions only once from any node.
 		if (cluster->n_partitions == 0) {
 			as_status status = as_cluster_set_partition_size(cluster, err);
-			
+
 			if (status != AEROSPIKE_OK) {
 				as_cluster_destroy_peers(&peers);
 				return status;
@@ -971,20 +1392,11 @@ as_cluster_tend(as_cluster* cluster, as_error* err, bool is_init)
 		}
 
 		// Refresh all known nodes.
-		for (uint32_t i = 0; i < nodes->size; i++) {
-			as_node* node = nodes->array[i];
-
-			if (node->active) {
-				as_status status = as_node_refresh(cluster, &error_local, node, &peers);
-
-				if (status != AEROSPIKE_OK) {
-					// Use info level so aql doesn't see message by default.
-					as_log_info("Node %s refresh failed: %s %s",
-						node->name, as_error_string(status), error_local.message);
-					peers.gen_changed = true;
-					as_cluster_node_failure(node);
-				}
-			}
+		if (parallel) {
+			as_cluster_tend_nodes_parallel(cluster, nodes, &peers);
+		}
+		else {
+			as_cluster_tend_nodes(cluster, nodes, &peers);
 		}
 
 		// Refresh peers when necessary.
@@ -993,18 +1405,11 @@ as_cluster_tend(as_cluster* cluster, as_error* err, bool is_init)
 			// peers changed.
 			peers.refresh_count = 0;
 
-			for (uint32_t i = 0; i < nodes->size; i++) {
-				as_node* node = nodes->array[i];
-
-				if (node->failures == 0 && node->active) {
-					as_status status = as_node_refresh_peers(cluster, &error_local, node, &peers);
-	
-					if (status != AEROSPIKE_OK) {
-						as_log_warn("Node %s peers refresh failed: %s %s",
-							node->name, as_error_string(status), error_local.message);
-						as_cluster_node_failure(node);
-					}
-				}
+			if (parallel) {
+				as_cluster_tend_peers_parallel(cluster, nodes, &peers);
+			}
+			else {
+				as_cluster_tend_peers(cluster, nodes, &peers);
 			}
 
 			// Remove nodes determined by refreshed peers.
@@ -1028,37 +1433,11 @@ as_cluster_tend(as_cluster* cluster, as_error* err, bool is_init)
 	cluster->invalid_node_count += as_peers_invalid_count(&peers);
 
 	// Refresh partition map when necessary.
-	for (uint32_t i = 0; i < nodes->size; i++) {
-		as_node* node = nodes->array[i];
-		
-		// Avoid "split cluster" case where this node thinks it's a 1-node cluster.
-		// Unchecked, such a node can dominate the partition map and cause all other
-		// nodes to be dropped.
-		if (node->partition_changed && node->failures == 0 && node->active &&
-		   (node->peers_count > 0 || peers.refresh_count == 1)) {
-			as_status status = as_node_refresh_partitions(cluster, &error_local, node);
-			
-			if (status != AEROSPIKE_OK) {
-				as_log_warn("Node %s partition refresh failed: %s %s",
-							node->name, as_error_string(status), error_local.message);
-				as_cluster_node_failure(node);
-			}
-		}
-
-		if (node->rebalance_changed && node->failures == 0 && node->active) {
-			as_status status = as_node_refresh_racks(cluster, &error_local, node);
-
-			if (status == AEROSPIKE_OK) {
-				if (cluster->shm_info && node->racks && node->racks->size > 0) {
-					rebalance = true;
-				}
-			}
-			else {
-				as_log_warn("Node %s rack refresh failed: %s %s",
-							node->name, as_error_string(status), error_local.message);
-				as_cluster_node_failure(node);
-			}
-		}
+	if (parallel) {
+		rebalance = as_cluster_tend_partitions_parallel(cluster, nodes, &peers);
+	}
+	else {
+		rebalance = as_cluster_tend_partitions(cluster, nodes, &peers);
 	}
 
 	if (rebalance && cluster->shm_info) {
@@ -1066,6 +1445,7 @@ as_cluster_tend(as_cluster* cluster, as_error* err, bool is_init)
 		as_incr_uint32(&cluster->shm_info->cluster_shm->rebalance_gen);
 	}
 
+	as_store_uint32(&cluster->partitions_changed, cluster->tend_partitions_changed);
 	as_cluster_destroy_peers(&peers);
 	as_cluster_manage(cluster);
 	return AEROSPIKE_OK;
@@ -1622,7 +2002,12 @@ as_cluster_create(aerospike* as, as_error* err)
 	cluster->conn_timeout_ms = (config->conn_timeout_ms == 0) ? 1000 : config->conn_timeout_ms;
 	cluster->login_timeout_ms = (config->login_timeout_ms == 0) ? 5000 : config->login_timeout_ms;
 	cluster->tend_thread_cpu = config->tend_thread_cpu;
+	cluster->tend_thread_pool_size = config->tend_thread_pool_size;
 	cluster->conn_pools_per_node = config->conn_pools_per_node;
+	cluster->conn_pool_thread_affinity = config->conn_pool_thread_affinity;
+	cluster->compression_level = (config->compression_level >= AS_COMPRESS_LEVEL_MIN &&
+		config->compression_level <= AS_COMPRESS_LEVEL_MAX) ?
+		config->compression_level : AS_COMPRESS_LEVEL_DEFAULT;
 	cluster->use_services_alternate = config->use_services_alternate;
 	cluster->rack_aware = config->rack_aware;
 	cluster->fail_if_not_connected = config->fail_if_not_connected;
@@ -1708,6 +2093,20 @@ as_cluster_create(aerospike* as, as_error* err)
 		return status;
 	}
 
+	if (cluster->tend_thread_pool_size > 0) {
+		// Initialize parallel tend thread pool.
+		rc = as_thread_pool_init(&cluster->tend_thread_pool, cluster->tend_thread_pool_size);
+		cluster->tend_thread_pool.fini_fn = as_tls_thread_cleanup;
+
+		if (rc) {
+			as_status status = as_error_update(err, AEROSPIKE_ERR_CLIENT,
+				"Failed to initialize tend thread pool of size %u: %d",
+				cluster->tend_thread_pool_size, rc);
+			as_cluster_destroy(cluster);
+			return status;
+		}
+	}
+
 	if (config->tls.enable) {
 		// Initialize TLS parameters.
 		cluster->tls_ctx = cf_malloc(sizeof(as_tls_context));
@@ -1733,9 +2132,12 @@ as_cluster_create(aerospike* as, as_error* err)
 	cluster->metrics_interval = 0;
 	cluster->metrics_latency_columns = 0;
 	cluster->metrics_latency_shift = 0;
+	cluster->metrics_latency_micros = false;
 	cluster->command_count = 0;
 	cluster->retry_count = 0;
 	cluster->delay_queue_timeout_count = 0;
+	cluster->hedge_count = 0;
+	cluster->hedge_win_count = 0;
 
 	cluster->as = as;
 
@@ -1834,6 +2236,14 @@ as_cluster_destroy(as_cluster* cluster)
 		as_log_warn("Failed to destroy thread pool: %d", rc);
 	}
 
+	if (cluster->tend_thread_pool_size > 0) {
+		rc = as_thread_pool_destroy(&cluster->tend_thread_pool);
+
+		if (rc) {
+			as_log_warn("Failed to destroy tend thread pool: %d", rc);
+		}
+	}
+
 	// Release everything in garbage collector.
 	as_cluster_gc(cluster->gc);
 	as_vector_destroy(cluster->gc);
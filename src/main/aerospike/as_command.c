@@ -16,12 +16,14 @@
  */
 #include <aerospike/as_command.h>
 #include <aerospike/as_cluster.h>
+#include <aerospike/as_compress.h>
 #include <aerospike/as_conn_recover.h>
 #include <aerospike/as_event.h>
 #include <aerospike/as_key.h>
 #include <aerospike/as_log_macros.h>
 #include <aerospike/as_msgpack.h>
 #include <aerospike/as_partition_tracker.h>
+#include <aerospike/as_poll.h>
 #include <aerospike/as_queue_mt.h>
 #include <aerospike/as_record.h>
 #include <aerospike/as_serializer.h>
@@ -33,7 +35,6 @@
 #include <citrusleaf/cf_digest.h>
 #include <stdlib.h>
 #include <string.h>
-#include <zlib.h>
 
 //---------------------------------
 // Static Variables
@@ -50,7 +51,8 @@ uint8_t
 as_replica_index_init_read(as_cluster* cluster, as_policy_replica replica)
 {
 	switch (replica) {
-		case AS_POLICY_REPLICA_ANY: {
+		case AS_POLICY_REPLICA_ANY:
+		case AS_POLICY_REPLICA_FASTEST: {
 			uint32_t index = as_faa_uint32(&cluster->replica_index_any, 1);
 			return (uint8_t)(index % AS_MAX_REPLICATION_FACTOR);
 		}
@@ -473,8 +475,76 @@ as_command_write_bin_name(uint8_t* cmd, const char* name)
 	return p;
 }
 
+static inline bool
+as_command_gather_value(as_command_gather* gather, uint32_t len)
+{
+	return gather && len >= AS_COMMAND_GATHER_MIN && gather->n_values < AS_COMMAND_GATHER_MAX;
+}
+
+static void
+as_command_gather_add(as_command_gather* gather, uint8_t* p, void* value, uint32_t len)
+{
+	// Close the command buffer segment written so far and reference the value in place.
+	// Writing continues at p, so the next segment starts where this one ended.
+	as_iovec* iov = &gather->iov[gather->iov_size++];
+	iov->iov_base = gather->begin;
+	iov->iov_len = p - gather->begin;
+
+	iov = &gather->iov[gather->iov_size++];
+	iov->iov_base = value;
+	iov->iov_len = len;
+
+	gather->begin = p;
+	gather->size += len;
+	gather->n_values++;
+}
+
+size_t
+as_command_gather_size(const as_bin* bins, uint16_t n_bins)
+{
+	as_command_gather gather;
+	gather.n_values = 0;
+
+	size_t size = 0;
+
+	for (uint16_t i = 0; i < n_bins; i++) {
+		as_val* val = (as_val*)bins[i].valuep;
+
+		if (!val) {
+			continue;
+		}
+
+		uint32_t len;
+
+		if (val->type == AS_STRING) {
+			len = (uint32_t)as_string_len(as_string_fromval(val));
+		}
+		else if (val->type == AS_BYTES) {
+			len = as_bytes_fromval(val)->size;
+		}
+		else {
+			continue;
+		}
+
+		if (as_command_gather_value(&gather, len)) {
+			gather.n_values++;
+			size += len;
+		}
+	}
+	return size;
+}
+
 uint8_t*
 as_command_write_bin(uint8_t* begin, as_operator op_type, const as_bin* bin, as_queue* buffers)
+{
+	return as_command_write_bin_gather(begin, op_type, bin, buffers, NULL);
+}
+
+uint8_t*
+as_command_write_bin_gather(
+	uint8_t* begin, as_operator op_type, const as_bin* bin, as_queue* buffers,
+	as_command_gather* gather
+	)
 {
 	uint8_t* p = begin + AS_OPERATION_HEADER_SIZE;
 	const char* name = bin->name;
@@ -527,9 +597,15 @@ as_command_write_bin(uint8_t* begin, as_operator op_type, const as_bin* bin, as_
 		case AS_STRING: {
 			as_string* v = as_string_fromval(val);
 			// v->len should have been already set by as_command_value_size().
-			memcpy(p, v->value, v->len);
-			p += v->len;
 			val_len = (uint32_t)v->len;
+
+			if (as_command_gather_value(gather, val_len)) {
+				as_command_gather_add(gather, p, v->value, val_len);
+			}
+			else {
+				memcpy(p, v->value, v->len);
+				p += v->len;
+			}
 			val_type = AS_BYTES_STRING;
 			break;
 		}
@@ -564,9 +640,15 @@ as_command_write_bin(uint8_t* begin, as_operator op_type, const as_bin* bin, as_
 		}
 		case AS_BYTES: {
 			as_bytes* v = as_bytes_fromval(val);
-			memcpy(p, v->value, v->size);
-			p += v->size;
 			val_len = v->size;
+
+			if (as_command_gather_value(gather, val_len)) {
+				as_command_gather_add(gather, p, v->value, val_len);
+			}
+			else {
+				memcpy(p, v->value, v->size);
+				p += v->size;
+			}
 			// Note: v->type must be a blob type (AS_BYTES_BLOB, AS_BYTES_JAVA, AS_BYTES_PYTHON ...).
 			// Otherwise, the particle type will be reassigned to a non-blob which causes a
 			// mismatch between type and value.
@@ -608,21 +690,24 @@ WriteFieldHeader:
 size_t
 as_command_compress_max_size(size_t cmd_sz)
 {
-	return compressBound((uLong)cmd_sz) + sizeof(as_compressed_proto);
+	return as_compress_bound(cmd_sz) + sizeof(as_compressed_proto);
 }
 
 as_status
-as_command_compress(as_error* err, uint8_t* cmd, size_t cmd_sz, uint8_t* compressed_cmd, size_t* compressed_size)
+as_command_compress(
+	as_error* err, uint8_t* cmd, size_t cmd_sz, uint8_t* compressed_cmd, size_t* compressed_size,
+	int level
+	)
 {
 	*compressed_size -= sizeof(as_compressed_proto);
-	int ret_val = compress2(compressed_cmd + sizeof(as_compressed_proto), (uLongf*)compressed_size,
-							cmd, (uLong)cmd_sz, Z_BEST_SPEED);
+	int ret_val = as_compress(compressed_cmd + sizeof(as_compressed_proto), compressed_size,
+							  cmd, cmd_sz, level);
 	
 	if (ret_val) {
 		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Compress failed: %d", ret_val);
 	}
 	
-	// compressed_size will now have to actual compressed size from compress2()
+	// compressed_size will now have to actual compressed size from as_compress()
 	as_command_compress_write_end(compressed_cmd, compressed_cmd + sizeof(as_compressed_proto) +
 								  *compressed_size, cmd_sz);
 	
@@ -645,7 +730,8 @@ as_command_send(
 		size_t comp_capacity = as_command_compress_max_size(cmd->buf_size);
 		size_t comp_size = comp_capacity;
 		uint8_t* comp_buf = as_command_buffer_init(comp_capacity);
-		as_status status = as_command_compress(err, cmd->buf, cmd->buf_size, comp_buf, &comp_size);
+		as_status status = as_command_compress(err, cmd->buf, cmd->buf_size, comp_buf, &comp_size,
+			cmd->cluster->compression_level);
 		as_command_buffer_free(cmd->buf, capacity);
 
 		if (status != AEROSPIKE_OK) {
@@ -664,6 +750,35 @@ as_command_send(
 	return status;
 }
 
+as_status
+as_command_send_gather(
+	as_command* cmd, as_error* err, as_command_gather* gather, as_write_fn write_fn, void* udata
+	)
+{
+	size_t capacity = cmd->buf_size;
+	cmd->buf = as_command_buffer_init(capacity);
+	cmd->buf_size = write_fn(udata, cmd->buf);
+	cmd->gather = gather;
+	cmd->flags |= AS_COMMAND_FLAGS_GATHER;
+
+	as_command_start_timer(cmd);
+
+	as_status status = as_command_execute(cmd, err);
+	as_command_buffer_free(cmd->buf, capacity);
+	return status;
+}
+
+static inline as_status
+as_command_write(as_command* cmd, as_error* err, as_socket* sock, as_node* node)
+{
+	if (cmd->flags & AS_COMMAND_FLAGS_GATHER) {
+		return as_socket_writev_deadline(err, sock, node, cmd->gather->iov,
+			cmd->gather->iov_size, cmd->socket_timeout, cmd->deadline_ms);
+	}
+	return as_socket_write_deadline(err, sock, node, cmd->buf, cmd->buf_size,
+		cmd->socket_timeout, cmd->deadline_ms);
+}
+
 static inline bool
 is_server_timeout(as_error* err)
 {
@@ -686,6 +801,121 @@ as_command_prepare_error(as_command* cmd, as_error* err)
 	}
 }
 
+static inline bool
+as_command_can_hedge(as_command* cmd, bool is_single)
+{
+	// Only hedge the first attempt of single record reads that have another replica.
+	return cmd->latency_type == AS_LATENCY_TYPE_READ && cmd->hedge_delay > 0 &&
+		cmd->iteration == 0 && is_single && cmd->replica != AS_POLICY_REPLICA_MASTER &&
+		cmd->replica_size > 1;
+}
+
+/**
+ * Wait hedge delay for a response from the original node. If none arrives, send the command
+ * to the next replica and wait for the first response. If the hedge node answers first, close
+ * the original connection and replace node, socket, context and begin time with the hedge
+ * node's values. Return true if the hedge node won.
+ */
+static bool
+as_command_hedge(
+	as_command* cmd, as_node** node_ptr, as_socket* sock, as_socket_context* ctx, uint64_t* begin
+	)
+{
+	as_node* node = *node_ptr;
+	uint32_t delay = as_node_hedge_delay(node, cmd->hedge_delay);
+
+	if (delay == 0 || (cmd->socket_timeout > 0 && delay >= cmd->socket_timeout)) {
+		return false;
+	}
+
+	if (cmd->deadline_ms > 0 && cf_getms() + delay >= cmd->deadline_ms) {
+		return false;
+	}
+
+	as_poll poll;
+	as_poll_init(&poll, sock->fd);
+	int rv = as_poll_socket(&poll, sock->fd, delay, true);
+	as_poll_destroy(&poll);
+
+	if (rv != 0) {
+		// Response arrived or socket error. The normal read path handles both.
+		return false;
+	}
+
+	uint8_t replica_index = cmd->replica_index + 1;
+	as_node* hnode = as_partition_get_node(cmd->cluster, cmd->ns, cmd->partition, node,
+		cmd->replica, cmd->replica_size, &replica_index);
+
+	if (! hnode || hnode == node || ! as_node_valid_error_rate(hnode)) {
+		return false;
+	}
+
+	as_node_reserve(hnode);
+
+	// Hedge failures are not reported. The original command is still pending.
+	as_error err;
+	as_error_init(&err);
+
+	as_socket hsock;
+	as_socket_context hctx = *ctx;
+	hctx.state = AS_READ_STATE_AUTH_HEADER;
+
+	if (as_node_get_connection(&err, hnode, cmd, cmd->deadline_ms, &hsock, &hctx) !=
+		AEROSPIKE_OK) {
+		as_node_release(hnode);
+		return false;
+	}
+
+	uint64_t hbegin = cf_getns();
+
+	if (as_command_write(cmd, &err, &hsock, hnode) != AEROSPIKE_OK) {
+		as_node_close_conn_error(hnode, &hsock, hsock.pool);
+		as_node_release(hnode);
+		return false;
+	}
+
+	as_cluster_add_hedge(cmd->cluster);
+	as_incr_uint32(&hnode->inflight);
+
+	uint32_t timeout = cmd->socket_timeout;
+
+	if (cmd->deadline_ms > 0) {
+		uint64_t now = cf_getms();
+		uint32_t remaining = (cmd->deadline_ms > now)? (uint32_t)(cmd->deadline_ms - now) : 1;
+
+		if (timeout == 0 || remaining < timeout) {
+			timeout = remaining;
+		}
+	}
+
+	as_socket_fd max = (sock->fd > hsock.fd)? sock->fd : hsock.fd;
+	as_poll_init(&poll, max);
+	rv = as_poll_sockets_read(&poll, sock->fd, hsock.fd, timeout);
+	as_poll_destroy(&poll);
+
+	if (rv != 2) {
+		// Original node answered first, failed or both timed out. Drop the hedge.
+		as_decr_uint32(&hnode->inflight);
+		as_node_close_connection(hnode, &hsock, hsock.pool);
+		as_node_release(hnode);
+		return false;
+	}
+
+	// Hedge node won. The original response is abandoned, so close its connection. The
+	// original node's latency is at least the time waited so far.
+	as_decr_uint32(&node->inflight);
+	as_node_add_replica_latency(node, cf_getns() - *begin);
+	as_node_close_connection(node, sock, sock->pool);
+	as_node_release(node);
+	as_cluster_add_hedge_win(cmd->cluster);
+
+	*node_ptr = hnode;
+	*sock = hsock;
+	*ctx = hctx;
+	*begin = hbegin;
+	return true;
+}
+
 as_status
 as_command_execute(as_command* cmd, as_error* err)
 {
@@ -737,6 +967,15 @@ as_command_execute(as_command* cmd, as_error* err)
 			}
 		}
 
+		// Single record reads feed the node latency statistics used by AS_POLICY_REPLICA_FASTEST
+		// and hedged reads.
+		bool track = cmd->latency_type == AS_LATENCY_TYPE_READ &&
+			(cmd->replica == AS_POLICY_REPLICA_FASTEST || cmd->hedge_delay > 0);
+
+		if (track && begin == 0) {
+			begin = cf_getns();
+		}
+
 		as_socket socket;
 		ctx.state = AS_READ_STATE_AUTH_HEADER;
 		status = as_node_get_connection(err, node, cmd, cmd->deadline_ms, &socket, &ctx);
@@ -757,8 +996,7 @@ as_command_execute(as_command* cmd, as_error* err)
 		}
 		
 		// Send command.
-		status = as_socket_write_deadline(err, &socket, node, cmd->buf, cmd->buf_size,
-										  cmd->socket_timeout, cmd->deadline_ms);
+		status = as_command_write(cmd, err, &socket, node);
 		
 		if (status != AEROSPIKE_OK) {
 			// Socket errors are considered temporary anomalies.  Retry.
@@ -772,6 +1010,17 @@ as_command_execute(as_command* cmd, as_error* err)
 			as_node_add_bytes_out(metrics, cmd->buf_size);
 		}
 
+		if (track) {
+			as_incr_uint32(&node->inflight);
+
+			if (as_command_can_hedge(cmd, ctx.is_single) &&
+				as_command_hedge(cmd, &node, &socket, &ctx, &begin) && metrics) {
+				// Hedge node answered first. Account remaining traffic to that node.
+				metrics = as_node_prepare_metrics(node, cmd->ns);
+				as_node_add_bytes_out(metrics, cmd->buf_size);
+			}
+		}
+
 		uint64_t bytes_in = 0;
 
 		// Parse results returned by server.
@@ -786,6 +1035,16 @@ as_command_execute(as_command* cmd, as_error* err)
 			as_node_add_bytes_in(metrics, bytes_in);
 		}
 
+		if (track) {
+			as_decr_uint32(&node->inflight);
+
+			// Timeouts are included so a stalled node is avoided on subsequent reads.
+			if (status == AEROSPIKE_OK || status == AEROSPIKE_ERR_RECORD_NOT_FOUND ||
+				status == AEROSPIKE_ERR_TIMEOUT) {
+				as_node_add_replica_latency(node, cf_getns() - begin);
+			}
+		}
+
 		if (status == AEROSPIKE_OK) {
 			if (metrics && cmd->latency_type != AS_LATENCY_TYPE_NONE) {
 				uint64_t elapsed = cf_getns() - begin;
@@ -957,6 +1216,9 @@ as_command_read_messages(
 	as_socket_context* ctx
 	)
 {
+	// Response streams can be large, so always use the thread's buffer pool instead of the
+	// stack.
+	as_buffer_pool* pool = as_buffer_pool_thread();
 	size_t capacity = 0;
 	uint8_t* buf = NULL;
 	size_t size;
@@ -991,9 +1253,10 @@ as_command_read_messages(
 
 		// Prepare buffer
 		if (size > capacity) {
-			as_command_buffer_free(buf, capacity);
-			capacity = (size + 16383) & ~16383; // Round up in 16KB increments.
-			buf = as_command_buffer_init(capacity);
+			if (buf) {
+				as_buffer_pool_put(pool, buf, capacity);
+			}
+			buf = as_buffer_pool_get(pool, size, &capacity);
 		}
 		
 		// Read remaining message bytes in group
@@ -1018,9 +1281,10 @@ as_command_read_messages(
 			}
 
 			if (size2 > capacity2) {
-				as_command_buffer_free(buf2, capacity2);
-				capacity2 = (size2 + 16383) & ~16383; // Round up in 16KB increments.
-				buf2 = as_command_buffer_init(capacity2);
+				if (buf2) {
+					as_buffer_pool_put(pool, buf2, capacity2);
+				}
+				buf2 = as_buffer_pool_get(pool, size2, &capacity2);
 			}
 
 			status = as_proto_decompress(err, buf2, size2, buf, size);
@@ -1044,8 +1308,13 @@ as_command_read_messages(
 			break;
 		}
 	}
-	as_command_buffer_free(buf, capacity);
-	as_command_buffer_free(buf2, capacity2);
+	if (buf) {
+		as_buffer_pool_put(pool, buf, capacity);
+	}
+
+	if (buf2) {
+		as_buffer_pool_put(pool, buf2, capacity2);
+	}
 	return status;
 }
 
@@ -1867,9 +2136,67 @@ abort_record_memory(as_error* err, as_record* rec, size_t size)
 	return as_error_update(err, AEROSPIKE_ERR_CLIENT, "malloc failure: %zu", size);
 }
 
-as_status
-as_command_parse_bins(uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bins, bool deserialize)
+static inline uint8_t*
+as_command_value_alloc(uint8_t** arena, size_t size)
 {
+	if (! *arena) {
+		return cf_malloc(size);
+	}
+
+	uint8_t* v = *arena;
+	*arena += size;
+	return v;
+}
+
+static size_t
+as_command_bins_arena_size(uint8_t* p, uint32_t n_bins, bool deserialize)
+{
+	size_t size = 0;
+
+	for (uint32_t i = 0; i < n_bins; i++) {
+		uint32_t op_size = cf_swap_from_be32(*(uint32_t*)p);
+		uint8_t type = p[5];
+		uint8_t name_size = p[7];
+		uint32_t value_size = (op_size - (name_size + 4));
+
+		switch (type) {
+			case AS_BYTES_UNDEF:
+			case AS_BYTES_BOOL:
+			case AS_BYTES_INTEGER:
+			case AS_BYTES_DOUBLE:
+				break;
+
+			case AS_BYTES_STRING:
+			case AS_BYTES_GEOJSON:
+				// Geojson cells are skipped, so value_size is an upper bound.
+				size += value_size + 1;
+				break;
+
+			case AS_BYTES_LIST:
+			case AS_BYTES_MAP:
+				if (! deserialize) {
+					size += value_size;
+				}
+				break;
+
+			default:
+				size += value_size;
+				break;
+		}
+		p += 4 + op_size;
+	}
+	return size;
+}
+
+static as_status
+as_command_parse_bins_arena(
+	uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bins, bool deserialize, bool borrow,
+	uint8_t* arena
+	)
+{
+	// Values allocated from the arena are owned by the record's bin array, not the values.
+	bool free = arena == NULL;
+
 	uint8_t* p = *pp;
 	as_bin* bin = rec->bins.entries;
 
@@ -1917,14 +2244,14 @@ as_command_parse_bins(uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bi
 				break;
 			}
 			case AS_BYTES_STRING: {
-				char* value = cf_malloc(value_size + 1);
+				char* value = (char*)as_command_value_alloc(&arena, value_size + 1);
 
 				if (! value) {
 					return abort_record_memory(err, rec, value_size + 1);
 				}
 				memcpy(value, p, value_size);
 				value[value_size] = 0;
-				as_string_init_wlen((as_string*)&bin->value, (char*)value, value_size, true);
+				as_string_init_wlen((as_string*)&bin->value, (char*)value, value_size, free);
 				bin->valuep = &bin->value;
 				break;
 			}
@@ -1943,7 +2270,7 @@ as_command_parse_bins(uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bi
 
 				// Use the json bytes.
 				size_t jsonsz = value_size - 1 - 2 - (ncells * sizeof(uint64_t));
-				char* v = cf_malloc(jsonsz + 1);
+				char* v = (char*)as_command_value_alloc(&arena, jsonsz + 1);
 
 				if (! v) {
 					return abort_record_memory(err, rec, jsonsz + 1);
@@ -1951,7 +2278,7 @@ as_command_parse_bins(uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bi
 				memcpy(v, ptr, jsonsz);
 				v[jsonsz] = 0;
 				as_geojson_init_wlen((as_geojson*)&bin->value,
-									 (char*)v, jsonsz, true);
+									 (char*)v, jsonsz, free);
 				bin->valuep = &bin->value;
 				break;
 			}
@@ -1974,27 +2301,40 @@ as_command_parse_bins(uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bi
 					}
 					bin->valuep = (as_bin_value*)value;
 				}
+				else if (borrow) {
+					as_bytes_init_wrap((as_bytes*)&bin->value, p, value_size, false);
+					bin->value.bytes.type = (as_bytes_type)type;
+					bin->valuep = &bin->value;
+				}
 				else {
-					void* value = cf_malloc(value_size);
+					uint8_t* value = as_command_value_alloc(&arena, value_size);
 
 					if (! value) {
 						return abort_record_memory(err, rec, value_size);
 					}
 					memcpy(value, p, value_size);
-					as_bytes_init_wrap((as_bytes*)&bin->value, value, value_size, true);
+					as_bytes_init_wrap((as_bytes*)&bin->value, value, value_size, free);
 					bin->value.bytes.type = (as_bytes_type)type;
 					bin->valuep = &bin->value;
 				}
 				break;
 			}
 			default: {
-				void* value = cf_malloc(value_size);
+				if (borrow) {
+					// Reference response buffer directly. Value is valid until buffer is released.
+					as_bytes_init_wrap((as_bytes*)&bin->value, p, value_size, false);
+					bin->value.bytes.type = (as_bytes_type)type;
+					bin->valuep = &bin->value;
+					break;
+				}
+
+				uint8_t* value = as_command_value_alloc(&arena, value_size);
 
 				if (! value) {
 					return abort_record_memory(err, rec, value_size);
 				}
 				memcpy(value, p, value_size);
-				as_bytes_init_wrap((as_bytes*)&bin->value, value, value_size, true);
+				as_bytes_init_wrap((as_bytes*)&bin->value, value, value_size, free);
 				bin->value.bytes.type = (as_bytes_type)type;
 				bin->valuep = &bin->value;
 				break;
@@ -2007,6 +2347,30 @@ as_command_parse_bins(uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bi
 	return AEROSPIKE_OK;
 }
 
+as_status
+as_command_parse_bins(
+	uint8_t** pp, as_error* err, as_record* rec, uint32_t n_bins, bool deserialize, bool borrow
+	)
+{
+	return as_command_parse_bins_arena(pp, err, rec, n_bins, deserialize, borrow, NULL);
+}
+
+static as_record*
+as_command_record_arena_new(uint8_t* p, uint32_t n_bins, bool deserialize, uint8_t** arena)
+{
+	// Allocate bin array and bin values in one block that is freed in as_record_destroy().
+	size_t bins_size = sizeof(as_bin) * n_bins;
+	size_t arena_size = as_command_bins_arena_size(p, n_bins, deserialize);
+	as_record* rec = as_record_new(0);
+
+	rec->bins.entries = cf_malloc(bins_size + arena_size);
+	rec->bins.capacity = (uint16_t)n_bins;
+	rec->bins.size = 0;
+	rec->bins._free = true;
+	*arena = (uint8_t*)rec->bins.entries + bins_size;
+	return rec;
+}
+
 as_status
 as_command_parse_result(as_error* err, as_command* cmd, as_node* node, uint8_t* buf, size_t size)
 {
@@ -2031,6 +2395,7 @@ as_command_parse_result(as_error* err, as_command* cmd, as_node* node, uint8_t*
 		case AEROSPIKE_OK: {
 			if (data->record) {
 				as_record* rec = *data->record;
+				uint8_t* arena = NULL;
 				bool free_on_error;
 				
 				if (rec) {
@@ -2052,6 +2417,11 @@ as_command_parse_result(as_error* err, as_command* cmd, as_node* node, uint8_t*
 					}
 					free_on_error = false;
 				}
+				else if (data->bin_arena && msg->n_ops > 0) {
+					rec = as_command_record_arena_new(p, msg->n_ops, data->deserialize, &arena);
+					*data->record = rec;
+					free_on_error = true;
+				}
 				else {
 					rec = as_record_new(msg->n_ops);
 					*data->record = rec;
@@ -2060,7 +2430,8 @@ as_command_parse_result(as_error* err, as_command* cmd, as_node* node, uint8_t*
 				rec->gen = msg->generation;
 				rec->ttl = cf_server_void_time_to_ttl(msg->record_ttl);
 
-				status = as_command_parse_bins(&p, err, rec, msg->n_ops, data->deserialize);
+				status = as_command_parse_bins_arena(&p, err, rec, msg->n_ops, data->deserialize,
+					false, arena);
 
 				if (status != AEROSPIKE_OK && free_on_error) {
 					as_record_destroy(rec);
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/as_compress.h>
+#include <citrusleaf/alloc.h>
+#include <pthread.h>
+#include <string.h>
+#include <zlib.h>
+
+//---------------------------------
+// Types
+//---------------------------------
+
+typedef struct {
+	z_stream deflate;
+	z_stream inflate;
+	int level;
+	bool deflate_init;
+	bool inflate_init;
+} as_compress_context;
+
+//---------------------------------
+// Globals
+//---------------------------------
+
+static pthread_once_t as_compress_once = PTHREAD_ONCE_INIT;
+static pthread_key_t as_compress_key;
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static void
+as_compress_context_destroy(void* udata)
+{
+	as_compress_context* ctx = udata;
+
+	if (ctx->deflate_init) {
+		deflateEnd(&ctx->deflate);
+	}
+
+	if (ctx->inflate_init) {
+		inflateEnd(&ctx->inflate);
+	}
+	cf_free(ctx);
+}
+
+static void
+as_compress_key_create(void)
+{
+	pthread_key_create(&as_compress_key, as_compress_context_destroy);
+}
+
+static as_compress_context*
+as_compress_context_get(void)
+{
+	pthread_once(&as_compress_once, as_compress_key_create);
+
+	as_compress_context* ctx = pthread_getspecific(as_compress_key);
+
+	if (!ctx) {
+		ctx = cf_malloc(sizeof(as_compress_context));
+		memset(ctx, 0, sizeof(as_compress_context));
+		pthread_setspecific(as_compress_key, ctx);
+	}
+	return ctx;
+}
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+size_t
+as_compress_bound(size_t src_sz)
+{
+	return compressBound((uLong)src_sz);
+}
+
+int
+as_compress(uint8_t* trg, size_t* trg_sz, const uint8_t* src, size_t src_sz, int level)
+{
+	as_compress_context* ctx = as_compress_context_get();
+	z_stream* strm = &ctx->deflate;
+	int rv;
+
+	if (!ctx->deflate_init) {
+		rv = deflateInit(strm, level);
+
+		if (rv != Z_OK) {
+			return rv;
+		}
+		ctx->deflate_init = true;
+		ctx->level = level;
+	}
+	else {
+		// Reuse the stream's window and hash tables instead of reallocating them.
+		rv = deflateReset(strm);
+
+		if (rv != Z_OK) {
+			return rv;
+		}
+
+		if (ctx->level != level) {
+			rv = deflateParams(strm, level, Z_DEFAULT_STRATEGY);
+
+			if (rv != Z_OK) {
+				return rv;
+			}
+			ctx->level = level;
+		}
+	}
+
+	strm->next_in = (Bytef*)src;
+	strm->avail_in = (uInt)src_sz;
+	strm->next_out = trg;
+	strm->avail_out = (uInt)*trg_sz;
+
+	rv = deflate(strm, Z_FINISH);
+
+	if (rv != Z_STREAM_END) {
+		return (rv == Z_OK)? Z_BUF_ERROR : rv;
+	}
+
+	*trg_sz = (size_t)strm->total_out;
+	return Z_OK;
+}
+
+int
+as_decompress(uint8_t* trg, size_t* trg_sz, const uint8_t* src, size_t src_sz)
+{
+	as_compress_context* ctx = as_compress_context_get();
+	z_stream* strm = &ctx->inflate;
+	int rv;
+
+	if (!ctx->inflate_init) {
+		rv = inflateInit(strm);
+
+		if (rv != Z_OK) {
+			return rv;
+		}
+		ctx->inflate_init = true;
+	}
+	else {
+		rv = inflateReset(strm);
+
+		if (rv != Z_OK) {
+			return rv;
+		}
+	}
+
+	strm->next_in = (Bytef*)src;
+	strm->avail_in = (uInt)src_sz;
+	strm->next_out = trg;
+	strm->avail_out = (uInt)*trg_sz;
+
+	rv = inflate(strm, Z_FINISH);
+
+	if (rv != Z_STREAM_END) {
+		// Match uncompress(): truncated input is a data error, full output is a buffer error.
+		if (rv == Z_NEED_DICT || (rv == Z_BUF_ERROR && strm->avail_in == 0)) {
+			return Z_DATA_ERROR;
+		}
+		return (rv == Z_OK)? Z_BUF_ERROR : rv;
+	}
+
+	*trg_sz = (size_t)strm->total_out;
+	return Z_OK;
+}
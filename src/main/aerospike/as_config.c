@@ -45,6 +45,7 @@ as_config_init(as_config* c)
 	c->async_max_conns_per_node = 100;
 	c->pipe_max_conns_per_node = 64;
 	c->conn_pools_per_node = 1;
+	c->conn_pool_thread_affinity = false;
 	c->conn_timeout_ms = 1000;
 	c->login_timeout_ms = 5000;
 	c->max_socket_idle = 0;
@@ -52,12 +53,16 @@ as_config_init(as_config* c)
 	c->error_rate_window = 1;
 	c->tender_interval = 1000;
 	c->thread_pool_size = 16;
+	c->sync_batch_event_loops = false;
 	c->tend_thread_cpu = -1;
+	c->tend_thread_pool_size = 0;
+	c->compression_level = AS_COMPRESS_LEVEL_DEFAULT;
 	as_policies_init(&c->policies);
 	c->config_provider.path = NULL;
 	c->config_provider.interval = AS_CONFIG_PROVIDER_INTERVAL_DEFAULT;
 	as_config_lua_init(&c->lua);
 	memset(&c->tls, 0, sizeof(as_config_tls));
+	c->tls.session_cache = true;
 	c->auth_mode = AS_AUTH_INTERNAL;
 	c->fail_if_not_connected = true;
 	c->use_services_alternate = false;
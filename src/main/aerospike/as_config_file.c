@@ -548,6 +548,9 @@ as_parse_replica(
 	else if (strcmp(value, "RANDOM") == 0) {
 		val = AS_POLICY_REPLICA_RANDOM;
 	}
+	else if (strcmp(value, "FASTEST") == 0) {
+		val = AS_POLICY_REPLICA_FASTEST;
+	}
 	else {
 		as_error_update(&yaml->err, AEROSPIKE_ERR_PARAM, "Invalid %s: %s", name, value);
 		return false;
@@ -1157,6 +1160,14 @@ as_parse_metrics(as_yaml* yaml, const char* name, const char* value, as_policies
 		return as_parse_uint8(yaml, name, value, &policy->latency_shift, AS_METRICS_LATENCY_SHIFT);
 	}
 
+	if (strcmp(name, "latency_micros") == 0) {
+		return as_parse_bool(yaml, name, value, &policy->latency_micros, AS_METRICS_LATENCY_MICROS);
+	}
+
+	if (strcmp(name, "latency_delta") == 0) {
+		return as_parse_bool(yaml, name, value, &policy->latency_delta, AS_METRICS_LATENCY_DELTA);
+	}
+
 	if (strcmp(name, "labels") == 0) {
 		return as_parse_labels(yaml, policy, AS_METRICS_LABELS);
 	}
@@ -1906,6 +1917,7 @@ as_cluster_update_metrics(
 	pthread_mutex_lock(&cluster->metrics_lock);
 
 	bool enable_metrics = false;
+	bool latency_delta = trg->latency_delta;
 
 	trg->enable = as_field_is_set(bitmap, AS_METRICS_ENABLE)?
 		src->enable : orig->enable;
@@ -1913,6 +1925,15 @@ as_cluster_update_metrics(
 		src->latency_columns : orig->latency_columns;
 	trg->latency_shift = as_field_is_set(bitmap, AS_METRICS_LATENCY_SHIFT)?
 		src->latency_shift : orig->latency_shift;
+	trg->latency_micros = as_field_is_set(bitmap, AS_METRICS_LATENCY_MICROS)?
+		src->latency_micros : orig->latency_micros;
+	trg->latency_delta = as_field_is_set(bitmap, AS_METRICS_LATENCY_DELTA)?
+		src->latency_delta : orig->latency_delta;
+
+	// The metrics writer reads latency_delta when it is created.
+	if (trg->latency_delta != latency_delta) {
+		enable_metrics = true;
+	}
 
 	if (as_field_is_set(bitmap, AS_METRICS_LABELS)) {
 		if (!as_metrics_labels_equal(trg->labels, src->labels)) {
@@ -1935,7 +1956,8 @@ as_cluster_update_metrics(
 
 	if (trg->enable) {
 		if (!cluster->metrics_enabled || !(cluster->metrics_latency_columns == trg->latency_columns &&
-			  cluster->metrics_latency_shift == trg->latency_shift)) {
+			  cluster->metrics_latency_shift == trg->latency_shift &&
+			  cluster->metrics_latency_micros == trg->latency_micros)) {
 			enable_metrics = true;
 		}
 
@@ -2085,7 +2107,7 @@ as_cluster_update(
 	}
 
 	as_cluster_update_policies(&orig->policies, &src->policies, &config->policies, bitmap);
-	memcpy(as->config_bitmap, bitmap, sizeof(AS_CONFIG_BITMAP_SIZE));
+	memcpy(as->config_bitmap, bitmap, AS_CONFIG_BITMAP_SIZE);
 
 	return as_cluster_update_metrics(cluster, err, &orig->policies.metrics,
 		&src->policies.metrics, &config->policies.metrics, bitmap);
@@ -61,6 +61,7 @@ void aerospike_destroy_internal(aerospike* as);
 static void as_event_recover_abort(as_event_command* cmd);
 static bool as_event_recover_connection(as_event_command* cmd);
 static void as_event_recover_timeout(as_event_command* cmd);
+static void as_event_hedge_fire(as_event_command* cmd);
 
 //---------------------------------
 // Functions
@@ -95,6 +96,8 @@ as_event_initialize_loop(as_policy_event* policy, as_event_loop* event_loop, uin
 	event_loop->errors = 0;
 	event_loop->using_delay_queue = false;
 	event_loop->pipe_cb_calling = false;
+	event_loop->buffer_pool = cf_malloc(sizeof(as_buffer_pool));
+	as_buffer_pool_init(event_loop->buffer_pool);
 }
 
 // Force link error on event initialization when event library not defined.
@@ -248,6 +251,10 @@ as_set_external_event_loop(as_error* err, as_policy_event* policy, void* loop, a
 {
 	as_error_reset(err);
 
+#if defined(AS_USE_LIBURING)
+	// io_uring loop state is owned by the client's event loop threads.
+	return as_error_set_message(err, AEROSPIKE_ERR_CLIENT, "External event loops are not supported by io_uring");
+#else
 	as_policy_event pol_local;
 
 	if (policy) {
@@ -296,6 +303,7 @@ as_set_external_event_loop(as_error* err, as_policy_event* policy, void* loop, a
 
 	*event_loop_out = event_loop;
 	return AEROSPIKE_OK;
+#endif
 }
 
 as_event_loop*
@@ -404,6 +412,57 @@ as_event_command_execute(as_event_command* cmd, as_error* err)
 	return AEROSPIKE_OK;
 }
 
+as_status
+as_event_command_execute_many(
+	as_event_loop* event_loop, as_event_command** cmds, uint32_t n_cmds, as_error* err
+	)
+{
+	if (as_in_event_loop(event_loop->thread)) {
+		// Already in event loop thread, so there is no queue to batch.
+		for (uint32_t i = 0; i < n_cmds; i++) {
+			as_status status = as_event_command_execute(cmds[i], err);
+
+			if (status != AEROSPIKE_OK) {
+				// Commands that were not started are released here.
+				for (uint32_t j = i + 1; j < n_cmds; j++) {
+					as_event_command_destroy(cmds[j]);
+				}
+				return status;
+			}
+		}
+		return AEROSPIKE_OK;
+	}
+
+	// Send all commands through queue with a single lock acquisition and wakeup.
+	as_event_commander* qcmds = cf_malloc(sizeof(as_event_commander) * n_cmds);
+	uint64_t now = cf_getms();
+
+	for (uint32_t i = 0; i < n_cmds; i++) {
+		as_event_command* cmd = cmds[i];
+
+		cmd->total_deadline = (cmd->total_timeout > 0)? now + cmd->total_timeout : 0;
+		cmd->command_sent_counter = 0;
+		cmd->state = AS_ASYNC_STATE_REGISTERED;
+		qcmds[i].executable = (as_event_executable)as_event_command_execute_in_loop;
+		qcmds[i].udata = cmd;
+	}
+
+	uint32_t n_queued = as_event_execute_many(event_loop, qcmds, n_cmds);
+
+	cf_free(qcmds);
+
+	if (n_queued < n_cmds) {
+		event_loop->errors++;  // May not be in event loop thread, so not exactly accurate.
+
+		for (uint32_t i = n_queued; i < n_cmds; i++) {
+			as_event_command_destroy(cmds[i]);
+		}
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to queue %u of %u commands",
+			n_cmds - n_queued, n_cmds);
+	}
+	return AEROSPIKE_OK;
+}
+
 void
 as_event_command_schedule(as_event_command* cmd)
 {
@@ -413,6 +472,7 @@ as_event_command_schedule(as_event_command* cmd)
 
 	// Callback is as_event_process_timer().
 	cmd->state = AS_ASYNC_STATE_REGISTERED;
+	cmd->hedge_armed = false;
 	as_event_timer_once(cmd, 0);
 }
 
@@ -434,6 +494,11 @@ as_event_command_execute_in_loop(as_event_loop* event_loop, as_event_command* cm
 	cmd->conn = NULL;
 	cmd->metrics = NULL;
 	cmd->proto_type_rcv = 0;
+	cmd->inflight = false;
+	cmd->hedge = NULL;
+	cmd->hedge_armed = false;
+	cmd->hedged = false;
+	cmd->hedge_clone = false;
 	cmd->event_state = &cmd->cluster->event_state[event_loop->index];
 	cmd->bytes_in = 0;
 	cmd->bytes_out = 0;
@@ -525,6 +590,52 @@ as_event_set_timeout(as_event_command* cmd)
 	}
 }
 
+#define AS_EVENT_QUEUE_DRAIN_MAX 64
+
+void
+as_event_process_queue(as_event_loop* event_loop)
+{
+	// Pop command pointers in chunks, so the queue lock is taken once per chunk
+	// instead of once per command.
+	as_event_commander cmds[AS_EVENT_QUEUE_DRAIN_MAX];
+	uint32_t remaining = 0;
+	bool first = true;
+
+	do {
+		uint32_t n = 0;
+
+		pthread_mutex_lock(&event_loop->lock);
+
+		if (first) {
+			// Only process original size of queue.  Recursive pre-registration errors can
+			// result in new commands being added while the loop is in process.  If we process
+			// them, we could end up in an infinite loop.
+			remaining = as_queue_size(&event_loop->queue);
+			first = false;
+		}
+
+		while (n < remaining && n < AS_EVENT_QUEUE_DRAIN_MAX &&
+			   as_queue_pop(&event_loop->queue, &cmds[n])) {
+			n++;
+		}
+		pthread_mutex_unlock(&event_loop->lock);
+
+		if (n == 0) {
+			break;
+		}
+		remaining -= n;
+
+		for (uint32_t i = 0; i < n; i++) {
+			if (! cmds[i].executable) {
+				// Received stop signal.
+				as_event_close_loop(event_loop);
+				return;
+			}
+			cmds[i].executable(event_loop, cmds[i].udata);
+		}
+	} while (remaining > 0);
+}
+
 static void
 as_event_execute_from_delay_queue(as_event_loop* event_loop)
 {
@@ -573,6 +684,8 @@ as_event_create_connection(as_event_command* cmd, as_async_conn_pool* pool)
 	cmd->conn = &conn->base;
 
 	if (cmd->connect_timeout > 0) {
+		// Connect timer replaces hedge timer. Hedge is armed again when connection completes.
+		cmd->hedge_armed = false;
 		as_event_timer_stop(cmd);
 		as_event_timer_once(cmd, cmd->connect_timeout);
 	}
@@ -586,6 +699,34 @@ as_event_add_latency(as_event_command* cmd, as_latency_type type)
 	as_node_add_latency(cmd->metrics, type, elapsed);
 }
 
+static void
+as_event_hedge_arm(as_event_command* cmd)
+{
+	// Only hedge the first attempt of single record reads that have another replica.
+	// AS_POLICY_REPLICA_MASTER never hedges, as documented in as_policy_read.hedge_delay.
+	if (cmd->type != AS_ASYNC_TYPE_RECORD || cmd->hedge_delay == 0 || cmd->hedged ||
+		cmd->hedge_clone || cmd->iteration > 0 || cmd->pipe_listener ||
+		cmd->replica == AS_POLICY_REPLICA_MASTER || cmd->replica_size < 2) {
+		return;
+	}
+
+	uint32_t delay = as_node_hedge_delay(cmd->node, cmd->hedge_delay);
+
+	if (delay == 0 || (cmd->socket_timeout > 0 && delay >= cmd->socket_timeout)) {
+		return;
+	}
+
+	if (cmd->total_deadline > 0 && cf_getms() + delay >= cmd->total_deadline) {
+		return;
+	}
+
+	// Replace command timer with hedge timer. The command timer is restored when the hedge
+	// timer fires. The hedge delay is less than the remaining socket and total timeouts.
+	as_event_timer_stop(cmd);
+	as_event_timer_once(cmd, delay);
+	cmd->hedge_armed = true;
+}
+
 bool
 as_event_connection_complete(as_event_command* cmd)
 {
@@ -611,10 +752,39 @@ as_event_connection_complete(as_event_command* cmd)
 			cmd->total_deadline = cf_getms() + cmd->total_timeout;
 		}
 		as_event_set_timeout(cmd);
+		as_event_hedge_arm(cmd);
 	}
 	return false;
 }
 
+static inline bool
+as_event_track_replica_latency(as_event_command* cmd)
+{
+	if (cmd->latency_type != AS_LATENCY_TYPE_READ) {
+		return false;
+	}
+
+	return cmd->replica == AS_POLICY_REPLICA_FASTEST || (cmd->type == AS_ASYNC_TYPE_RECORD &&
+		(cmd->hedge_delay > 0 || cmd->hedge_clone));
+}
+
+static inline void
+as_event_inflight_done(as_event_command* cmd)
+{
+	if (cmd->inflight) {
+		as_decr_uint32(&cmd->node->inflight);
+		cmd->inflight = false;
+	}
+}
+
+static inline void
+as_event_add_replica_latency(as_event_command* cmd)
+{
+	if (cmd->inflight) {
+		as_node_add_replica_latency(cmd->node, cf_getns() - cmd->begin);
+	}
+}
+
 static void
 as_event_command_begin(as_event_loop* event_loop, as_event_command* cmd)
 {
@@ -623,6 +793,9 @@ as_event_command_begin(as_event_loop* event_loop, as_event_command* cmd)
 	cmd->bytes_in = 0;
 	cmd->bytes_out = 0;
 
+	// Node from prior attempt is no longer in use.
+	as_event_inflight_done(cmd);
+
 	if (cmd->partition) {
 		// If in retry, need to release node from prior attempt.
 		if (cmd->node) {
@@ -657,6 +830,16 @@ as_event_command_begin(as_event_loop* event_loop, as_event_command* cmd)
 		}
 	}
 
+	// Single record reads feed the node latency statistics used by AS_POLICY_REPLICA_FASTEST
+	// and hedged reads.
+	if (as_event_track_replica_latency(cmd)) {
+		if (! cmd->metrics) {
+			cmd->begin = cf_getns();
+		}
+		as_incr_uint32(&cmd->node->inflight);
+		cmd->inflight = true;
+	}
+
 	if (! as_node_valid_error_rate(cmd->node)) {
 		event_loop->errors++;
 
@@ -677,6 +860,8 @@ as_event_command_begin(as_event_loop* event_loop, as_event_command* cmd)
 		return;
 	}
 
+	as_event_hedge_arm(cmd);
+
 	as_async_conn_pool* pool = &cmd->node->async_conn_pools[event_loop->index];
 	as_async_connection* conn;
 
@@ -797,21 +982,21 @@ as_event_decompress(as_event_command* cmd)
 		return false;
 	}
 
-	uint8_t* buf = cf_malloc(size);
+	as_buffer_pool* pool = cmd->event_loop->buffer_pool;
+	size_t capacity;
+	uint8_t* buf = as_buffer_pool_get(pool, size, &capacity);
 
 	if (as_proto_decompress(&err, buf, size, cmd->buf, cmd->len) != AEROSPIKE_OK) {
-		cf_free(buf);
+		as_buffer_pool_put(pool, buf, capacity);
 		as_event_parse_error(cmd, &err);
 		return false;
 	}
 
-	if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-		cf_free(cmd->buf);
-	}
+	as_event_free_read_buffer(cmd);
 	cmd->buf = buf;
 	cmd->len = (uint32_t)size;
 	cmd->pos = sizeof(as_proto);
-	cmd->read_capacity = cmd->len;
+	cmd->read_capacity = (uint32_t)capacity;
 	cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
 	return true;
 }
@@ -820,6 +1005,7 @@ static void
 as_event_retry_timeout(as_event_command* cmd)
 {
 	as_node_add_timeout(cmd->node, cmd->ns, cmd->metrics);
+	as_event_add_replica_latency(cmd);
 
 	if (cmd->pipe_listener) {
 		as_pipe_timeout(cmd, true);
@@ -899,6 +1085,11 @@ as_event_delay_timeout(as_event_command* cmd)
 void
 as_event_process_timer(as_event_command* cmd)
 {
+	if (cmd->hedge_armed) {
+		as_event_hedge_fire(cmd);
+		return;
+	}
+
 	switch (cmd->state) {
 		case AS_ASYNC_STATE_REGISTERED:
 			// Start command from the beginning.
@@ -942,6 +1133,7 @@ as_event_total_timeout(as_event_command* cmd)
 {
 	// Node should not be null at this point.
 	as_node_add_timeout(cmd->node, cmd->ns, cmd->metrics);
+	as_event_add_replica_latency(cmd);
 
 	if (cmd->pipe_listener) {
 		as_pipe_timeout(cmd, false);
@@ -1010,6 +1202,7 @@ as_event_command_retry(as_event_command* cmd, bool timeout)
 	}
 
 	// Disable timeout.
+	cmd->hedge_armed = false;
 	as_event_timer_stop(cmd);
 
 	// Retry command at the end of the queue so other commands have a chance to run first.
@@ -1019,17 +1212,16 @@ as_event_command_retry(as_event_command* cmd, bool timeout)
 	return true;
 }
 
-void
-as_event_execute_retry(as_event_command* cmd)
+static bool
+as_event_restore_timer(as_event_command* cmd)
 {
-	// Restore timer that was reset for retry.
 	if (cmd->total_deadline > 0) {
 		// Check total timeout.
 		uint64_t now = cf_getms();
 
 		if (now >= cmd->total_deadline) {
 			as_event_total_timeout(cmd);
-			return;
+			return false;
 		}
 
 		uint64_t remaining = cmd->total_deadline - now;
@@ -1056,12 +1248,141 @@ as_event_execute_retry(as_event_command* cmd)
 		cmd->flags &= ~AS_ASYNC_FLAGS_EVENT_RECEIVED;
 		as_event_timer_repeat(cmd, cmd->socket_timeout);
 	}
+	return true;
+}
+
+void
+as_event_execute_retry(as_event_command* cmd)
+{
+	// Restore timer that was reset for retry.
+	if (! as_event_restore_timer(cmd)) {
+		return;
+	}
 
 	// Retry command.
 	as_cluster_add_retry(cmd->cluster);
 	as_event_command_begin(cmd->event_loop, cmd);
 }
 
+static void
+as_event_hedge_fire(as_event_command* cmd)
+{
+	cmd->hedge_armed = false;
+	cmd->hedged = true;
+
+	// Restore command timer that was replaced by the hedge timer.
+	if (! as_event_restore_timer(cmd)) {
+		return;
+	}
+
+	// Do not hedge when the response has started to arrive.
+	if (cmd->state > AS_ASYNC_STATE_COMMAND_READ_HEADER ||
+		(cmd->state == AS_ASYNC_STATE_COMMAND_READ_HEADER && cmd->pos > 0)) {
+		return;
+	}
+
+	uint8_t replica_index = cmd->replica_index + 1;
+	as_node* node = as_partition_get_node(cmd->cluster, cmd->ns, cmd->partition, cmd->node,
+										  cmd->replica, cmd->replica_size, &replica_index);
+
+	if (! node || node == cmd->node || ! as_node_valid_error_rate(node)) {
+		return;
+	}
+
+	// The hedge bypasses the delay queue in as_event_command_execute_in_loop(), so do not
+	// hedge when the event loop is already at its command limit.
+	as_event_loop* event_loop = cmd->event_loop;
+
+	if (event_loop->max_commands_in_process > 0 &&
+		event_loop->pending >= event_loop->max_commands_in_process) {
+		return;
+	}
+
+	// Copy command struct and write buffer. The copy starts on the next replica because
+	// as_event_command_begin() selects the node from the original node and incremented
+	// replica index.
+	uint32_t size = cmd->write_offset + cmd->write_len;
+	as_event_command* clone = cf_malloc(size + cmd->read_capacity);
+	memcpy(clone, cmd, size);
+
+	clone->buf = (uint8_t*)clone + size;
+
+	if (cmd->ubuf) {
+		clone->ubuf = cf_malloc(cmd->ubuf_size);
+		memcpy(clone->ubuf, cmd->ubuf, cmd->ubuf_size);
+	}
+
+	clone->state = AS_ASYNC_STATE_CONNECT;
+	clone->flags &= ~(AS_ASYNC_FLAGS_HAS_TIMER | AS_ASYNC_FLAGS_EVENT_RECEIVED |
+		AS_ASYNC_FLAGS_FREE_BUF);
+	clone->conn = NULL;
+	clone->metrics = NULL;
+	clone->begin = 0;
+	clone->proto_type_rcv = 0;
+	clone->bytes_in = 0;
+	clone->bytes_out = 0;
+	clone->inflight = false;
+	clone->hedge_clone = true;
+	clone->replica_index = cmd->replica_index + 1;
+	as_node_reserve(clone->node);
+
+	event_loop->pending++;
+	cmd->event_state->pending++;
+
+	cmd->hedge = clone;
+	clone->hedge = cmd;
+	as_cluster_add_hedge(cmd->cluster);
+
+	if (! as_event_restore_timer(clone)) {
+		return;
+	}
+	as_event_command_begin(clone->event_loop, clone);
+}
+
+static void
+as_event_hedge_cancel(as_event_command* cmd)
+{
+	as_event_command* loser = cmd->hedge;
+
+	cmd->hedge = NULL;
+	loser->hedge = NULL;
+
+	// The loser's latency is at least the time waited so far.
+	as_event_add_replica_latency(loser);
+	as_event_timer_stop(loser);
+
+	as_event_connection* conn = loser->conn;
+
+	if (conn && ! as_event_recover_connection(loser)) {
+		// Close connection. This is not a node error, so do not increment the error rate.
+		as_async_conn_pool* pool = &loser->node->async_conn_pools[loser->event_loop->index];
+
+		if (conn->watching > 0) {
+			as_event_stop_watcher(loser, conn);
+			as_event_release_async_connection((as_async_connection*)conn, pool);
+		}
+		else {
+			cf_free(conn);
+			as_queue_decr_total(&pool->queue);
+			pool->closed++;
+		}
+	}
+	as_event_command_release(loser);
+}
+
+static inline void
+as_event_hedge_complete(as_event_command* cmd)
+{
+	// First answer wins. Cancel the sibling command without notifying the user.
+	if (cmd->hedge) {
+		as_event_hedge_cancel(cmd);
+	}
+
+	if (cmd->hedge_clone) {
+		as_cluster_add_hedge_win(cmd->cluster);
+	}
+}
+
 static inline void
 as_event_put_connection(as_event_command* cmd, as_async_conn_pool* pool)
 {
@@ -1076,6 +1397,9 @@ as_event_put_connection(as_event_command* cmd, as_async_conn_pool* pool)
 void
 as_event_response_complete(as_event_command* cmd)
 {
+	as_event_add_replica_latency(cmd);
+	as_event_hedge_complete(cmd);
+
 	if (cmd->metrics) {
 		as_node_add_bytes_out(cmd->metrics, cmd->bytes_out);
 		as_node_add_bytes_in(cmd->metrics, cmd->bytes_in);
@@ -1196,6 +1520,10 @@ as_event_executor_cancel(as_event_executor* executor, uint32_t queued_count)
 	pthread_mutex_unlock(&executor->lock);
 
 	if (complete) {
+		if (executor->notify_cancel) {
+			// Caller is waiting for all queued commands to finish.
+			executor->complete_fn(executor);
+		}
 		as_event_executor_destroy(executor);
 	}
 }
@@ -1272,6 +1600,14 @@ bool as_async_query_should_retry(as_event_command* cmd, as_status status);
 void
 as_event_error_callback(as_event_command* cmd, as_error* err)
 {
+	if (cmd->hedge) {
+		// The hedge sibling is still active and will notify the user.
+		cmd->hedge->hedge = NULL;
+		cmd->hedge = NULL;
+		as_event_command_release(cmd);
+		return;
+	}
+
 	if ((cmd->type == AS_ASYNC_TYPE_SCAN_PARTITION &&
 		as_async_scan_should_retry(cmd, err->code)) ||
 	    (cmd->type == AS_ASYNC_TYPE_QUERY_PARTITION &&
@@ -1486,7 +1822,11 @@ as_event_response_error(as_event_command* cmd, as_error* err)
 			if (cmd->metrics && cmd->latency_type != AS_LATENCY_TYPE_NONE) {
 				as_event_add_latency(cmd, cmd->latency_type);
 			}
+			as_event_add_replica_latency(cmd);
 			as_event_put_connection(cmd, pool);
+
+			// Not found is an answer. Other errors let an active hedge sibling answer.
+			as_event_hedge_complete(cmd);
 			break;
 
 		case AEROSPIKE_ERR_RECORD_BUSY:
@@ -1589,7 +1929,7 @@ as_event_command_parse_result(as_event_command* cmd)
 				rec->ttl = cf_server_void_time_to_ttl(msg->record_ttl);
 
 				status = as_command_parse_bins(&p, &err, rec, msg->n_ops,
-											   cmd->flags & AS_ASYNC_FLAGS_DESERIALIZE);
+											   cmd->flags & AS_ASYNC_FLAGS_DESERIALIZE, false);
 
 				if (status == AEROSPIKE_OK) {
 					as_event_response_complete(cmd);
@@ -1615,7 +1955,7 @@ as_event_command_parse_result(as_event_command* cmd)
 				rec.ttl = cf_server_void_time_to_ttl(msg->record_ttl);
 				
 				status = as_command_parse_bins(&p, &err, &rec, msg->n_ops,
-											   cmd->flags & AS_ASYNC_FLAGS_DESERIALIZE);
+											   cmd->flags & AS_ASYNC_FLAGS_DESERIALIZE, false);
 
 				if (status == AEROSPIKE_OK) {
 					as_event_response_complete(cmd);
@@ -1767,13 +2107,17 @@ as_event_command_free(as_event_command* cmd)
 		cmd->event_state->pending--;
 	}
 
+	as_event_inflight_done(cmd);
+
+	if (cmd->hedge) {
+		cmd->hedge->hedge = NULL;
+	}
+
 	if (cmd->node) {
 		as_node_release(cmd->node);
 	}
 
-	if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-		cf_free(cmd->buf);
-	}
+	as_event_free_read_buffer(cmd);
 
 	if (cmd->ubuf) {
 		cf_free(cmd->ubuf);
@@ -2426,6 +2770,10 @@ as_event_recover_connection(as_event_command* cmd)
 	recover->timeout_delay = 0;
 	recover->bytes_in = 0;
 	recover->bytes_out = 0;
+	recover->inflight = false;
+	recover->hedge = NULL;
+	recover->hedge_armed = false;
+	recover->hedge_clone = false;
 
 	// Socket write variables should never be referenced when in a read state.
 	recover->write_offset = (uint32_t)sizeof(as_recover_command);
@@ -62,34 +62,7 @@ as_ev_wakeup(struct ev_loop* loop, ev_async* wakeup, int revents)
 {
 	// Read command pointers from queue.
 	as_event_loop* event_loop = wakeup->data;
-	as_event_commander cmd;
-	uint32_t i = 0;
-
-	// Only process original size of queue.  Recursive pre-registration errors can
-	// result in new commands being added while the loop is in process.  If we process
-	// them, we could end up in an infinite loop.
-	pthread_mutex_lock(&event_loop->lock);
-	uint32_t size = as_queue_size(&event_loop->queue);
-	bool status = as_queue_pop(&event_loop->queue, &cmd);
-	pthread_mutex_unlock(&event_loop->lock);
-
-	while (status) {
-		if (! cmd.executable) {
-			// Received stop signal.
-			as_event_close_loop(event_loop);
-			return;
-		}
-		cmd.executable(event_loop, cmd.udata);
-
-		if (++i < size) {
-			pthread_mutex_lock(&event_loop->lock);
-			status = as_queue_pop(&event_loop->queue, &cmd);
-			pthread_mutex_unlock(&event_loop->lock);
-		}
-		else {
-			break;
-		}
-	}
+	as_event_process_queue(event_loop);
 }
 
 static void*
@@ -149,6 +122,24 @@ as_event_execute(as_event_loop* event_loop, as_event_executable executable, void
 	return queued;
 }
 
+uint32_t
+as_event_execute_many(as_event_loop* event_loop, as_event_commander* cmds, uint32_t n_cmds)
+{
+	uint32_t n = 0;
+
+	pthread_mutex_lock(&event_loop->lock);
+
+	while (n < n_cmds && as_queue_push(&event_loop->queue, &cmds[n])) {
+		n++;
+	}
+	pthread_mutex_unlock(&event_loop->lock);
+
+	if (n > 0) {
+		ev_async_send(event_loop->loop, &event_loop->wakeup);
+	}
+	return n;
+}
+
 static inline void
 as_ev_watch_write(as_event_command* cmd)
 {
@@ -488,12 +479,7 @@ as_ev_command_peek_block(as_event_command* cmd)
 		// Received normal data block.  Stop reading for fairness reasons and wait
 		// till next iteration.
 		if (cmd->len > cmd->read_capacity) {
-			if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-				cf_free(cmd->buf);
-			}
-			cmd->buf = cf_malloc(size);
-			cmd->read_capacity = cmd->len;
-			cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
+			as_event_set_read_buffer(cmd, size);
 		}
 	}
 
@@ -568,12 +554,7 @@ as_ev_command_read(as_event_command* cmd)
 		cmd->state = AS_ASYNC_STATE_COMMAND_READ_BODY;
 		
 		if (cmd->len > cmd->read_capacity) {
-			if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-				cf_free(cmd->buf);
-			}
-			cmd->buf = cf_malloc(size);
-			cmd->read_capacity = cmd->len;
-			cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
+			as_event_set_read_buffer(cmd, size);
 		}
 	}
 	
@@ -75,34 +75,7 @@ as_event_wakeup(evutil_socket_t socket, short revents, void* udata)
 {
 	// Read command pointers from queue.
 	as_event_loop* event_loop = udata;
-	as_event_commander cmd;
-	uint32_t i = 0;
-
-	// Only process original size of queue.  Recursive pre-registration errors can
-	// result in new commands being added while the loop is in process.  If we process
-	// them, we could end up in an infinite loop.
-	pthread_mutex_lock(&event_loop->lock);
-	uint32_t size = as_queue_size(&event_loop->queue);
-	bool status = as_queue_pop(&event_loop->queue, &cmd);
-	pthread_mutex_unlock(&event_loop->lock);
-
-	while (status) {
-		if (! cmd.executable) {
-			// Received stop signal.
-			as_event_close_loop(event_loop);
-			return;
-		}
-		cmd.executable(event_loop, cmd.udata);
-
-		if (++i < size) {
-			pthread_mutex_lock(&event_loop->lock);
-			status = as_queue_pop(&event_loop->queue, &cmd);
-			pthread_mutex_unlock(&event_loop->lock);
-		}
-		else {
-			break;
-		}
-	}
+	as_event_process_queue(event_loop);
 }
 
 static void*
@@ -227,6 +200,33 @@ as_event_execute(as_event_loop* event_loop, as_event_executable executable, void
 	return queued;
 }
 
+uint32_t
+as_event_execute_many(as_event_loop* event_loop, as_event_commander* cmds, uint32_t n_cmds)
+{
+	// Cross thread command queueing is not allowed in libevent single thread mode.
+	if (as_event_single_thread) {
+		as_log_error("Cross thread command queueing not allowed in single thread mode");
+		return 0;
+	}
+
+	uint32_t n = 0;
+
+	pthread_mutex_lock(&event_loop->lock);
+
+	while (n < n_cmds && as_queue_push(&event_loop->queue, &cmds[n])) {
+		n++;
+	}
+	pthread_mutex_unlock(&event_loop->lock);
+
+	if (n > 0) {
+		if (! evtimer_pending(&event_loop->wakeup, NULL)) {
+			event_del(&event_loop->wakeup);
+			evtimer_add(&event_loop->wakeup, &as_immediate_tv);
+		}
+	}
+	return n;
+}
+
 static inline void
 as_event_watch(as_event_command* cmd, int watch)
 {
@@ -568,12 +568,7 @@ as_event_command_peek_block(as_event_command* cmd)
 		// Received normal data block.  Stop reading for fairness reasons and wait
 		// till next iteration.
 		if (cmd->len > cmd->read_capacity) {
-			if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-				cf_free(cmd->buf);
-			}
-			cmd->buf = cf_malloc(size);
-			cmd->read_capacity = cmd->len;
-			cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
+			as_event_set_read_buffer(cmd, size);
 		}
 	}
 
@@ -648,12 +643,7 @@ as_event_command_read(as_event_command* cmd)
 		cmd->state = AS_ASYNC_STATE_COMMAND_READ_BODY;
 		
 		if (cmd->len > cmd->read_capacity) {
-			if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-				cf_free(cmd->buf);
-			}
-			cmd->buf = cf_malloc(size);
-			cmd->read_capacity = cmd->len;
-			cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
+			as_event_set_read_buffer(cmd, size);
 		}
 	}
 	
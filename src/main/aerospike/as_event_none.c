@@ -34,12 +34,23 @@ as_event_register_external_loop(as_event_loop* event_loop)
 {
 }
 
+void
+as_event_close_loop(as_event_loop* event_loop)
+{
+}
+
 bool
 as_event_execute(as_event_loop* event_loop, as_event_executable executable, void* udata)
 {
 	return false;
 }
 
+uint32_t
+as_event_execute_many(as_event_loop* event_loop, as_event_commander* cmds, uint32_t n_cmds)
+{
+	return 0;
+}
+
 void
 as_event_command_write_start(as_event_command* cmd)
 {
@@ -0,0 +1,1688 @@
+/*
+ * Copyright 2008-2026 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/as_event.h>
+#include <aerospike/as_event_internal.h>
+#include <aerospike/as_admin.h>
+#include <aerospike/as_async.h>
+#include <aerospike/as_atomic.h>
+#include <aerospike/as_log_macros.h>
+#include <aerospike/as_pipe.h>
+#include <aerospike/as_proto.h>
+#include <aerospike/as_socket.h>
+#include <aerospike/as_status.h>
+#include <aerospike/as_thread.h>
+#include <aerospike/as_tls.h>
+#include <citrusleaf/alloc.h>
+#include <citrusleaf/cf_byte_order.h>
+#include <citrusleaf/cf_clock.h>
+
+//---------------------------------
+// Globals
+//---------------------------------
+
+extern int as_event_send_buffer_size;
+extern int as_event_recv_buffer_size;
+extern bool as_event_threads_created;
+
+//---------------------------------
+// Liburing Functions
+//---------------------------------
+
+#if defined(AS_USE_LIBURING)
+
+// io_uring_setup_buf_ring() and io_uring_free_buf_ring() were added in liburing 2.4, which is
+// also the first release that defines the version macros.
+#if !defined(IO_URING_VERSION_MAJOR) || IO_URING_VERSION_MAJOR < 2 || \
+	(IO_URING_VERSION_MAJOR == 2 && IO_URING_VERSION_MINOR < 4)
+#error "liburing 2.4 or later is required"
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+
+#define AS_URING_ENTRIES 1024
+#define AS_URING_TIMERS_INITIAL_CAPACITY 256
+
+// Operation type is stored in low bits of completion user data.
+// Connections and event loop state are allocated on the heap and are at least 8 byte aligned.
+#define AS_URING_OP_MASK 7
+#define AS_URING_OP_CANCEL 0
+#define AS_URING_OP_WAKEUP 1
+#define AS_URING_OP_RECV 2
+#define AS_URING_OP_SEND 3
+#define AS_URING_OP_POLL_IN 4
+#define AS_URING_OP_POLL_OUT 5
+
+#define AS_URING_READ 1
+#define AS_URING_WRITE 2
+
+#define AS_EVENT_WRITE_COMPLETE 0
+#define AS_EVENT_WRITE_INCOMPLETE 1
+#define AS_EVENT_WRITE_ERROR 2
+
+#define AS_EVENT_READ_COMPLETE 3
+#define AS_EVENT_READ_INCOMPLETE 4
+#define AS_EVENT_READ_ERROR 5
+
+#define AS_EVENT_TLS_NEED_READ 6
+#define AS_EVENT_TLS_NEED_WRITE 7
+
+#define AS_EVENT_COMMAND_DONE 8
+
+static inline uint64_t
+as_uring_data(void* ptr, uint64_t op)
+{
+	return (uint64_t)(uintptr_t)ptr | op;
+}
+
+static inline struct io_uring_sqe*
+as_uring_get_sqe(as_uring_loop* uring)
+{
+	struct io_uring_sqe* sqe = io_uring_get_sqe(&uring->ring);
+
+	if (! sqe) {
+		// Submission queue is full. Submit queued entries to make room.
+		io_uring_submit(&uring->ring);
+		sqe = io_uring_get_sqe(&uring->ring);
+
+		if (! sqe) {
+			as_log_error("io_uring submission queue full");
+		}
+	}
+	return sqe;
+}
+
+//---------------------------------
+// Timers
+//---------------------------------
+
+static inline void
+as_uring_timer_set(as_uring_loop* uring, uint32_t index, as_uring_timer* timer)
+{
+	uring->timers[index] = timer;
+	timer->index = index;
+}
+
+static void
+as_uring_timer_up(as_uring_loop* uring, uint32_t index)
+{
+	as_uring_timer* timer = uring->timers[index];
+
+	while (index > 0) {
+		uint32_t parent = (index - 1) / 2;
+
+		if (uring->timers[parent]->deadline <= timer->deadline) {
+			break;
+		}
+		as_uring_timer_set(uring, index, uring->timers[parent]);
+		index = parent;
+	}
+	as_uring_timer_set(uring, index, timer);
+}
+
+static void
+as_uring_timer_down(as_uring_loop* uring, uint32_t index)
+{
+	as_uring_timer* timer = uring->timers[index];
+	uint32_t size = uring->timers_size;
+
+	while (true) {
+		uint32_t child = index * 2 + 1;
+
+		if (child >= size) {
+			break;
+		}
+
+		if (child + 1 < size && uring->timers[child + 1]->deadline < uring->timers[child]->deadline) {
+			child++;
+		}
+
+		if (timer->deadline <= uring->timers[child]->deadline) {
+			break;
+		}
+		as_uring_timer_set(uring, index, uring->timers[child]);
+		index = child;
+	}
+	as_uring_timer_set(uring, index, timer);
+}
+
+static void
+as_uring_timer_remove(as_uring_loop* uring, as_uring_timer* timer)
+{
+	uint32_t index = timer->index;
+	uint32_t last = --uring->timers_size;
+
+	timer->index = AS_URING_TIMER_NONE;
+
+	if (index == last) {
+		return;
+	}
+
+	as_uring_timer_set(uring, index, uring->timers[last]);
+	as_uring_timer_down(uring, index);
+	as_uring_timer_up(uring, uring->timers[index]->index);
+}
+
+static void
+as_uring_timer_insert(as_uring_loop* uring, as_uring_timer* timer)
+{
+	if (uring->timers_size == uring->timers_capacity) {
+		uring->timers_capacity *= 2;
+		uring->timers = cf_realloc(uring->timers, sizeof(as_uring_timer*) * uring->timers_capacity);
+	}
+	uint32_t index = uring->timers_size++;
+	as_uring_timer_set(uring, index, timer);
+	as_uring_timer_up(uring, index);
+}
+
+void
+as_uring_timer_start(as_event_loop* event_loop, as_uring_timer* timer, uint64_t timeout, uint64_t repeat)
+{
+	as_uring_loop* uring = event_loop->uring;
+
+	if (timer->index != AS_URING_TIMER_NONE) {
+		as_uring_timer_remove(uring, timer);
+	}
+	timer->deadline = cf_getms() + timeout;
+	timer->repeat = repeat;
+	as_uring_timer_insert(uring, timer);
+}
+
+void
+as_uring_timer_stop(as_event_loop* event_loop, as_uring_timer* timer)
+{
+	if (timer->index != AS_URING_TIMER_NONE) {
+		as_uring_timer_remove(event_loop->uring, timer);
+	}
+}
+
+static int64_t
+as_uring_timer_wait(as_uring_loop* uring)
+{
+	if (uring->timers_size == 0) {
+		return -1;
+	}
+
+	uint64_t deadline = uring->timers[0]->deadline;
+	uint64_t now = cf_getms();
+	return (deadline > now)? (int64_t)(deadline - now) : 0;
+}
+
+static void
+as_uring_timer_expire(as_event_loop* event_loop)
+{
+	as_uring_loop* uring = event_loop->uring;
+	uint64_t now = cf_getms();
+
+	// Only fire timers that were due when this pass started. Timers started with a zero
+	// timeout during the pass run in the next loop iteration.
+	uint32_t max = uring->timers_size;
+
+	for (uint32_t i = 0; i < max && uring->timers_size > 0 && ! uring->closed; i++) {
+		as_uring_timer* timer = uring->timers[0];
+
+		if (timer->deadline > now) {
+			break;
+		}
+
+		as_uring_timer_remove(uring, timer);
+
+		if (timer->repeat) {
+			// Socket timers repeat until stopped.
+			timer->deadline = now + timer->repeat;
+			as_uring_timer_insert(uring, timer);
+			as_event_socket_timeout(timer->data);
+		}
+		else {
+			as_event_process_timer(timer->data);
+		}
+	}
+}
+
+//---------------------------------
+// Receive Buffers
+//---------------------------------
+
+static inline void
+as_uring_recv_recycle(as_uring_loop* uring, uint16_t bid)
+{
+	io_uring_buf_ring_add(uring->recv_ring, uring->recv_bufs + (size_t)bid * AS_URING_RECV_SIZE,
+		AS_URING_RECV_SIZE, bid, io_uring_buf_ring_mask(AS_URING_RECV_COUNT), 0);
+	io_uring_buf_ring_advance(uring->recv_ring, 1);
+}
+
+static inline void
+as_uring_stage(as_uring_loop* uring, as_event_connection* conn, uint16_t bid, uint32_t len)
+{
+	uring->recv_len[bid] = (uint16_t)len;
+	uring->recv_next[bid] = AS_URING_BUF_NONE;
+
+	if (conn->stage_head == AS_URING_BUF_NONE) {
+		conn->stage_head = bid;
+		conn->stage_offset = 0;
+	}
+	else {
+		uring->recv_next[conn->stage_tail] = bid;
+	}
+	conn->stage_tail = bid;
+	conn->staged += len;
+}
+
+static uint32_t
+as_uring_unstage(as_uring_loop* uring, as_event_connection* conn, uint8_t* buf, uint32_t size)
+{
+	uint32_t total = 0;
+
+	while (total < size && conn->stage_head != AS_URING_BUF_NONE) {
+		uint16_t bid = conn->stage_head;
+		uint32_t avail = uring->recv_len[bid] - conn->stage_offset;
+		uint32_t len = size - total;
+
+		if (len > avail) {
+			len = avail;
+		}
+
+		memcpy(buf + total, uring->recv_bufs + (size_t)bid * AS_URING_RECV_SIZE +
+			conn->stage_offset, len);
+		total += len;
+		conn->stage_offset += len;
+
+		if (conn->stage_offset == uring->recv_len[bid]) {
+			// Buffer consumed. Give it back to the kernel.
+			conn->stage_head = uring->recv_next[bid];
+			conn->stage_offset = 0;
+			as_uring_recv_recycle(uring, bid);
+		}
+	}
+	conn->staged -= total;
+	return total;
+}
+
+static void
+as_uring_unstage_all(as_uring_loop* uring, as_event_connection* conn)
+{
+	while (conn->stage_head != AS_URING_BUF_NONE) {
+		uint16_t bid = conn->stage_head;
+		conn->stage_head = uring->recv_next[bid];
+		as_uring_recv_recycle(uring, bid);
+	}
+	conn->staged = 0;
+	conn->stage_offset = 0;
+}
+
+static inline uint32_t
+as_uring_read_pending(as_event_connection* conn)
+{
+	return conn->socket.tls ? (uint32_t)as_tls_read_pending(&conn->socket) : conn->staged;
+}
+
+//---------------------------------
+// Operations
+//---------------------------------
+
+static inline void
+as_uring_arm_wakeup(as_uring_loop* uring)
+{
+	struct io_uring_sqe* sqe = as_uring_get_sqe(uring);
+
+	if (sqe) {
+		io_uring_prep_read(sqe, uring->wakeup_fd, &uring->wakeup_value, sizeof(uint64_t), 0);
+		io_uring_sqe_set_data64(sqe, as_uring_data(uring, AS_URING_OP_WAKEUP));
+	}
+}
+
+static inline void
+as_uring_arm_recv(as_uring_loop* uring, as_event_connection* conn)
+{
+	if (conn->flags & (AS_URING_CONN_RECV | AS_URING_CONN_EOF | AS_URING_CONN_CLOSED |
+		AS_URING_CONN_CONNECTING) || conn->socket.tls) {
+		return;
+	}
+
+	struct io_uring_sqe* sqe = as_uring_get_sqe(uring);
+
+	if (! sqe) {
+		return;
+	}
+
+	// Multishot receive stays armed across responses and picks buffers from the loop's
+	// receive buffer ring, so reads do not require a system call per socket event.
+	io_uring_prep_recv_multishot(sqe, conn->socket.fd, NULL, 0, 0);
+	sqe->flags |= IOSQE_BUFFER_SELECT;
+	sqe->buf_group = AS_URING_RECV_GROUP;
+	io_uring_sqe_set_data64(sqe, as_uring_data(conn, AS_URING_OP_RECV));
+	conn->flags |= AS_URING_CONN_RECV;
+}
+
+static inline void
+as_uring_arm_poll(as_uring_loop* uring, as_event_connection* conn, uint16_t flag)
+{
+	if (conn->flags & (flag | AS_URING_CONN_CLOSED)) {
+		return;
+	}
+
+	struct io_uring_sqe* sqe = as_uring_get_sqe(uring);
+
+	if (! sqe) {
+		return;
+	}
+
+	if (flag == AS_URING_CONN_POLL_IN) {
+		io_uring_prep_poll_add(sqe, conn->socket.fd, POLLIN);
+		io_uring_sqe_set_data64(sqe, as_uring_data(conn, AS_URING_OP_POLL_IN));
+	}
+	else {
+		io_uring_prep_poll_add(sqe, conn->socket.fd, POLLOUT);
+		io_uring_sqe_set_data64(sqe, as_uring_data(conn, AS_URING_OP_POLL_OUT));
+	}
+	conn->flags |= flag;
+}
+
+static inline void
+as_uring_cancel(as_uring_loop* uring, as_event_connection* conn, uint16_t flag, uint64_t op)
+{
+	if (!(conn->flags & flag)) {
+		return;
+	}
+
+	struct io_uring_sqe* sqe = as_uring_get_sqe(uring);
+
+	if (sqe) {
+		io_uring_prep_cancel64(sqe, as_uring_data(conn, op), 0);
+		io_uring_sqe_set_data64(sqe, AS_URING_OP_CANCEL);
+	}
+}
+
+static void
+as_uring_watch(as_event_command* cmd, int watch)
+{
+	as_event_connection* conn = cmd->conn;
+	as_uring_loop* uring = cmd->event_loop->uring;
+
+	conn->watching = watch;
+
+	if (conn->socket.tls || (conn->flags & AS_URING_CONN_CONNECTING)) {
+		// TLS and socket connect use readiness polling.
+		if (watch & AS_URING_READ) {
+			as_uring_arm_poll(uring, conn, AS_URING_CONN_POLL_IN);
+		}
+
+		if (watch & AS_URING_WRITE) {
+			as_uring_arm_poll(uring, conn, AS_URING_CONN_POLL_OUT);
+		}
+	}
+	else if (watch & AS_URING_READ) {
+		as_uring_arm_recv(uring, conn);
+	}
+}
+
+static inline void
+as_uring_watch_write(as_event_command* cmd)
+{
+	as_uring_watch(cmd, cmd->pipe_listener != NULL ? AS_URING_WRITE | AS_URING_READ : AS_URING_WRITE);
+}
+
+static inline void
+as_uring_watch_read(as_event_command* cmd)
+{
+	as_uring_watch(cmd, AS_URING_READ);
+}
+
+static void
+as_uring_conn_free(as_uring_loop* uring, as_event_connection* conn)
+{
+	// Connection can only be freed after all operations referencing it have completed.
+	if (conn->flags & AS_URING_CONN_OPS || uring->current == conn) {
+		return;
+	}
+	uring->closing--;
+	cf_free(conn);
+}
+
+void
+as_event_close_connection(as_event_connection* conn)
+{
+	as_uring_loop* uring = conn->event_loop->uring;
+
+	conn->watching = 0;
+	conn->flags |= AS_URING_CONN_CLOSED;
+	uring->closing++;
+
+	// Cancel operations still in flight. The connection is freed when their completions
+	// arrive.
+	as_uring_cancel(uring, conn, AS_URING_CONN_RECV, AS_URING_OP_RECV);
+	as_uring_cancel(uring, conn, AS_URING_CONN_SEND, AS_URING_OP_SEND);
+	as_uring_cancel(uring, conn, AS_URING_CONN_POLL_IN, AS_URING_OP_POLL_IN);
+	as_uring_cancel(uring, conn, AS_URING_CONN_POLL_OUT, AS_URING_OP_POLL_OUT);
+
+	as_uring_unstage_all(uring, conn);
+	as_socket_close(&conn->socket);
+	as_uring_conn_free(uring, conn);
+}
+
+//---------------------------------
+// Socket IO
+//---------------------------------
+
+static int
+as_uring_send(as_event_command* cmd)
+{
+	as_event_connection* conn = cmd->conn;
+
+	if (conn->flags & AS_URING_CONN_SEND) {
+		// Previous send has not completed.
+		return AS_EVENT_WRITE_INCOMPLETE;
+	}
+
+	as_uring_loop* uring = cmd->event_loop->uring;
+	struct io_uring_sqe* sqe = as_uring_get_sqe(uring);
+
+	if (! sqe) {
+		if (! as_event_socket_retry(cmd)) {
+			as_error err;
+			as_error_set_message(&err, AEROSPIKE_ERR_ASYNC_CONNECTION, "io_uring submission queue full");
+			as_event_socket_error(cmd, &err);
+		}
+		return AS_EVENT_WRITE_ERROR;
+	}
+
+	uint8_t* buf = (uint8_t*)cmd + cmd->write_offset + cmd->pos;
+	uint32_t size = cmd->len - cmd->pos;
+
+	// Copy to a buffer owned by the connection, so the kernel never references command
+	// memory that can be freed by a timeout while the send is in flight.
+	if (size <= AS_URING_SEND_SIZE && uring->send_free_size > 0) {
+		conn->send_slot = uring->send_free[--uring->send_free_size];
+		conn->send_buf = uring->send_bufs + (size_t)conn->send_slot * AS_URING_SEND_SIZE;
+	}
+	else {
+		conn->send_slot = AS_URING_BUF_NONE;
+		conn->send_buf = cf_malloc(size);
+	}
+	memcpy(conn->send_buf, buf, size);
+
+	io_uring_prep_send(sqe, conn->socket.fd, conn->send_buf, size, MSG_NOSIGNAL);
+	io_uring_sqe_set_data64(sqe, as_uring_data(conn, AS_URING_OP_SEND));
+	conn->flags |= AS_URING_CONN_SEND;
+	return AS_EVENT_WRITE_INCOMPLETE;
+}
+
+static int
+as_uring_write(as_event_command* cmd)
+{
+	if (! cmd->conn->socket.tls) {
+		// Completion is handled in as_uring_send_complete().
+		return as_uring_send(cmd);
+	}
+
+	uint8_t* buf = (uint8_t*)cmd + cmd->write_offset;
+
+	do {
+		int rv = as_tls_write_once(&cmd->conn->socket, buf + cmd->pos, cmd->len - cmd->pos);
+		if (rv > 0) {
+			as_uring_watch_write(cmd);
+			cmd->pos += rv;
+			cmd->bytes_out += rv;
+			continue;
+		}
+		else if (rv == -1) {
+			// TLS sometimes need to read even when we are writing.
+			as_uring_watch_read(cmd);
+			return AS_EVENT_TLS_NEED_READ;
+		}
+		else if (rv == -2) {
+			// TLS wants a write, we're all set for that.
+			as_uring_watch_write(cmd);
+			return AS_EVENT_WRITE_INCOMPLETE;
+		}
+		else if (rv < -2) {
+			if (! as_event_socket_retry(cmd)) {
+				as_error err;
+				as_socket_error(cmd->conn->socket.fd, cmd->node, &err, AEROSPIKE_ERR_TLS_ERROR, "TLS write failed", rv);
+				as_event_socket_error(cmd, &err);
+			}
+			return AS_EVENT_WRITE_ERROR;
+		}
+		// as_tls_write_once can't return 0
+	} while (cmd->pos < cmd->len);
+
+	// Socket timeout applies only to read events.
+	// Reset event received because we are switching from a write to a read state.
+	cmd->flags &= ~AS_ASYNC_FLAGS_EVENT_RECEIVED;
+	return AS_EVENT_WRITE_COMPLETE;
+}
+
+static int
+as_uring_read(as_event_command* cmd)
+{
+	cmd->flags |= AS_ASYNC_FLAGS_EVENT_RECEIVED;
+
+	as_event_connection* conn = cmd->conn;
+
+	if (conn->socket.tls) {
+		do {
+			int rv = as_tls_read_once(&conn->socket, cmd->buf + cmd->pos, cmd->len - cmd->pos);
+			if (rv > 0) {
+				as_uring_watch_read(cmd);
+				cmd->pos += rv;
+				cmd->bytes_in += rv;
+				continue;
+			}
+			else if (rv == -1) {
+				// TLS wants a read
+				as_uring_watch_read(cmd);
+				return AS_EVENT_READ_INCOMPLETE;
+			}
+			else if (rv == -2) {
+				// TLS sometimes needs to write, even when the app is reading.
+				as_uring_watch_write(cmd);
+				return AS_EVENT_TLS_NEED_WRITE;
+			}
+			else if (rv < -2) {
+				if (! as_event_socket_retry(cmd)) {
+					as_error err;
+					as_socket_error(conn->socket.fd, cmd->node, &err, AEROSPIKE_ERR_TLS_ERROR, "TLS read failed", rv);
+					as_event_socket_error(cmd, &err);
+				}
+				return AS_EVENT_READ_ERROR;
+			}
+			// as_tls_read_once doesn't return 0
+		} while (cmd->pos < cmd->len);
+
+		return AS_EVENT_READ_COMPLETE;
+	}
+
+	uint32_t bytes = as_uring_unstage(cmd->event_loop->uring, conn, cmd->buf + cmd->pos,
+		cmd->len - cmd->pos);
+
+	cmd->pos += bytes;
+	cmd->bytes_in += bytes;
+
+	if (cmd->pos == cmd->len) {
+		return AS_EVENT_READ_COMPLETE;
+	}
+
+	if (conn->flags & AS_URING_CONN_EOF) {
+		if (! as_event_socket_retry(cmd)) {
+			as_error err;
+
+			if (conn->error) {
+				as_socket_error(conn->socket.fd, cmd->node, &err, AEROSPIKE_ERR_ASYNC_CONNECTION, "Socket read failed", conn->error);
+			}
+			else {
+				as_socket_error(conn->socket.fd, cmd->node, &err, AEROSPIKE_ERR_ASYNC_CONNECTION, "Socket read closed by peer", 0);
+			}
+			as_event_socket_error(cmd, &err);
+		}
+		return AS_EVENT_READ_ERROR;
+	}
+
+	as_uring_watch_read(cmd);
+	return AS_EVENT_READ_INCOMPLETE;
+}
+
+//---------------------------------
+// Command State Machine
+//---------------------------------
+
+static inline void
+as_uring_command_read_start(as_event_command* cmd)
+{
+	cmd->command_sent_counter++;
+	cmd->len = sizeof(as_proto);
+	cmd->pos = 0;
+	cmd->state = AS_ASYNC_STATE_COMMAND_READ_HEADER;
+
+	as_uring_watch_read(cmd);
+
+	if (cmd->pipe_listener != NULL) {
+		as_pipe_read_start(cmd);
+	}
+}
+
+static inline void
+as_uring_command_write(as_event_command* cmd)
+{
+	as_uring_watch_write(cmd);
+
+	if (as_uring_write(cmd) == AS_EVENT_WRITE_COMPLETE) {
+		// Done with write. Register for read.
+		as_uring_command_read_start(cmd);
+	}
+}
+
+void
+as_event_command_write_start(as_event_command* cmd)
+{
+	cmd->state = AS_ASYNC_STATE_COMMAND_WRITE;
+	as_event_set_write(cmd);
+	as_uring_command_write(cmd);
+}
+
+static int
+as_uring_command_start(as_event_command* cmd)
+{
+	if (as_event_connection_complete(cmd)) {
+		return AS_EVENT_COMMAND_DONE;
+	}
+
+	as_event_command_write_start(cmd);
+	return AS_EVENT_READ_COMPLETE;
+}
+
+static inline void
+as_uring_command_auth_write(as_event_command* cmd)
+{
+	as_uring_watch_write(cmd);
+
+	if (as_uring_write(cmd) == AS_EVENT_WRITE_COMPLETE) {
+		// Done with auth write. Register for auth read.
+		as_event_set_auth_read_header(cmd);
+		as_uring_watch_read(cmd);
+	}
+}
+
+static void
+as_uring_write_complete(as_event_command* cmd)
+{
+	// Socket timeout applies only to read events.
+	// Reset event received because we are switching from a write to a read state.
+	cmd->flags &= ~AS_ASYNC_FLAGS_EVENT_RECEIVED;
+
+	if (cmd->state == AS_ASYNC_STATE_AUTH_WRITE) {
+		as_event_set_auth_read_header(cmd);
+		as_uring_watch_read(cmd);
+	}
+	else {
+		as_uring_command_read_start(cmd);
+	}
+}
+
+static void
+as_uring_connect_complete(as_event_command* cmd)
+{
+	if (cmd->cluster->auth_enabled) {
+		as_session* session = as_session_load(&cmd->node->session);
+
+		if (session) {
+			as_incr_uint32(&session->ref_count);
+			as_event_set_auth_write(cmd, session);
+			as_session_release(session);
+
+			cmd->state = AS_ASYNC_STATE_AUTH_WRITE;
+			as_uring_command_auth_write(cmd);
+		}
+		else {
+			as_uring_command_start(cmd);
+		}
+	}
+	else {
+		as_uring_command_start(cmd);
+	}
+}
+
+static int
+as_uring_command_peek_block(as_event_command* cmd)
+{
+	// Batch, scan, query may be waiting on end block.
+	// Prepare for next message block.
+	cmd->len = sizeof(as_proto);
+	cmd->pos = 0;
+	cmd->state = AS_ASYNC_STATE_COMMAND_READ_HEADER;
+
+	int rv = as_uring_read(cmd);
+	if (rv != AS_EVENT_READ_COMPLETE) {
+		return rv;
+	}
+
+	as_proto* proto = (as_proto*)cmd->buf;
+
+	if (! as_event_proto_parse(cmd, proto)) {
+		return AS_EVENT_READ_ERROR;
+	}
+
+	size_t size = proto->sz;
+
+	cmd->len = (uint32_t)size;
+	cmd->pos = 0;
+	cmd->state = AS_ASYNC_STATE_COMMAND_READ_BODY;
+
+	// Check for end block size.
+	if (cmd->len == sizeof(as_msg) && cmd->proto_type_rcv != AS_COMPRESSED_MESSAGE_TYPE) {
+		// Look like we received end block.  Read and parse to make sure.
+		rv = as_uring_read(cmd);
+		if (rv != AS_EVENT_READ_COMPLETE) {
+			return rv;
+		}
+		cmd->pos = 0;
+
+		if (! cmd->parse_results(cmd)) {
+			// We did not finish after all. Prepare to read next header.
+			cmd->len = sizeof(as_proto);
+			cmd->pos = 0;
+			cmd->state = AS_ASYNC_STATE_COMMAND_READ_HEADER;
+		}
+		else {
+			return AS_EVENT_COMMAND_DONE;
+		}
+	}
+	else {
+		// Received normal data block.  Stop reading for fairness reasons and wait
+		// till next iteration.
+		if (cmd->len > cmd->read_capacity) {
+			as_event_set_read_buffer(cmd, size);
+		}
+	}
+
+	return AS_EVENT_READ_COMPLETE;
+}
+
+static int
+as_uring_parse_authentication(as_event_command* cmd)
+{
+	int rv;
+	if (cmd->state == AS_ASYNC_STATE_AUTH_READ_HEADER) {
+		// Read response length
+		rv = as_uring_read(cmd);
+		if (rv != AS_EVENT_READ_COMPLETE) {
+			return rv;
+		}
+
+		if (! as_event_set_auth_parse_header(cmd)) {
+			return AS_EVENT_READ_ERROR;
+		}
+
+		if (cmd->len > cmd->read_capacity) {
+			as_error err;
+			as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Authenticate response size is corrupt: %u", cmd->len);
+			as_event_parse_error(cmd, &err);
+			return AS_EVENT_READ_ERROR;
+		}
+	}
+
+	rv = as_uring_read(cmd);
+	if (rv != AS_EVENT_READ_COMPLETE) {
+		return rv;
+	}
+
+	// Parse authentication response.
+	uint8_t code = cmd->buf[AS_ASYNC_AUTH_RETURN_CODE];
+
+	if (code && code != AEROSPIKE_SECURITY_NOT_ENABLED) {
+		// Can't authenticate socket, so must close it.
+		as_node_signal_login(cmd->node);
+		as_error err;
+		as_error_update(&err, code, "Authentication failed: %s", as_error_string(code));
+		as_event_parse_error(cmd, &err);
+		return AS_EVENT_READ_ERROR;
+	}
+
+	return as_uring_command_start(cmd);
+}
+
+static int
+as_uring_command_read(as_event_command* cmd)
+{
+	int rv;
+
+	if (cmd->state == AS_ASYNC_STATE_COMMAND_READ_HEADER) {
+		// Read response length
+		rv = as_uring_read(cmd);
+		if (rv != AS_EVENT_READ_COMPLETE) {
+			return rv;
+		}
+
+		as_proto* proto = (as_proto*)cmd->buf;
+
+		if (! as_event_proto_parse(cmd, proto)) {
+			return AS_EVENT_READ_ERROR;
+		}
+
+		size_t size = proto->sz;
+
+		cmd->len = (uint32_t)size;
+		cmd->pos = 0;
+		cmd->state = AS_ASYNC_STATE_COMMAND_READ_BODY;
+
+		if (cmd->len > cmd->read_capacity) {
+			as_event_set_read_buffer(cmd, size);
+		}
+	}
+
+	// Read response body
+	rv = as_uring_read(cmd);
+	if (rv != AS_EVENT_READ_COMPLETE) {
+		return rv;
+	}
+	cmd->pos = 0;
+
+	if (cmd->proto_type_rcv == AS_COMPRESSED_MESSAGE_TYPE) {
+		if (! as_event_decompress(cmd)) {
+			return AS_EVENT_READ_ERROR;
+		}
+	}
+
+	if (! cmd->parse_results(cmd)) {
+		// Batch, scan, query is not finished.
+		return as_uring_command_peek_block(cmd);
+	}
+
+	return AS_EVENT_COMMAND_DONE;
+}
+
+static bool
+as_uring_tls_connect(as_event_command* cmd, as_event_connection* conn)
+{
+	int rv = as_tls_connect_once(&conn->socket);
+
+	if (rv < -2) {
+		if (! as_event_socket_retry(cmd)) {
+			// Failed, error has been logged.
+			as_error err;
+			as_error_set_message(&err, AEROSPIKE_ERR_TLS_ERROR, "TLS connection failed");
+			as_event_socket_error(cmd, &err);
+		}
+		return false;
+	}
+
+	if (rv == -1) {
+		// TLS needs a read.
+		as_uring_watch_read(cmd);
+		return true;
+	}
+
+	if (rv == -2) {
+		// TLS needs a write.
+		as_uring_watch_write(cmd);
+		return true;
+	}
+
+	if (rv == 0) {
+		if (! as_event_socket_retry(cmd)) {
+			as_error err;
+			as_error_set_message(&err, AEROSPIKE_ERR_TLS_ERROR, "TLS connection shutdown");
+			as_event_socket_error(cmd, &err);
+		}
+		return false;
+	}
+
+	// TLS connection established.
+	as_uring_connect_complete(cmd);
+	return false;
+}
+
+static void
+as_uring_callback_common(as_event_command* cmd, as_event_connection* conn)
+{
+	switch (cmd->state) {
+	case AS_ASYNC_STATE_CONNECT:
+		conn->flags &= ~AS_URING_CONN_CONNECTING;
+		as_uring_connect_complete(cmd);
+		break;
+
+	case AS_ASYNC_STATE_TLS_CONNECT:
+		conn->flags &= ~AS_URING_CONN_CONNECTING;
+
+		do {
+			if (! as_uring_tls_connect(cmd, conn)) {
+				return;
+			}
+		} while (as_tls_read_pending(&cmd->conn->socket) > 0);
+		break;
+
+	case AS_ASYNC_STATE_AUTH_WRITE:
+		// Non-TLS writes are driven by send completions.
+		if (conn->socket.tls) {
+			as_uring_command_auth_write(cmd);
+		}
+		break;
+
+	case AS_ASYNC_STATE_AUTH_READ_HEADER:
+	case AS_ASYNC_STATE_AUTH_READ_BODY:
+		// Loop until there are no bytes left in the TLS decryption buffer or the staged
+		// receive buffers because we won't get another completion for them.
+		do {
+			switch (as_uring_parse_authentication(cmd)) {
+				case AS_EVENT_COMMAND_DONE:
+				case AS_EVENT_READ_ERROR:
+					// Do not touch cmd again because it's been deallocated.
+					return;
+
+				case AS_EVENT_READ_COMPLETE:
+					// Auth succeeded and the command write phase has started.
+					return;
+
+				default:
+					break;
+			}
+		} while (as_uring_read_pending(cmd->conn) > 0);
+		break;
+
+	case AS_ASYNC_STATE_COMMAND_WRITE:
+		// Non-TLS writes are driven by send completions.
+		if (conn->socket.tls) {
+			as_uring_command_write(cmd);
+		}
+		break;
+
+	case AS_ASYNC_STATE_COMMAND_READ_HEADER:
+	case AS_ASYNC_STATE_COMMAND_READ_BODY:
+		// Loop until there are no bytes left in the TLS decryption buffer or the staged
+		// receive buffers because we won't get another completion for them.
+		do {
+			switch (as_uring_command_read(cmd)) {
+			case AS_EVENT_COMMAND_DONE:
+			case AS_EVENT_READ_ERROR:
+				// Do not touch cmd again because it's been deallocated.
+				return;
+
+			case AS_EVENT_READ_COMPLETE:
+				as_uring_watch_read(cmd);
+				break;
+
+			default:
+				break;
+			}
+		} while (as_uring_read_pending(cmd->conn) > 0);
+		break;
+
+	default:
+		as_log_error("unexpected cmd state %d", cmd->state);
+		break;
+	}
+}
+
+static void
+as_uring_callback(as_event_connection* conn, int events)
+{
+	as_event_command* cmd;
+
+	if (events & AS_URING_READ) {
+		if (conn->pipeline) {
+			as_pipe_connection* pipe = (as_pipe_connection*)conn;
+
+			if (pipe->writer && cf_ll_size(&pipe->readers) == 0) {
+				// Authentication response will only have a writer.
+				cmd = pipe->writer;
+			}
+			else {
+				// Next response is at head of reader linked list.
+				cf_ll_element* link = cf_ll_get_head(&pipe->readers);
+
+				if (link) {
+					cmd = as_pipe_link_to_command(link);
+				}
+				else {
+					as_log_debug("Pipeline read event ignored");
+					return;
+				}
+			}
+		}
+		else {
+			cmd = ((as_async_connection*)conn)->cmd;
+		}
+	}
+	else {
+		cmd = conn->pipeline ?
+			((as_pipe_connection*)conn)->writer :
+			((as_async_connection*)conn)->cmd;
+
+		if (! cmd) {
+			return;
+		}
+	}
+
+	as_uring_callback_common(cmd, conn);
+}
+
+static void
+as_uring_process(as_uring_loop* uring, as_event_connection* conn, int events)
+{
+	// Connection can be closed by callbacks. Defer free until processing is done.
+	uring->current = conn;
+
+	if ((events & AS_URING_WRITE) && (conn->watching & AS_URING_WRITE)) {
+		as_uring_callback(conn, AS_URING_WRITE);
+	}
+
+	if ((events & AS_URING_READ) && (conn->watching & AS_URING_READ) &&
+		!(conn->flags & AS_URING_CONN_CLOSED)) {
+		as_uring_callback(conn, AS_URING_READ);
+	}
+
+	// Staged data is not signaled again, so keep dispatching while the current reader
+	// consumes it. This handles responses that arrived before the write completion and
+	// pipelined responses for the next reader.
+	while (!(conn->flags & AS_URING_CONN_CLOSED) && (conn->watching & AS_URING_READ) &&
+		   conn->staged > 0) {
+		uint32_t staged = conn->staged;
+
+		as_uring_callback(conn, AS_URING_READ);
+
+		if (conn->staged == staged) {
+			break;
+		}
+	}
+
+	uring->current = NULL;
+
+	if (conn->flags & AS_URING_CONN_CLOSED) {
+		as_uring_conn_free(uring, conn);
+		return;
+	}
+
+	if (conn->watching & AS_URING_READ) {
+		// Resume multishot receive if the kernel ended it.
+		as_uring_arm_recv(uring, conn);
+	}
+}
+
+//---------------------------------
+// Completions
+//---------------------------------
+
+static void
+as_uring_recv_complete(as_uring_loop* uring, as_event_connection* conn, struct io_uring_cqe* cqe)
+{
+	if (!(cqe->flags & IORING_CQE_F_MORE)) {
+		conn->flags &= ~AS_URING_CONN_RECV;
+	}
+
+	bool closed = (conn->flags & AS_URING_CONN_CLOSED) || uring->closed;
+
+	if (cqe->res > 0) {
+		uint16_t bid = (uint16_t)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+
+		if (closed) {
+			as_uring_recv_recycle(uring, bid);
+		}
+		else {
+			as_uring_stage(uring, conn, bid, (uint32_t)cqe->res);
+		}
+	}
+	else if (cqe->res != -ENOBUFS && ! closed) {
+		// Peer closed connection or receive failed. Staged data can still be consumed.
+		// -ENOBUFS means the buffer ring was empty. Receive is armed again when the
+		// connection is read.
+		conn->flags |= AS_URING_CONN_EOF;
+		conn->error = -cqe->res;
+	}
+
+	if (closed) {
+		if (conn->flags & AS_URING_CONN_CLOSED) {
+			as_uring_conn_free(uring, conn);
+		}
+		return;
+	}
+
+	as_uring_process(uring, conn, AS_URING_READ);
+}
+
+static void
+as_uring_send_complete(as_uring_loop* uring, as_event_connection* conn, int res)
+{
+	conn->flags &= ~AS_URING_CONN_SEND;
+
+	if (conn->send_slot != AS_URING_BUF_NONE) {
+		uring->send_free[uring->send_free_size++] = conn->send_slot;
+	}
+	else {
+		cf_free(conn->send_buf);
+	}
+	conn->send_buf = NULL;
+
+	if ((conn->flags & AS_URING_CONN_CLOSED) || uring->closed) {
+		if (conn->flags & AS_URING_CONN_CLOSED) {
+			as_uring_conn_free(uring, conn);
+		}
+		return;
+	}
+
+	if (!(conn->watching & AS_URING_WRITE)) {
+		// Command already completed or timed out.
+		return;
+	}
+
+	as_event_command* cmd = conn->pipeline ?
+		((as_pipe_connection*)conn)->writer :
+		((as_async_connection*)conn)->cmd;
+
+	if (! cmd) {
+		return;
+	}
+
+	uring->current = conn;
+
+	if (res <= 0) {
+		if (! as_event_socket_retry(cmd)) {
+			as_error err;
+
+			if (res < 0) {
+				as_socket_error(conn->socket.fd, cmd->node, &err, AEROSPIKE_ERR_ASYNC_CONNECTION, "Socket write failed", -res);
+			}
+			else {
+				as_socket_error(conn->socket.fd, cmd->node, &err, AEROSPIKE_ERR_ASYNC_CONNECTION, "Socket write closed by peer", 0);
+			}
+			as_event_socket_error(cmd, &err);
+		}
+	}
+	else {
+		cmd->pos += res;
+		cmd->bytes_out += res;
+
+		if (cmd->pos < cmd->len) {
+			as_uring_send(cmd);
+		}
+		else {
+			as_uring_write_complete(cmd);
+		}
+	}
+
+	as_uring_process(uring, conn, 0);
+}
+
+static void
+as_uring_poll_complete(as_uring_loop* uring, as_event_connection* conn, uint16_t flag, int events)
+{
+	conn->flags &= ~flag;
+
+	if ((conn->flags & AS_URING_CONN_CLOSED) || uring->closed) {
+		if (conn->flags & AS_URING_CONN_CLOSED) {
+			as_uring_conn_free(uring, conn);
+		}
+		return;
+	}
+
+	as_uring_process(uring, conn, events);
+}
+
+static void
+as_uring_complete(as_event_loop* event_loop, struct io_uring_cqe* cqe)
+{
+	as_uring_loop* uring = event_loop->uring;
+	uint64_t data = io_uring_cqe_get_data64(cqe);
+	void* ptr = (void*)(uintptr_t)(data & ~(uint64_t)AS_URING_OP_MASK);
+
+	switch (data & AS_URING_OP_MASK) {
+	case AS_URING_OP_WAKEUP:
+		if (! uring->closed) {
+			// Rearm before processing, so wakeups sent during processing are not lost.
+			as_uring_arm_wakeup(uring);
+			as_event_process_queue(event_loop);
+		}
+		break;
+
+	case AS_URING_OP_RECV:
+		as_uring_recv_complete(uring, ptr, cqe);
+		break;
+
+	case AS_URING_OP_SEND:
+		as_uring_send_complete(uring, ptr, cqe->res);
+		break;
+
+	case AS_URING_OP_POLL_IN:
+		as_uring_poll_complete(uring, ptr, AS_URING_CONN_POLL_IN, AS_URING_READ);
+		break;
+
+	case AS_URING_OP_POLL_OUT:
+		as_uring_poll_complete(uring, ptr, AS_URING_CONN_POLL_OUT, AS_URING_WRITE);
+		break;
+
+	default:
+		// Cancel completions are ignored.
+		break;
+	}
+}
+
+static void
+as_uring_run(as_event_loop* event_loop, int64_t wait)
+{
+	as_uring_loop* uring = event_loop->uring;
+	struct io_uring_cqe* cqe;
+	struct __kernel_timespec ts;
+	struct __kernel_timespec* tsp = NULL;
+
+	if (wait >= 0) {
+		ts.tv_sec = wait / 1000;
+		ts.tv_nsec = (wait % 1000) * 1000 * 1000;
+		tsp = &ts;
+	}
+
+	// Submit all operations queued since the last iteration with one system call and
+	// wait for the next completion or timer deadline.
+	int rv = io_uring_submit_and_wait_timeout(&uring->ring, &cqe, 1, tsp, NULL);
+
+	if (rv < 0 && rv != -ETIME && rv != -EINTR && rv != -EBUSY) {
+		as_log_error("io_uring wait failed: %d", rv);
+	}
+
+	unsigned head;
+	uint32_t count = 0;
+
+	io_uring_for_each_cqe(&uring->ring, head, cqe) {
+		as_uring_complete(event_loop, cqe);
+		count++;
+	}
+	io_uring_cq_advance(&uring->ring, count);
+}
+
+//---------------------------------
+// Event Loop
+//---------------------------------
+
+static void
+as_uring_loop_destroy(as_uring_loop* uring)
+{
+	if (uring->recv_ring) {
+		io_uring_free_buf_ring(&uring->ring, uring->recv_ring, AS_URING_RECV_COUNT,
+			AS_URING_RECV_GROUP);
+	}
+	io_uring_queue_exit(&uring->ring);
+
+	if (uring->wakeup_fd >= 0) {
+		close(uring->wakeup_fd);
+	}
+	cf_free(uring->timers);
+	cf_free(uring->send_bufs);
+	cf_free(uring->recv_bufs);
+	cf_free(uring);
+}
+
+static bool
+as_uring_kernel_supported(struct io_uring* ring)
+{
+	// Multishot receive shipped in Linux 6.0 together with zero copy send. Provided buffer rings
+	// shipped in 5.19. The kernel does not report multishot receive support directly, so use the
+	// zero copy send opcode to detect a 6.0+ kernel.
+	struct io_uring_probe* probe = io_uring_get_probe_ring(ring);
+
+	if (! probe) {
+		return false;
+	}
+
+	bool supported = io_uring_opcode_supported(probe, IORING_OP_RECV) &&
+		io_uring_opcode_supported(probe, IORING_OP_SEND_ZC);
+
+	io_uring_free_probe(probe);
+	return supported;
+}
+
+static as_uring_loop*
+as_uring_loop_create(void)
+{
+	as_uring_loop* uring = cf_calloc(1, sizeof(as_uring_loop));
+
+	if (! uring) {
+		return NULL;
+	}
+
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	params.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+
+	int rv = io_uring_queue_init_params(AS_URING_ENTRIES, &uring->ring, &params);
+
+	if (rv == -EINVAL) {
+		// Setup flags are not supported by older kernels.
+		memset(&params, 0, sizeof(params));
+		rv = io_uring_queue_init_params(AS_URING_ENTRIES, &uring->ring, &params);
+	}
+
+	if (rv < 0) {
+		as_log_error("io_uring_queue_init failed: %d", rv);
+		cf_free(uring);
+		return NULL;
+	}
+
+	uring->wakeup_fd = -1;
+
+	if (! as_uring_kernel_supported(&uring->ring)) {
+		// There is no runtime fallback to another event library, so fail loop creation with
+		// a clear reason instead of failing on the first multishot receive.
+		as_log_error("io_uring multishot receive is not supported by this kernel. "
+			"EVENT_LIB=liburing requires Linux 6.0+");
+		as_uring_loop_destroy(uring);
+		return NULL;
+	}
+
+	uring->recv_bufs = cf_malloc((size_t)AS_URING_RECV_COUNT * AS_URING_RECV_SIZE);
+	uring->recv_ring = io_uring_setup_buf_ring(&uring->ring, AS_URING_RECV_COUNT,
+		AS_URING_RECV_GROUP, 0, &rv);
+
+	if (! uring->recv_ring) {
+		if (rv == -EINVAL || rv == -ENOSYS) {
+			as_log_error("io_uring provided buffer rings are not supported by this kernel. "
+				"EVENT_LIB=liburing requires Linux 6.0+");
+		}
+		else {
+			as_log_error("io_uring buffer ring setup failed: %d", rv);
+		}
+		as_uring_loop_destroy(uring);
+		return NULL;
+	}
+
+	int mask = io_uring_buf_ring_mask(AS_URING_RECV_COUNT);
+
+	for (uint16_t i = 0; i < AS_URING_RECV_COUNT; i++) {
+		io_uring_buf_ring_add(uring->recv_ring, uring->recv_bufs + (size_t)i * AS_URING_RECV_SIZE,
+			AS_URING_RECV_SIZE, i, mask, i);
+	}
+	io_uring_buf_ring_advance(uring->recv_ring, AS_URING_RECV_COUNT);
+
+	uring->send_bufs = cf_malloc((size_t)AS_URING_SEND_COUNT * AS_URING_SEND_SIZE);
+
+	for (uint16_t i = 0; i < AS_URING_SEND_COUNT; i++) {
+		uring->send_free[i] = i;
+	}
+	uring->send_free_size = AS_URING_SEND_COUNT;
+
+	uring->timers_capacity = AS_URING_TIMERS_INITIAL_CAPACITY;
+	uring->timers = cf_malloc(sizeof(as_uring_timer*) * uring->timers_capacity);
+
+	uring->wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+	if (uring->wakeup_fd < 0) {
+		as_log_error("eventfd failed: %d", errno);
+		as_uring_loop_destroy(uring);
+		return NULL;
+	}
+	as_uring_arm_wakeup(uring);
+	return uring;
+}
+
+void
+as_event_close_loop(as_event_loop* event_loop)
+{
+	// Worker exits after the current iteration.
+	event_loop->uring->closed = true;
+
+	// Cleanup event loop resources.
+	as_event_loop_destroy(event_loop);
+}
+
+static void*
+as_uring_worker(void* udata)
+{
+	as_event_loop* event_loop = udata;
+	as_uring_loop* uring = event_loop->uring;
+
+	as_thread_set_name_index("uring", event_loop->index);
+
+	while (! uring->closed) {
+		as_uring_run(event_loop, as_uring_timer_wait(uring));
+		as_uring_timer_expire(event_loop);
+	}
+
+	// Wait for cancel completions of closed connections, so the connections can be freed.
+	for (uint32_t i = 0; i < 100 && uring->closing > 0; i++) {
+		as_uring_run(event_loop, 10);
+	}
+
+	as_uring_loop_destroy(uring);
+	event_loop->uring = NULL;
+	event_loop->loop = NULL;
+	as_tls_thread_cleanup();
+	return NULL;
+}
+
+bool
+as_event_create_loop(as_event_loop* event_loop)
+{
+	as_uring_loop* uring = as_uring_loop_create();
+
+	if (! uring) {
+		return false;
+	}
+
+	event_loop->uring = uring;
+	event_loop->loop = &uring->ring;
+
+	if (pthread_create(&event_loop->thread, NULL, as_uring_worker, event_loop) != 0) {
+		as_uring_loop_destroy(uring);
+		event_loop->uring = NULL;
+		event_loop->loop = NULL;
+		return false;
+	}
+	return true;
+}
+
+void
+as_event_register_external_loop(as_event_loop* event_loop)
+{
+	// External io_uring loops are rejected by as_set_external_event_loop().
+}
+
+bool
+as_event_execute(as_event_loop* event_loop, as_event_executable executable, void* udata)
+{
+	// Send command through queue so it can be executed in event loop thread.
+	pthread_mutex_lock(&event_loop->lock);
+	as_event_commander qcmd = {.executable = executable, .udata = udata};
+	bool queued = as_queue_push(&event_loop->queue, &qcmd);
+	pthread_mutex_unlock(&event_loop->lock);
+
+	if (queued) {
+		eventfd_write(event_loop->uring->wakeup_fd, 1);
+	}
+	return queued;
+}
+
+uint32_t
+as_event_execute_many(as_event_loop* event_loop, as_event_commander* cmds, uint32_t n_cmds)
+{
+	uint32_t n = 0;
+
+	pthread_mutex_lock(&event_loop->lock);
+
+	while (n < n_cmds && as_queue_push(&event_loop->queue, &cmds[n])) {
+		n++;
+	}
+	pthread_mutex_unlock(&event_loop->lock);
+
+	if (n > 0) {
+		eventfd_write(event_loop->uring->wakeup_fd, 1);
+	}
+	return n;
+}
+
+//---------------------------------
+// Connect
+//---------------------------------
+
+static void
+as_uring_conn_init(as_event_command* cmd, as_socket* sock)
+{
+	as_event_connection* conn = cmd->conn;
+	memcpy(&conn->socket, sock, sizeof(as_socket));
+	conn->event_loop = cmd->event_loop;
+	conn->send_buf = NULL;
+	conn->staged = 0;
+	conn->stage_offset = 0;
+	conn->stage_head = AS_URING_BUF_NONE;
+	conn->stage_tail = AS_URING_BUF_NONE;
+	conn->send_slot = AS_URING_BUF_NONE;
+	conn->flags = AS_URING_CONN_CONNECTING;
+	conn->error = 0;
+
+	// Change state if using TLS.
+	if (as_socket_use_tls(cmd->cluster->tls_ctx)) {
+		cmd->state = AS_ASYNC_STATE_TLS_CONNECT;
+	}
+
+	// Wait for socket connect to complete.
+	as_uring_watch(cmd, AS_URING_WRITE);
+}
+
+static int
+as_uring_try_connections(int fd, as_address* addresses, socklen_t size, int i, int max)
+{
+	while (i < max) {
+		if (as_socket_connect_fd(fd, (struct sockaddr*)&addresses[i].addr, size)) {
+			return i;
+		}
+		i++;
+	}
+	return -1;
+}
+
+static int
+as_uring_try_family_connections(as_event_command* cmd, int family, int begin, int end, int index, as_address* primary, as_socket* sock)
+{
+	// Create a non-blocking socket.
+	as_socket_fd fd;
+	int rv = as_socket_create_fd(family, &fd);
+
+	if (rv < 0) {
+		return rv;
+	}
+
+	if (cmd->pipe_listener && ! as_pipe_modify_fd(fd)) {
+		return -1000;
+	}
+
+	as_tls_context* ctx = as_socket_get_tls_context(cmd->cluster->tls_ctx);
+
+	if (! as_socket_wrap(sock, family, fd, ctx, cmd->node->tls_name)) {
+		return -1001;
+	}
+
+	// Try addresses.
+	as_address* addresses = cmd->node->addresses;
+	socklen_t size = (family == AF_INET)? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6);
+
+	if (index >= 0) {
+		// Try primary address.
+		if (as_socket_connect_fd(fd, (struct sockaddr*)&primary->addr, size)) {
+			return index;
+		}
+
+		// Start from current index + 1 to end.
+		rv = as_uring_try_connections(fd, addresses, size, index + 1, end);
+
+		if (rv < 0) {
+			// Start from begin to index.
+			rv = as_uring_try_connections(fd, addresses, size, begin, index);
+		}
+	}
+	else {
+		rv = as_uring_try_connections(fd, addresses, size, begin, end);
+	}
+
+	if (rv < 0) {
+		// Couldn't start a connection on any socket address - close the socket.
+		as_socket_close(sock);
+		return -1002;
+	}
+	return rv;
+}
+
+static void
+as_uring_connect_error(as_event_command* cmd, as_address* primary, int rv)
+{
+	// Socket has already been closed. Release connection.
+	cf_free(cmd->conn);
+	as_event_decr_conn(cmd);
+	cmd->event_loop->errors++;
+
+	if (as_event_command_retry(cmd, false)) {
+		return;
+	}
+
+	as_error err;
+	as_error_update(&err, AEROSPIKE_ERR_ASYNC_CONNECTION, "Connect failed: %d %s %s", rv, cmd->node->name, primary->name);
+
+	// Only timer needs to be released on socket connection failure.
+	// No operation has been submitted yet.
+	as_event_timer_stop(cmd);
+	as_event_error_callback(cmd, &err);
+}
+
+void
+as_event_connect(as_event_command* cmd, as_async_conn_pool* pool)
+{
+	// Try addresses.
+	as_socket sock;
+	as_node* node = cmd->node;
+	uint32_t index = node->address_index;
+	as_address* primary = &node->addresses[index];
+	int rv;
+	int first_rv;
+
+	if (primary->addr.ss_family == AF_INET) {
+		// Try IPv4 addresses first.
+		rv = as_uring_try_family_connections(cmd, AF_INET, 0, node->address4_size, index, primary, &sock);
+
+		if (rv < 0) {
+			// Try IPv6 addresses.
+			first_rv = rv;
+			rv = as_uring_try_family_connections(cmd, AF_INET6, AS_ADDRESS4_MAX, AS_ADDRESS4_MAX + node->address6_size, -1, NULL, &sock);
+		}
+	}
+	else {
+		// Try IPv6 addresses first.
+		rv = as_uring_try_family_connections(cmd, AF_INET6, AS_ADDRESS4_MAX, AS_ADDRESS4_MAX + node->address6_size, index, primary, &sock);
+
+		if (rv < 0) {
+			// Try IPv4 addresses.
+			first_rv = rv;
+			rv = as_uring_try_family_connections(cmd, AF_INET, 0, node->address4_size, -1, NULL, &sock);
+		}
+	}
+
+	if (rv < 0) {
+		as_uring_connect_error(cmd, primary, first_rv);
+		return;
+	}
+
+	if (rv != index) {
+		// Replace invalid primary address with valid alias.
+		// Other threads may not see this change immediately.
+		// It's just a hint, not a requirement to try this new address first.
+		as_store_uint32(&node->address_index, rv);
+		as_log_debug("Change node address %s %s", node->name, as_node_get_address_string(node));
+	}
+
+	pool->opened++;
+	as_uring_conn_init(cmd, &sock);
+	cmd->event_loop->errors = 0; // Reset errors on valid connection.
+}
+
+static void
+as_uring_close_connections(as_node* node, as_async_conn_pool* pool)
+{
+	as_event_connection* conn;
+
+	while (as_queue_pop(&pool->queue, &conn)) {
+		as_event_release_connection(conn, pool);
+	}
+	as_queue_destroy(&pool->queue);
+}
+
+void
+as_event_node_destroy(as_node* node)
+{
+	// Close connections.
+	for (uint32_t i = 0; i < as_event_loop_size; i++) {
+		as_uring_close_connections(node, &node->async_conn_pools[i]);
+		as_uring_close_connections(node, &node->pipe_conn_pools[i]);
+	}
+	cf_free(node->async_conn_pools);
+	cf_free(node->pipe_conn_pools);
+}
+
+#endif
@@ -114,34 +114,7 @@ as_uv_wakeup(uv_async_t* wakeup)
 {
 	// Read command pointers from queue.
 	as_event_loop* event_loop = wakeup->data;
-	as_event_commander cmd;
-	uint32_t i = 0;
-
-	// Only process original size of queue.  Recursive pre-registration errors can
-	// result in new commands being added while the loop is in process.  If we process
-	// them, we could end up in an infinite loop.
-	pthread_mutex_lock(&event_loop->lock);
-	uint32_t size = as_queue_size(&event_loop->queue);
-	bool status = as_queue_pop(&event_loop->queue, &cmd);
-	pthread_mutex_unlock(&event_loop->lock);
-
-	while (status) {
-		if (! cmd.executable) {
-			// Received stop signal.
-			as_event_close_loop(event_loop);
-			return;
-		}
-		cmd.executable(event_loop, cmd.udata);
-
-		if (++i < size) {
-			pthread_mutex_lock(&event_loop->lock);
-			status = as_queue_pop(&event_loop->queue, &cmd);
-			pthread_mutex_unlock(&event_loop->lock);
-		}
-		else {
-			break;
-		}
-	}
+	as_event_process_queue(event_loop);
 }
 
 static void
@@ -248,6 +221,24 @@ as_event_execute(as_event_loop* event_loop, as_event_executable executable, void
 	return queued;
 }
 
+uint32_t
+as_event_execute_many(as_event_loop* event_loop, as_event_commander* cmds, uint32_t n_cmds)
+{
+	uint32_t n = 0;
+
+	pthread_mutex_lock(&event_loop->lock);
+
+	while (n < n_cmds && as_queue_push(&event_loop->queue, &cmds[n])) {
+		n++;
+	}
+	pthread_mutex_unlock(&event_loop->lock);
+
+	if (n > 0) {
+		uv_async_send(event_loop->wakeup);
+	}
+	return n;
+}
+
 static inline as_event_command*
 as_uv_get_command(as_event_connection* conn)
 {
@@ -338,12 +329,7 @@ as_uv_command_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf)
 		}
 		
 		if (cmd->len > cmd->read_capacity) {
-			if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-				cf_free(cmd->buf);
-			}
-			cmd->buf = cf_malloc(size);
-			cmd->read_capacity = cmd->len;
-			cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
+			as_event_set_read_buffer(cmd, size);
 		}
 		return;
 	}
@@ -1063,12 +1049,7 @@ as_uv_tls_read(as_event_command* cmd)
 				}
 
 				if (cmd->len > cmd->read_capacity) {
-					if (cmd->flags & AS_ASYNC_FLAGS_FREE_BUF) {
-						cf_free(cmd->buf);
-					}
-					cmd->buf = cf_malloc(size);
-					cmd->read_capacity = cmd->len;
-					cmd->flags |= AS_ASYNC_FLAGS_FREE_BUF;
+					as_event_set_read_buffer(cmd, size);
 				}
 				break;
 			}
@@ -1150,6 +1131,14 @@ as_uv_tls_handshake_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf
 		// Handshake complete.
 		uv_read_stop(stream);
 
+		struct sockaddr_storage addr;
+		int size = sizeof(addr);
+
+		if (uv_tcp_getpeername((uv_tcp_t*)stream, (struct sockaddr*)&addr, &size) == 0) {
+			as_tls_session_save(tls->ctx, tls->ssl, (struct sockaddr*)&addr,
+				cmd->node->tls_name);
+		}
+
 		if (cmd->cluster->auth_enabled) {
 			as_session* session = as_session_load(&cmd->node->session);
 
@@ -1276,6 +1265,13 @@ as_uv_tls_init_connection(as_event_command* cmd, uv_stream_t* stream, as_tls_con
 	SSL_set_bio(tls->ssl, tls->ibio, tls->ibio);
 	SSL_set_connect_state(tls->ssl);
 
+	struct sockaddr_storage addr;
+	int size = sizeof(addr);
+
+	if (uv_tcp_getpeername((uv_tcp_t*)stream, (struct sockaddr*)&addr, &size) == 0) {
+		as_tls_session_resume(ctx, tls->ssl, (struct sockaddr*)&addr, cmd->node->tls_name);
+	}
+
 	// Handshake always fails the first time.
 	SSL_do_handshake(tls->ssl);
 
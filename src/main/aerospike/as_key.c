@@ -19,6 +19,7 @@
 #include <aerospike/as_log_macros.h>
 #include <aerospike/as_string.h>
 #include <aerospike/as_bytes.h>
+#include <aerospike/as_ripemd160.h>
 
 #include <citrusleaf/alloc.h>
 #include <citrusleaf/cf_byte_order.h>
@@ -28,6 +29,100 @@
  * STATIC FUNCTIONS
  *****************************************************************************/
 
+static size_t
+as_key_value_size(const as_val* val)
+{
+	switch (val->type) {
+		case AS_INTEGER:
+		case AS_DOUBLE:
+			return 9;
+		case AS_STRING:
+			return as_string_len((as_string*)val) + 1;
+		case AS_BYTES:
+			return ((as_bytes*)val)->size + 1;
+		default:
+			return 0;
+	}
+}
+
+static void
+as_key_value_write(const as_val* val, uint8_t* buf)
+{
+	switch (val->type) {
+		case AS_INTEGER: {
+			as_integer* v = (as_integer*)val;
+			buf[0] = AS_BYTES_INTEGER;
+			*(uint64_t*)&buf[1] = cf_swap_to_be64(v->value);
+			break;
+		}
+		case AS_DOUBLE: {
+			as_double* v = (as_double*)val;
+			buf[0] = AS_BYTES_DOUBLE;
+			*(double*)&buf[1] = cf_swap_to_big_float64(v->value);
+			break;
+		}
+		case AS_STRING: {
+			as_string* v = (as_string*)val;
+			buf[0] = AS_BYTES_STRING;
+			memcpy(&buf[1], v->value, as_string_len(v));
+			break;
+		}
+		case AS_BYTES: {
+			as_bytes* v = (as_bytes*)val;
+			// Note: v->type must be a blob type (AS_BYTES_BLOB, AS_BYTES_JAVA, AS_BYTES_PYTHON ...).
+			// Otherwise, the particle type will be reassigned to a non-blob which causes a
+			// mismatch between type and value.
+			buf[0] = v->type;
+			memcpy(&buf[1], v->value, v->size);
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+#if defined(AS_RIPEMD160_SIMD)
+
+// Longest padded message (in blocks) that is hashed in a SIMD lane. Four blocks cover a
+// set name plus string/blob user keys up to ~190 bytes.
+#define AS_KEY_DIGEST_MAX_BLOCKS 4
+
+typedef struct {
+	uint8_t bufs[AS_RIPEMD160_LANES][AS_KEY_DIGEST_MAX_BLOCKS * AS_RIPEMD160_BLOCK_SIZE];
+	as_key* keys[AS_RIPEMD160_LANES];
+	uint32_t n_blocks;
+	uint32_t size;
+} as_key_digest_group;
+
+static void
+as_key_digest_group_flush(as_key_digest_group* group)
+{
+	const uint8_t* blocks[AS_RIPEMD160_LANES];
+	uint8_t* digests[AS_RIPEMD160_LANES];
+	uint8_t unused[AS_DIGEST_VALUE_SIZE];
+
+	for (uint32_t i = 0; i < AS_RIPEMD160_LANES; i++) {
+		if (i < group->size) {
+			blocks[i] = group->bufs[i];
+			digests[i] = group->keys[i]->digest.value;
+		}
+		else {
+			// Fill unused lanes with the first message and discard the result.
+			blocks[i] = group->bufs[0];
+			digests[i] = unused;
+		}
+	}
+
+	as_ripemd160_lanes(blocks, group->n_blocks, digests);
+
+	for (uint32_t i = 0; i < group->size; i++) {
+		group->keys[i]->digest.init = true;
+	}
+	group->size = 0;
+}
+
+#endif
+
 static as_key*
 as_key_cons(
 	as_key* key, bool free, const char* ns, const char* set, const as_key_value* valuep,
@@ -245,54 +340,104 @@ as_key_set_digest(as_error* err, as_key* key)
 	}
 	
 	size_t set_len = strlen(key->set);
-	size_t size;
-	
 	as_val* val = (as_val*)key->valuep;
-	uint8_t* buf;
-	
-	switch (val->type) {
-		case AS_INTEGER: {
-			as_integer* v = as_integer_fromval(val);
-			size = 9;
-			buf = alloca(size);
-			buf[0] = AS_BYTES_INTEGER;
-			*(uint64_t*)&buf[1] = cf_swap_to_be64(v->value);
-			break;
+	size_t size = as_key_value_size(val);
+
+	if (size == 0) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid key type: %d", val->type);
+	}
+
+	uint8_t* buf = alloca(size);
+	as_key_value_write(val, buf);
+		
+	cf_digest_compute2(key->set, set_len, buf, size, (cf_digest*)key->digest.value);
+	key->digest.init = true;
+	return AEROSPIKE_OK;
+}
+
+as_status
+as_keys_set_digests(as_error* err, as_key* keys, uint32_t n_keys)
+{
+	return as_keys_set_digests_stride(err, keys, sizeof(as_key), n_keys);
+}
+
+#if defined(AS_RIPEMD160_SIMD)
+
+as_status
+as_keys_set_digests_stride(as_error* err, void* keys, size_t stride, uint32_t n_keys)
+{
+	// Messages are grouped by padded block count so all lanes in a group finish together.
+	// Messages longer than AS_KEY_DIGEST_MAX_BLOCKS are hashed one at a time.
+	as_key_digest_group groups[AS_KEY_DIGEST_MAX_BLOCKS];
+	uint8_t* p = keys;
+
+	for (uint32_t i = 0; i < AS_KEY_DIGEST_MAX_BLOCKS; i++) {
+		groups[i].n_blocks = i + 1;
+		groups[i].size = 0;
+	}
+
+	for (uint32_t i = 0; i < n_keys; i++, p += stride) {
+		as_key* key = (as_key*)p;
+
+		if (key->digest.init) {
+			continue;
 		}
-		case AS_DOUBLE: {
-			as_double* v = as_double_fromval(val);
-			size = 9;
-			buf = alloca(size);
-			buf[0] = AS_BYTES_DOUBLE;
-			*(double*)&buf[1] = cf_swap_to_big_float64(v->value);
-			break;
+
+		size_t set_len = strlen(key->set);
+		as_val* val = (as_val*)key->valuep;
+		size_t size = as_key_value_size(val);
+
+		if (size == 0) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid key type: %d", val->type);
 		}
-		case AS_STRING: {
-			as_string* v = as_string_fromval(val);
-			size_t len = as_string_len(v);
-			size = len + 1;
-			buf = alloca(size);
-			buf[0] = AS_BYTES_STRING;
-			memcpy(&buf[1], v->value, len);
-			break;
+
+		uint32_t n_blocks = as_ripemd160_blocks(set_len + size);
+
+		if (n_blocks > AS_KEY_DIGEST_MAX_BLOCKS) {
+			as_status status = as_key_set_digest(err, key);
+
+			if (status != AEROSPIKE_OK) {
+				return status;
+			}
+			continue;
 		}
-		case AS_BYTES: {
-			as_bytes* v = as_bytes_fromval(val);
-			size = v->size + 1;
-			buf = alloca(size);
-			// Note: v->type must be a blob type (AS_BYTES_BLOB, AS_BYTES_JAVA, AS_BYTES_PYTHON ...).
-			// Otherwise, the particle type will be reassigned to a non-blob which causes a
-			// mismatch between type and value.
-			buf[0] = v->type;
-			memcpy(&buf[1], v->value, v->size);
-			break;
+
+		as_key_digest_group* group = &groups[n_blocks - 1];
+		uint8_t* buf = group->bufs[group->size];
+
+		memcpy(buf, key->set, set_len);
+		as_key_value_write(val, buf + set_len);
+		as_ripemd160_pad(buf, set_len + size);
+		group->keys[group->size++] = key;
+
+		if (group->size == AS_RIPEMD160_LANES) {
+			as_key_digest_group_flush(group);
 		}
-		default: {
-			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid key type: %d", val->type);
+	}
+
+	for (uint32_t i = 0; i < AS_KEY_DIGEST_MAX_BLOCKS; i++) {
+		if (groups[i].size > 0) {
+			as_key_digest_group_flush(&groups[i]);
+		}
+	}
+	return AEROSPIKE_OK;
+}
+
+#else
+
+as_status
+as_keys_set_digests_stride(as_error* err, void* keys, size_t stride, uint32_t n_keys)
+{
+	uint8_t* p = keys;
+
+	for (uint32_t i = 0; i < n_keys; i++, p += stride) {
+		as_status status = as_key_set_digest(err, (as_key*)p);
+
+		if (status != AEROSPIKE_OK) {
+			return status;
 		}
 	}
-		
-	cf_digest_compute2(key->set, set_len, buf, size, (cf_digest*)key->digest.value);
-	key->digest.init = true;
 	return AEROSPIKE_OK;
 }
+
+#endif
@@ -16,6 +16,127 @@
  */
 #include <aerospike/as_latency.h>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+// Number of nanoseconds per millisecond
+#define NS_TO_MS 1000000
+
+// Number of nanoseconds per microsecond
+#define NS_TO_US 1000
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static inline uint32_t
+as_latency_msb(uint64_t v)
+{
+	// v must be non-zero.
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, v);
+	return (uint32_t)index;
+#else
+	return 63 - (uint32_t)__builtin_clzll(v);
+#endif
+}
+
+static inline uint32_t
+as_latency_get_index_millis(as_latency* latency, uint64_t elapsed)
+{
+	uint64_t limit = 1;
+	uint32_t last_bucket = latency->size - 1;
+
+	for (uint32_t i = 0; i < last_bucket; i++) {
+		if (elapsed <= limit) {
+			return i;
+		}
+		limit <<= latency->shift;
+	}
+	return last_bucket;
+}
+
+static inline uint32_t
+as_latency_get_index_micros(as_latency* latency, uint64_t elapsed)
+{
+	// Log-linear buckets. The first (1 << shift) buckets are one microsecond wide. After that,
+	// each power of 2 range is split into (1 << shift) equal width sub-buckets.
+	uint32_t sub_bits = latency->shift;
+	uint64_t sub_count = 1ULL << sub_bits;
+	uint64_t index;
+
+	if (elapsed < sub_count) {
+		index = elapsed;
+	}
+	else {
+		uint32_t msb = as_latency_msb(elapsed);
+		uint32_t range = msb - sub_bits;
+		index = ((uint64_t)(range + 1) << sub_bits) + ((elapsed >> range) - sub_count);
+	}
+
+	uint32_t last_bucket = latency->size - 1;
+	return (index < last_bucket)? (uint32_t)index : last_bucket;
+}
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+as_latency*
+as_latency_create(uint8_t size, uint8_t shift, bool micros)
+{
+	// Round stripe rows up to whole cache lines. Allocate an extra cache line so rows can
+	// be aligned on a cache line boundary.
+	uint32_t stride = (size + AS_METRICS_LINE_COUNTERS - 1) & ~(AS_METRICS_LINE_COUNTERS - 1);
+	uint32_t n_counts = AS_METRICS_STRIPES * stride + AS_METRICS_LINE_COUNTERS;
+
+	as_latency* latency = cf_calloc(1, sizeof(as_latency) + (sizeof(uint64_t) * n_counts));
+	latency->ref_count = 1;
+	latency->shift = shift;
+	latency->size = size;
+	latency->micros = micros;
+	latency->next = NULL;
+	latency->stride = stride;
+
+	uintptr_t line = sizeof(uint64_t) * AS_METRICS_LINE_COUNTERS;
+	latency->rows = (uint64_t*)(((uintptr_t)latency->buckets + line - 1) & ~(line - 1));
+	return latency;
+}
+
+void
+as_latency_add(as_latency* latency, uint32_t stripe, uint64_t elapsed_nanos)
+{
+	uint32_t index;
+
+	if (latency->micros) {
+		// Round up elapsed to nearest microsecond.
+		uint64_t elapsed = (elapsed_nanos + NS_TO_US - 1) / NS_TO_US;
+		index = as_latency_get_index_micros(latency, elapsed);
+	}
+	else {
+		// Round up elapsed to nearest millisecond.
+		uint64_t elapsed = (elapsed_nanos + NS_TO_MS - 1) / NS_TO_MS;
+		index = as_latency_get_index_millis(latency, elapsed);
+	}
+	as_incr_uint64(&latency->rows[(stripe & (AS_METRICS_STRIPES - 1)) * latency->stride + index]);
+}
+
+void
+as_latency_clear(as_latency* latency)
+{
+	uint32_t max = AS_METRICS_STRIPES * latency->stride;
+
+	for (uint32_t i = 0; i < max; i++) {
+		as_store_uint64(&latency->rows[i], 0);
+	}
+}
+
 char*
 as_latency_type_to_string(as_latency_type type)
 {
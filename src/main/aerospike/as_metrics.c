@@ -47,6 +47,10 @@ as_metrics_policy_merge(aerospike* as, const as_metrics_policy* src, as_metrics_
 		mrg->enable = as_field_is_set(bitmap, AS_METRICS_ENABLE)?
 			cfg->enable : src->enable;
 
+		mrg->latency_micros = as_field_is_set(bitmap, AS_METRICS_LATENCY_MICROS)?
+			cfg->latency_micros : src->latency_micros;
+		mrg->latency_delta = as_field_is_set(bitmap, AS_METRICS_LATENCY_DELTA)?
+			cfg->latency_delta : src->latency_delta;
 		mrg->metrics_listeners = src->metrics_listeners;
 		as_strncpy(mrg->report_dir, src->report_dir, sizeof(mrg->report_dir));
 		mrg->report_size_limit = src->report_size_limit;
@@ -115,6 +119,8 @@ as_metrics_policy_init(as_metrics_policy* policy)
 	policy->interval = 30;
 	policy->latency_columns = 7;
 	policy->latency_shift = 1;
+	policy->latency_micros = false;
+	policy->latency_delta = false;
 	policy->metrics_listeners.enable_listener = NULL;
 	policy->metrics_listeners.snapshot_listener = NULL;
 	policy->metrics_listeners.node_close_listener = NULL;
@@ -18,6 +18,7 @@
 #include <aerospike/aerospike_stats.h>
 #include <aerospike/as_event.h>
 #include <aerospike/as_string_builder.h>
+#include <string.h>
 #include <time.h>
 
 //---------------------------------
@@ -370,8 +371,9 @@ as_metrics_open_writer(as_metrics_writer* mw, as_error* err)
 	timestamp_to_string(now_str, sizeof(now_str));
 	
 	char data[512];
-	int rv = snprintf(data, sizeof(data), "%s header(2) cluster[name,clientType,clientVersion,appId,label[],cpu,mem,invalidNodeCount,commandCount,retryCount,delayQueueTimeoutCount,eventloop[],node[]] label[name,value] eventloop[processSize,queueSize] node[name,address,port,syncConn,asyncConn,namespace[]] conn[inUse,inPool,opened,closed,recovered,aborted] namespace[name,errors,timeouts,keyBusy,bytesIn,bytesOut,latency[]] latency(%u,%u)[type[l1,l2,l3...]]\n",
-		now_str, mw->latency_columns, mw->latency_shift);
+	int rv = snprintf(data, sizeof(data), "%s header(2) cluster[name,clientType,clientVersion,appId,label[],cpu,mem,invalidNodeCount,commandCount,retryCount,delayQueueTimeoutCount,eventloop[],node[]] label[name,value] eventloop[processSize,queueSize] node[name,address,port,syncConn,asyncConn,namespace[]] conn[inUse,inPool,opened,closed,recovered,aborted] namespace[name,errors,timeouts,keyBusy,bytesIn,bytesOut,latency[]] latency(%u,%u%s%s)[type[l1,l2,l3...]]\n",
+		now_str, mw->latency_columns, mw->latency_shift, mw->latency_micros ? ",us" : "",
+		mw->latency_delta ? ",delta" : "");
 	if (rv <= 0) {
 		fclose(mw->file);
 		return as_error_update(err, AEROSPIKE_ERR_CLIENT,
@@ -435,8 +437,82 @@ as_metrics_write_conn(as_metrics_writer* mw, as_string_builder* sb, const struct
 	as_string_builder_append_uint(sb, stats->aborted); // Cumulative. Not reset on each interval.
 }
 
+static as_metrics_node_prev*
+as_metrics_node_prev_get(as_metrics_writer* mw, struct as_node_s* node)
+{
+	as_vector* list = mw->latency_prev;
+
+	for (uint32_t i = 0; i < list->size; i++) {
+		as_metrics_node_prev* np = as_vector_get(list, i);
+
+		if (np->node == node) {
+			return np;
+		}
+	}
+
+	as_metrics_node_prev np = {.node = node, .latencies = NULL, .ns_size = 0};
+	as_vector_append(list, &np);
+	return as_vector_get(list, list->size - 1);
+}
+
+static void
+as_metrics_node_prev_destroy(as_metrics_node_prev* np)
+{
+	uint32_t max = np->ns_size * AS_LATENCY_TYPE_MAX;
+
+	for (uint32_t i = 0; i < max; i++) {
+		cf_free(np->latencies[i].counts);
+	}
+	cf_free(np->latencies);
+}
+
+static void
+as_metrics_node_prev_remove(as_metrics_writer* mw, struct as_node_s* node)
+{
+	as_vector* list = mw->latency_prev;
+
+	for (uint32_t i = 0; i < list->size; i++) {
+		as_metrics_node_prev* np = as_vector_get(list, i);
+
+		if (np->node == node) {
+			as_metrics_node_prev_destroy(np);
+			as_vector_remove(list, i);
+			return;
+		}
+	}
+}
+
+static uint64_t*
+as_metrics_latency_prev_get(
+	as_metrics_node_prev* np, uint32_t ns_index, uint8_t type, as_latency* latency
+	)
+{
+	if (ns_index >= np->ns_size) {
+		// Namespace metrics are only appended, so the index of a namespace is stable.
+		uint32_t size = ns_index + 1;
+		np->latencies = cf_realloc(np->latencies,
+			sizeof(as_metrics_latency_prev) * size * AS_LATENCY_TYPE_MAX);
+		memset(&np->latencies[np->ns_size * AS_LATENCY_TYPE_MAX], 0,
+			sizeof(as_metrics_latency_prev) * (size - np->ns_size) * AS_LATENCY_TYPE_MAX);
+		np->ns_size = size;
+	}
+
+	as_metrics_latency_prev* lp = &np->latencies[ns_index * AS_LATENCY_TYPE_MAX + type];
+
+	if (lp->latency != latency) {
+		// First snapshot of this histogram.
+		cf_free(lp->counts);
+		lp->counts = cf_calloc(latency->size, sizeof(uint64_t));
+		lp->latency = latency;
+	}
+	return lp->counts;
+}
+
 static void
-as_metrics_write_latencies(as_string_builder* sb, as_ns_metrics* metrics)
+as_metrics_write_latencies(
+	as_metrics_writer* mw, as_string_builder* sb, as_ns_metrics* metrics, as_metrics_node_prev* np,
+	uint32_t ns_index
+	)
 {
 	for (uint8_t i = 0; i < AS_LATENCY_TYPE_MAX; i++) {
 		if (i > 0) {
@@ -446,12 +522,15 @@ as_metrics_write_latencies(as_string_builder* sb, as_ns_metrics* metrics)
 		as_string_builder_append_char(sb, '[');
 
 		as_latency* latency = as_latency_reserve(metrics->latency[i]);
+		uint64_t* prev = np ? as_metrics_latency_prev_get(np, ns_index, i, latency) : NULL;
 
 		for (uint8_t j = 0; j < latency->size; j++) {
 			if (j > 0) {
 				as_string_builder_append_char(sb, ',');
 			}
-			as_string_builder_append_uint64(sb, as_latency_get_bucket(latency, j));
+			uint64_t count = prev ?
+				as_latency_get_bucket_delta(latency, j, &prev[j]) : as_latency_get_bucket(latency, j);
+			as_string_builder_append_uint64(sb, count);
 		}
 
 		as_latency_release(latency);
@@ -491,6 +570,7 @@ as_metrics_write_node(as_metrics_writer* mw, as_string_builder* sb, struct as_no
 
 	as_ns_metrics** array = node->metrics;
 	uint8_t max = node->metrics_size;
+	as_metrics_node_prev* np = mw->latency_delta ? as_metrics_node_prev_get(mw, node) : NULL;
 
 	for (uint32_t i = 0; i < max; i++) {
 		as_ns_metrics* metrics = array[i];
@@ -511,7 +591,7 @@ as_metrics_write_node(as_metrics_writer* mw, as_string_builder* sb, struct as_no
 		as_string_builder_append_char(sb, ',');
 		as_string_builder_append_uint64(sb, as_node_get_bytes_out(metrics));
 		as_string_builder_append(sb, ",[");
-		as_metrics_write_latencies(sb, metrics);
+		as_metrics_write_latencies(mw, sb, metrics, np, i);
 		as_string_builder_append_char(sb, ']');
 	}
 	as_string_builder_append(sb, "]]");
@@ -620,6 +700,15 @@ as_metrics_writer_destroy(as_metrics_writer* mw)
 {
 	fclose(mw->file);
 	as_metrics_labels_destroy(mw->labels);
+
+	if (mw->latency_prev) {
+		as_vector* list = mw->latency_prev;
+
+		for (uint32_t i = 0; i < list->size; i++) {
+			as_metrics_node_prev_destroy(as_vector_get(list, i));
+		}
+		as_vector_destroy(list);
+	}
 	cf_free(mw);
 }
 
@@ -641,6 +730,11 @@ as_metrics_writer_create(as_error* err, const as_metrics_policy* policy, as_metr
 	mw->max_size = policy->report_size_limit;
 	mw->latency_columns = policy->latency_columns;
 	mw->latency_shift = policy->latency_shift;
+	mw->latency_micros = policy->latency_micros;
+	mw->latency_delta = policy->latency_delta;
+	// Delta snapshots are kept by the writer, so other listeners are not affected.
+	mw->latency_prev = mw->latency_delta ?
+		as_vector_create(sizeof(as_metrics_node_prev), 16) : NULL;
 	mw->enable = false;
 
 #ifdef _MSC_VER
@@ -718,6 +812,10 @@ as_metrics_writer_node_close(as_error* err, as_node* node, void* udata)
 		as_status status = as_metrics_write_line(mw, sb.data, err);
 		
 		as_string_builder_destroy(&sb);
+
+		if (mw->latency_prev) {
+			as_metrics_node_prev_remove(mw, node);
+		}
 		return status;
 	}
 	return AEROSPIKE_OK;
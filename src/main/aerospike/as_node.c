@@ -41,9 +41,6 @@
 // Replicas take ~2K per namespace, so this will cover most deployments:
 #define INFO_STACK_BUF_SIZE (16 * 1024)
 
-// Number of nanoseconds per millisecond
-#define NS_TO_MS 1000000
-
 //---------------------------------
 // Globals
 //---------------------------------
@@ -57,6 +54,15 @@ AS_EXTERN extern char* aerospike_client_version;
 // Empty string namespace for latency metrics without a namespace.
 static const char* as_ns_empty = "";
 
+// Sequence used to assign each thread a home sync connection pool and metrics stripe.
+static uint32_t as_node_thread_seq = 0;
+
+#if defined(_MSC_VER)
+static __declspec(thread) uint32_t as_node_thread_id = 0;
+#else
+__thread uint32_t as_node_thread_id = 0;
+#endif
+
 //---------------------------------
 // Function declarations
 //---------------------------------
@@ -193,14 +199,21 @@ as_node_create(as_cluster* cluster, as_node_info* node_info)
 	}
 
 	node->racks = NULL;
+	node->partition_bitmaps = NULL;
+	node->partition_bitmaps_size = 0;
+	node->partition_bitmaps_stale = false;
 	node->peers_count = 0;
 	node->friends = 0;
 	node->failures = 0;
+	node->latency_ewma = 0;
+	node->inflight = 0;
+	node->latency_p95 = 0;
 	node->index = 0;
 	node->perform_login = 0;
 	node->active = true;
 	node->partition_changed = true;
 	node->rebalance_changed = cluster->rack_aware;
+	node->restarted = false;
 	node->error_rate = 0;
 	node->max_error_rate = cluster->max_error_rate;
 	node->metrics_size = 0;
@@ -253,6 +266,16 @@ as_node_create(as_cluster* cluster, as_node_info* node_info)
 	return node;
 }
 
+static void
+as_node_release_retired(as_latency* latency)
+{
+	while (latency) {
+		as_latency* next = latency->next;
+		cf_free(latency);
+		latency = next;
+	}
+}
+
 static void
 as_node_destroy_metrics(as_node* node)
 {
@@ -265,6 +288,9 @@ as_node_destroy_metrics(as_node* node)
 		for (uint8_t j = 0; j < AS_LATENCY_TYPE_MAX; j++) {
 			cf_free(metrics->latency[j]);
 		}
+
+		as_node_release_retired(metrics->retired);
+		cf_free(metrics->stripes_mem);
 		cf_free(metrics);
 	}
 	cf_free(array);
@@ -293,6 +319,7 @@ as_node_destroy(as_node* node)
 	}
 
 	// Release memory.
+	as_partition_bitmaps_destroy(node);
 	cf_free(node->addresses);
 
 	if (node->hostname) {
@@ -617,6 +644,46 @@ as_node_authenticate_connection(as_cluster* cluster, uint64_t deadline_ms)
 	return status;
 }
 
+uint32_t
+as_node_thread_assign(void)
+{
+	uint32_t id = as_node_thread_id;
+
+	if (id == 0) {
+		// First command on this thread. Zero is reserved for unassigned.
+		do {
+			id = as_faa_uint32(&as_node_thread_seq, 1) + 1;
+		} while (id == 0);
+
+		as_node_thread_id = id;
+	}
+	return id;
+}
+
+static inline uint32_t
+as_node_thread_index(void)
+{
+	uint32_t id = as_node_thread_id;
+	return ((id != 0)? id : as_node_thread_assign()) - 1;
+}
+
+static bool
+as_node_borrow_connection(
+	as_conn_pool* pools, uint32_t max, uint32_t home_index, as_socket* sock, as_conn_pool** pool
+	)
+{
+	// Borrow idle connection from the node's other pools, skipping pools that are locked.
+	for (uint32_t i = 1; i < max; i++) {
+		as_conn_pool* p = &pools[(home_index + i) % max];
+
+		if (as_conn_pool_try_pop_head(p, sock)) {
+			*pool = p;
+			return true;
+		}
+	}
+	return false;
+}
+
 as_status
 as_node_get_connection(
 	as_error* err, as_node* node, as_command* cmd, uint64_t deadline_ms, as_socket* sock,
@@ -628,15 +695,23 @@ as_node_get_connection(
 	uint32_t max = cluster->conn_pools_per_node;
 	uint32_t initial_index;
 	bool backward;
+	bool borrow;
 
 	if (max == 1) {
 		initial_index = 0;
 		backward = false;
+		borrow = false;
+	}
+	else if (cluster->conn_pool_thread_affinity) {
+		initial_index = as_node_thread_index() % max;
+		backward = true;
+		borrow = true;
 	}
 	else {
 		uint32_t iter = node->conn_iter++; // not atomic by design
 		initial_index = iter % max;
 		backward = true;
+		borrow = false;
 	}
 
 	as_socket s;
@@ -644,10 +719,13 @@ as_node_get_connection(
 	uint32_t pool_index = initial_index;
 
 	while (true) {
-		if (as_conn_pool_pop_head(pool, &s)) {
+		as_conn_pool* src = pool;
+
+		if (as_conn_pool_pop_head(pool, &s) ||
+			(borrow && as_node_borrow_connection(pools, max, pool_index, &s, &src))) {
 			// Found socket. Verify that socket is active.
 			if (! as_socket_current_tran(s.last_used, cluster->max_socket_idle_ns_tran)) {
-				as_node_close_connection(node, &s, pool);
+				as_node_close_connection(node, &s, src);
 				continue;
 			}
 
@@ -656,12 +734,12 @@ as_node_get_connection(
 
 			if (len != 0) {
 				as_log_debug("Invalid socket %d from pool: %d", s.fd, len);
-				as_node_close_conn_error(node, &s, pool);
+				as_node_close_conn_error(node, &s, src);
 				continue;
 			}
 
 			*sock = s;
-			sock->pool = pool;
+			sock->pool = src;
 			return AEROSPIKE_OK;
 		}
 		else if (as_conn_pool_incr(pool)) {
@@ -1042,7 +1120,11 @@ as_node_verify_name(as_error* err, as_node* node, const char* name)
 	return AEROSPIKE_OK;
 }
 
-static void
+/**
+ * Reset error rate and rebalance connection pools after a quick node restart.
+ * Must be called from the tend thread.
+ */
+void
 as_node_restart(as_cluster* cluster, as_node* node)
 {
 	as_node_reset_error_rate(node);
@@ -1116,7 +1198,9 @@ as_node_process_response(as_cluster* cluster, as_error* err, as_node* node, as_v
 					as_log_info("Quick node restart detected: node=%s oldgen=%u newgen=%u",
 						as_node_get_address_string(node), node->peers_generation, gen);
 
-					as_node_restart(cluster, node);
+					// Refresh may run in the tend thread pool. Connection pools are
+					// rebalanced later by the tend thread, see as_node_restart().
+					node->restarted = true;
 				}
 			}
 		}
@@ -1235,54 +1319,67 @@ as_node_process_peers(as_cluster* cluster, as_error* err, as_node* node, as_vect
 	return AEROSPIKE_OK;
 }
 
-as_status
-as_node_refresh_peers(as_cluster* cluster, as_error* err, as_node* node, as_peers* peers)
+static const char*
+as_node_peers_command(as_cluster* cluster, size_t* command_len)
 {
-	as_log_debug("Update peers for node %s", as_node_get_address_string(node));
-
-	uint64_t deadline_ms = as_socket_deadline(cluster->conn_timeout_ms);
-	const char* command;
-	size_t command_len;
-
 	if (cluster->tls_ctx) {
 		if (cluster->use_services_alternate) {
-			command = INFO_STR_PEERS_TLS_ALT;
-			command_len = sizeof(INFO_STR_PEERS_TLS_ALT) - 1;
-		}
-		else {
-			command = INFO_STR_PEERS_TLS_STD;
-			command_len = sizeof(INFO_STR_PEERS_TLS_STD) - 1;
+			*command_len = sizeof(INFO_STR_PEERS_TLS_ALT) - 1;
+			return INFO_STR_PEERS_TLS_ALT;
 		}
+		*command_len = sizeof(INFO_STR_PEERS_TLS_STD) - 1;
+		return INFO_STR_PEERS_TLS_STD;
 	}
-	else {
-		if (cluster->use_services_alternate) {
-			command = INFO_STR_PEERS_CLEAR_ALT;
-			command_len = sizeof(INFO_STR_PEERS_CLEAR_ALT) - 1;
-		}
-		else {
-			command = INFO_STR_PEERS_CLEAR_STD;
-			command_len = sizeof(INFO_STR_PEERS_CLEAR_STD) - 1;
-		}
+
+	if (cluster->use_services_alternate) {
+		*command_len = sizeof(INFO_STR_PEERS_CLEAR_ALT) - 1;
+		return INFO_STR_PEERS_CLEAR_ALT;
 	}
-	
+	*command_len = sizeof(INFO_STR_PEERS_CLEAR_STD) - 1;
+	return INFO_STR_PEERS_CLEAR_STD;
+}
+
+/**
+ * Send info command and return a heap copy of the response that the caller must free.
+ * Used by parallel tend where responses are processed after all nodes have replied.
+ */
+static as_status
+as_node_fetch_info(
+	as_cluster* cluster, as_error* err, as_node* node, const char* command, size_t command_len,
+	char** response
+	)
+{
+	uint64_t deadline_ms = as_socket_deadline(cluster->conn_timeout_ms);
 	uint8_t stack_buf[INFO_STACK_BUF_SIZE];
 	uint8_t* buf = as_node_get_info(err, node, command, command_len, deadline_ms, stack_buf);
-	
+
 	if (! buf) {
 		as_node_close_socket(node, &node->info_socket);
+		*response = NULL;
 		return err->code;
 	}
-	
+
+	if (buf == stack_buf) {
+		size_t len = strlen((char*)buf) + 1;
+		char* copy = cf_malloc(len);
+		memcpy(copy, buf, len);
+		*response = copy;
+	}
+	else {
+		*response = (char*)buf;
+	}
+	return AEROSPIKE_OK;
+}
+
+as_status
+as_node_apply_peers(as_cluster* cluster, as_error* err, as_node* node, char* response, as_peers* peers)
+{
 	as_vector values;
 	as_vector_inita(&values, sizeof(as_name_value), 4);
-	
-	as_info_parse_multi_response((char*)buf, &values);
+
+	as_info_parse_multi_response(response, &values);
 	as_status status = as_node_process_peers(cluster, err, node, &values, peers);
-	
-	if (buf != stack_buf) {
-		cf_free(buf);
-	}
-	
+
 	as_vector_destroy(&values);
 
 	if (status == AEROSPIKE_OK) {
@@ -1291,6 +1388,40 @@ as_node_refresh_peers(as_cluster* cluster, as_error* err, as_node* node, as_peer
 	return status;
 }
 
+as_status
+as_node_fetch_peers(as_cluster* cluster, as_error* err, as_node* node, char** response)
+{
+	size_t command_len;
+	const char* command = as_node_peers_command(cluster, &command_len);
+
+	return as_node_fetch_info(cluster, err, node, command, command_len, response);
+}
+
+as_status
+as_node_refresh_peers(as_cluster* cluster, as_error* err, as_node* node, as_peers* peers)
+{
+	as_log_debug("Update peers for node %s", as_node_get_address_string(node));
+
+	uint64_t deadline_ms = as_socket_deadline(cluster->conn_timeout_ms);
+	size_t command_len;
+	const char* command = as_node_peers_command(cluster, &command_len);
+
+	uint8_t stack_buf[INFO_STACK_BUF_SIZE];
+	uint8_t* buf = as_node_get_info(err, node, command, command_len, deadline_ms, stack_buf);
+
+	if (! buf) {
+		as_node_close_socket(node, &node->info_socket);
+		return err->code;
+	}
+
+	as_status status = as_node_apply_peers(cluster, err, node, (char*)buf, peers);
+
+	if (buf != stack_buf) {
+		cf_free(buf);
+	}
+	return status;
+}
+
 static const char INFO_STR_GET_REPLICAS_REGIME[] = "partition-generation\nreplicas\n";
 
 static as_status
@@ -1312,6 +1443,26 @@ as_node_process_partitions(as_cluster* cluster, as_error* err, as_node* node, as
 	return AEROSPIKE_OK;
 }
 
+as_status
+as_node_apply_partitions(as_cluster* cluster, as_error* err, as_node* node, char* response)
+{
+	as_vector values;
+	as_vector_inita(&values, sizeof(as_name_value), 4);
+
+	as_info_parse_multi_response(response, &values);
+	as_status status = as_node_process_partitions(cluster, err, node, &values);
+
+	as_vector_destroy(&values);
+	return status;
+}
+
+as_status
+as_node_fetch_partitions(as_cluster* cluster, as_error* err, as_node* node, char** response)
+{
+	return as_node_fetch_info(cluster, err, node, INFO_STR_GET_REPLICAS_REGIME,
+		sizeof(INFO_STR_GET_REPLICAS_REGIME) - 1, response);
+}
+
 as_status
 as_node_refresh_partitions(as_cluster* cluster, as_error* err, as_node* node)
 {
@@ -1329,17 +1480,11 @@ as_node_refresh_partitions(as_cluster* cluster, as_error* err, as_node* node)
 		return err->code;
 	}
 
-	as_vector values;
-	as_vector_inita(&values, sizeof(as_name_value), 4);
-
-	as_info_parse_multi_response((char*)buf, &values);
-	as_status status = as_node_process_partitions(cluster, err, node, &values);
+	as_status status = as_node_apply_partitions(cluster, err, node, (char*)buf);
 
 	if (buf != stack_buf) {
 		cf_free(buf);
 	}
-
-	as_vector_destroy(&values);
 	return status;
 }
 
@@ -1468,14 +1613,23 @@ as_node_parse_racks(as_cluster* cluster, as_error* err, as_node* node, char* buf
 	return AEROSPIKE_OK;
 }
 
-/**
- * Use non-inline function for garbarge collector function pointer reference.
- * Forward to inlined release.
- */
-static inline void
-release_latency(as_latency* latency)
+static as_latency*
+as_node_take_retired(as_ns_metrics* metrics, const as_metrics_policy* policy)
 {
-	as_latency_release(latency);
+	as_latency** prev = &metrics->retired;
+	as_latency* latency = metrics->retired;
+
+	while (latency) {
+		if (policy->latency_columns == latency->size && policy->latency_shift == latency->shift &&
+			policy->latency_micros == latency->micros) {
+			*prev = latency->next;
+			latency->next = NULL;
+			return latency;
+		}
+		prev = &latency->next;
+		latency = latency->next;
+	}
+	return NULL;
 }
 
 void
@@ -1492,27 +1646,31 @@ as_node_enable_metrics(as_node* node, const as_metrics_policy* policy)
 		for (uint8_t j = 0; j < AS_LATENCY_TYPE_MAX; j++) {
 			as_latency* latency = metrics->latency[j];
 
-			if (policy->latency_columns == latency->size && policy->latency_shift == latency->shift) {
+			if (policy->latency_columns == latency->size && policy->latency_shift == latency->shift &&
+				policy->latency_micros == latency->micros) {
 				// Initialize existing latency histogram.
-				for (uint8_t k = 0; k < latency->size; k++) {
-					as_store_uint64(&latency->buckets[k], 0);
-				}
+				as_latency_clear(latency);
 			}
 			else {
-				// Create new latency histogram.
+				// Reuse a retired histogram with the same layout or create a new one.
 				as_latency* latency_old = latency;
-				latency = cf_calloc(1, sizeof(as_latency) + (sizeof(uint64_t) * policy->latency_columns));
-				latency->ref_count = 1;
-				latency->shift = policy->latency_shift;
-				latency->size = policy->latency_columns;
+				latency = as_node_take_retired(metrics, policy);
+
+				if (latency) {
+					as_latency_clear(latency);
+				}
+				else {
+					latency = as_latency_create(policy->latency_columns, policy->latency_shift,
+						policy->latency_micros);
+				}
 
 				as_store_ptr_rls((void**)&metrics->latency[j], latency);
 
-				// Put old latency on garbage collector stack.
-				as_gc_item item;
-				item.data = latency_old;
-				item.release_fn = (as_release_fn)release_latency;
-				as_vector_append(node->cluster->gc, &item);
+				// Commands increment histograms without reserving them, so a command may still
+				// hold the old histogram. The old histogram is retired instead of released.
+				// Retired histograms are only released in as_node_destroy().
+				latency_old->next = metrics->retired;
+				metrics->retired = latency_old;
 			}
 		}
 	}
@@ -1557,30 +1715,31 @@ as_node_append_metrics(as_node* node, const char* ns)
 	if (!metrics) {
 		metrics = cf_malloc(sizeof(as_ns_metrics));
 		metrics->ns = ns;
-		metrics->bytes_in = 0;
-		metrics->bytes_out = 0;
-		metrics->error_count = 0;
-		metrics->timeout_count = 0;
-		metrics->key_busy_count = 0;
+		metrics->retired = NULL;
+
+		// Allocate an extra stripe so stripes can be aligned on a cache line boundary.
+		uintptr_t line = sizeof(as_ns_metrics_stripe);
+		metrics->stripes_mem = cf_calloc(AS_METRICS_STRIPES + 1, line);
+		metrics->stripes = (as_ns_metrics_stripe*)
+			(((uintptr_t)metrics->stripes_mem + line - 1) & ~(line - 1));
 
 		uint8_t latency_columns;
 		uint8_t latency_shift;
+		bool latency_micros;
 
 		if (cluster->metrics_enabled) {
 			latency_columns = cluster->metrics_latency_columns;
 			latency_shift = cluster->metrics_latency_shift;
+			latency_micros = cluster->metrics_latency_micros;
 		}
 		else {
 			latency_columns = 1;
 			latency_shift = 1;
+			latency_micros = false;
 		}
 
 		for (uint8_t i = 0; i < AS_LATENCY_TYPE_MAX; i++) {
-			as_latency* latency = cf_calloc(1, sizeof(as_latency) + (sizeof(uint64_t) * latency_columns));
-			latency->ref_count = 1;
-			latency->shift = latency_shift;
-			latency->size = latency_columns;
-			metrics->latency[i] = latency;
+			metrics->latency[i] = as_latency_create(latency_columns, latency_shift, latency_micros);
 		}
 		node->metrics[node->metrics_size++] = metrics;
 	}
@@ -1604,42 +1763,76 @@ as_node_prepare_metrics(as_node* node, const char* ns)
 	return metrics;
 }
 
-static inline uint8_t
-as_latency_get_index(as_latency* latency, uint64_t elapsed)
+void
+as_node_add_latency(as_ns_metrics* metrics, as_latency_type latency_type, uint64_t elapsed_nanos)
 {
-	uint64_t limit = 1;
-	uint8_t last_bucket = latency->size - 1;
-
-	for (uint8_t i = 0; i < last_bucket; i++) {
-		if (elapsed <= limit) {
-			return i;
-		}
-		limit <<= latency->shift;
+	if (!metrics) {
+		return;
 	}
-	return last_bucket;
+
+	// Histograms are never freed while the node is active, so a reservation is not required.
+	as_latency* latency = (as_latency*)as_load_ptr((void* const*)&metrics->latency[latency_type]);
+	as_latency_add(latency, as_node_metrics_stripe(), elapsed_nanos);
 }
 
 void
-as_node_add_latency(as_ns_metrics* metrics, as_latency_type latency_type, uint64_t elapsed_nanos)
+as_node_add_replica_latency(as_node* node, uint64_t elapsed_nanos)
 {
-	if (!metrics) {
-		return;
+	uint64_t sample = elapsed_nanos / 1000;
+
+	if (sample > UINT32_MAX) {
+		sample = UINT32_MAX;
 	}
 
-	// Convert nanoseconds to milliseconds.
-	uint64_t elapsed = elapsed_nanos / NS_TO_MS;
+	// Weight new sample by 1/8. Concurrent updates may lose a sample, which is acceptable
+	// for an average.
+	uint64_t avg = as_load_uint32(&node->latency_ewma);
+
+	avg = (avg == 0)? sample : (avg * 7 + sample) >> 3;
 
-	// Round up elapsed to nearest millisecond.
-	if ((elapsed_nanos - (elapsed * NS_TO_MS)) > 0) {
-		elapsed++;
+	// Zero is reserved for no samples.
+	as_store_uint32(&node->latency_ewma, avg > 0 ? (uint32_t)avg : 1);
+
+	// Frugal streaming quantile estimate. Move up 19 steps for every step down, so the
+	// estimate settles where 1 in 20 samples exceed it. The step scales with the estimate
+	// so it adapts at any latency range.
+	uint64_t p95 = as_load_uint32(&node->latency_p95);
+
+	if (p95 == 0) {
+		p95 = sample;
 	}
+	else {
+		uint64_t step = (p95 >> 3) + 20;
 
-	as_latency* latency = as_latency_reserve(metrics->latency[latency_type]);
+		if (sample > p95) {
+			p95 += step * 19 / 20;
 
-	uint8_t index = as_latency_get_index(latency, elapsed);
-	as_incr_uint64(&latency->buckets[index]);
+			if (p95 > sample) {
+				p95 = sample;
+			}
+		}
+		else if (sample < p95) {
+			uint64_t down = step / 20;
+			p95 = (p95 > down)? p95 - down : sample;
+		}
+	}
 
-	as_latency_release(latency);
+	if (p95 > UINT32_MAX) {
+		p95 = UINT32_MAX;
+	}
+	as_store_uint32(&node->latency_p95, p95 > 0 ? (uint32_t)p95 : 1);
+}
+
+void
+as_node_decay_replica_latency(as_node* node)
+{
+	// Nodes that are not chosen receive no new samples. Halve the average every tend
+	// iteration so a node that was slow once is retried after it recovers.
+	uint32_t avg = as_load_uint32(&node->latency_ewma);
+
+	if (avg > 1) {
+		as_store_uint32(&node->latency_ewma, avg >> 1);
+	}
 }
 
 void
@@ -1653,7 +1846,7 @@ as_node_add_error(as_node* node, const char* ns, as_ns_metrics* metrics)
 			return;
 		}
 	}
-	as_incr_uint64(&metrics->error_count);
+	as_incr_uint64(&metrics->stripes[as_node_metrics_stripe()].error_count);
 }
 
 void
@@ -1667,7 +1860,7 @@ as_node_add_timeout(as_node* node, const char* ns, as_ns_metrics* metrics)
 			return;
 		}
 	}
-	as_incr_uint64(&metrics->timeout_count);
+	as_incr_uint64(&metrics->stripes[as_node_metrics_stripe()].timeout_count);
 }
 
 void
@@ -1681,7 +1874,7 @@ as_node_add_key_busy(as_node* node, const char* ns, as_ns_metrics* metrics)
 			return;
 		}
 	}
-	as_incr_uint64(&metrics->key_busy_count);
+	as_incr_uint64(&metrics->stripes[as_node_metrics_stripe()].key_busy_count);
 }
 
 static as_status
@@ -1712,6 +1905,26 @@ as_node_process_racks(as_cluster* cluster, as_error* err, as_node* node, as_vect
 
 static const char INFO_STR_GET_RACKS[] = "rebalance-generation\nrack-ids\n";
 
+as_status
+as_node_apply_racks(as_cluster* cluster, as_error* err, as_node* node, char* response)
+{
+	as_vector values;
+	as_vector_inita(&values, sizeof(as_name_value), 4);
+
+	as_info_parse_multi_response(response, &values);
+	as_status status = as_node_process_racks(cluster, err, node, &values);
+
+	as_vector_destroy(&values);
+	return status;
+}
+
+as_status
+as_node_fetch_racks(as_cluster* cluster, as_error* err, as_node* node, char** response)
+{
+	return as_node_fetch_info(cluster, err, node, INFO_STR_GET_RACKS,
+		sizeof(INFO_STR_GET_RACKS) - 1, response);
+}
+
 as_status
 as_node_refresh_racks(as_cluster* cluster, as_error* err, as_node* node)
 {
@@ -1727,16 +1940,10 @@ as_node_refresh_racks(as_cluster* cluster, as_error* err, as_node* node)
 		return err->code;
 	}
 
-	as_vector values;
-	as_vector_inita(&values, sizeof(as_name_value), 4);
-
-	as_info_parse_multi_response((char*)buf, &values);
-	as_status status = as_node_process_racks(cluster, err, node, &values);
+	as_status status = as_node_apply_racks(cluster, err, node, (char*)buf);
 
 	if (buf != stack_buf) {
 		cf_free(buf);
 	}
-
-	as_vector_destroy(&values);
 	return status;
 }
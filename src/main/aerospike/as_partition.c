@@ -25,6 +25,7 @@
 #include <aerospike/as_string.h>
 #include <citrusleaf/cf_b64.h>
 #include <stdlib.h>
+#include <string.h>
 
 /******************************************************************************
  * Functions
@@ -210,6 +211,65 @@ get_replica_rack(
 	return NULL;
 }
 
+static as_node*
+get_replica_fastest(
+	as_partition* p, as_node* prev_node, uint8_t replica_size, uint8_t* replica_index
+	)
+{
+	// Power of two choices. Compare the first two valid candidates starting at replica_index
+	// and choose the one with the lowest expected latency. replica_index rotates per command,
+	// so all replicas are candidates when replication factor is greater than two.
+	as_node* best = NULL;
+	as_node* fallback = NULL;
+	uint64_t best_score = 0;
+	uint8_t best_index = 0;
+	uint8_t fallback_index = 0;
+	uint32_t candidates = 0;
+
+	for (uint8_t i = 0; i < replica_size; i++) {
+		uint8_t index = (uint8_t)((*replica_index + i) % replica_size);
+		as_node* node = as_node_load(&p->nodes[index]);
+
+		if (! (node && as_node_is_active(node))) {
+			continue;
+		}
+
+		// Avoid retrying on node where command failed. The contents of prev_node may have
+		// already been destroyed, so just use pointer comparison.
+		if (node == prev_node) {
+			if (! fallback) {
+				fallback = node;
+				fallback_index = index;
+			}
+			continue;
+		}
+
+		uint64_t score = as_node_replica_score(node);
+
+		if (! best || score < best_score) {
+			best = node;
+			best_score = score;
+			best_index = index;
+		}
+
+		if (++candidates == 2) {
+			break;
+		}
+	}
+
+	if (best) {
+		*replica_index = best_index;
+		return best;
+	}
+
+	// Return previous node if it still exists.
+	if (fallback) {
+		*replica_index = fallback_index;
+		return fallback;
+	}
+	return NULL;
+}
+
 as_node*
 as_partition_reg_get_node(
 	as_cluster* cluster, const char* ns, as_partition* p, as_node* prev_node,
@@ -223,6 +283,9 @@ as_partition_reg_get_node(
 		case AS_POLICY_REPLICA_PREFER_RACK:
 			return get_replica_rack(cluster, ns, p, prev_node, replica_size, replica_index);
 
+		case AS_POLICY_REPLICA_FASTEST:
+			return get_replica_fastest(p, prev_node, replica_size, replica_index);
+
 		// The remaining replica algorithms use replica_index as the starting point
 		// and iterate till a valid node is found.
 		default:
@@ -238,7 +301,7 @@ as_partition_info_init(as_partition_info* pi, as_cluster* cluster, as_error* err
 {
 	if (cluster->shm_info) {
 		as_cluster_shm* cluster_shm = cluster->shm_info->cluster_shm;
-		as_partition_table_shm* table = as_shm_find_partition_table(cluster_shm, key->ns);
+		as_partition_table_shm* table = as_shm_lookup_partition_table(cluster->shm_info, key->ns);
 
 		if (! table) {
 			as_nodes* nodes = as_nodes_reserve(cluster);
@@ -285,24 +348,55 @@ as_partition_info_init(as_partition_info* pi, as_cluster* cluster, as_error* err
 as_partition_table*
 as_partition_tables_get(as_partition_tables* tables, const char* ns)
 {
-	uint32_t max = as_load_uint32_acq(&tables->size);
-	
-	for (uint32_t i = 0; i < max; i++) {
-		as_partition_table* table = tables->tables[i];
+	uint32_t hash = as_partition_ns_hash(ns);
+	uint32_t slot = hash & (AS_PARTITION_NS_INDEX_SIZE - 1);
+
+	// The index always has empty slots because AS_PARTITION_NS_INDEX_SIZE > AS_MAX_NAMESPACES.
+	while (true) {
+		uint8_t offset = as_load_uint8_acq(&tables->index[slot]);
 
-		if (strcmp(table->ns, ns) == 0) {
-			return table;
+		if (offset == 0) {
+			return NULL;
 		}
+
+		uint32_t i = offset - 1;
+
+		if (tables->hashes[i] == hash) {
+			as_partition_table* table = tables->tables[i];
+
+			if (strcmp(table->ns, ns) == 0) {
+				return table;
+			}
+		}
+		slot = (slot + 1) & (AS_PARTITION_NS_INDEX_SIZE - 1);
 	}
-	return NULL;
+}
+
+static void
+as_partition_tables_add(as_partition_tables* tables, as_partition_table* table)
+{
+	// Only called from tend thread.
+	uint32_t i = tables->size;
+	uint32_t hash = as_partition_ns_hash(table->ns);
+	uint32_t slot = hash & (AS_PARTITION_NS_INDEX_SIZE - 1);
+
+	while (tables->index[slot] != 0) {
+		slot = (slot + 1) & (AS_PARTITION_NS_INDEX_SIZE - 1);
+	}
+
+	tables->tables[i] = table;
+	tables->hashes[i] = hash;
+
+	// Publish table to readers of the index and readers that iterate tables.
+	as_store_uint8_rls(&tables->index[slot], (uint8_t)(i + 1));
+	as_store_uint32_rls(&tables->size, i + 1);
 }
 
 const char*
 as_partition_tables_get_ns(as_cluster* cluster, const char* ns)
 {
 	if (cluster->shm_info) {
-		as_cluster_shm* cluster_shm = cluster->shm_info->cluster_shm;
-		as_partition_table_shm* table = as_shm_find_partition_table(cluster_shm, ns);
+		as_partition_table_shm* table = as_shm_lookup_partition_table(cluster->shm_info, ns);
 		return table ? table->ns : NULL;
 	}
 	else {
@@ -311,61 +405,207 @@ as_partition_tables_get_ns(as_cluster* cluster, const char* ns)
 	}
 }
 
-static inline void
-force_replicas_refresh(as_node* node)
+static as_partition_bitmaps*
+as_partition_bitmaps_get(as_node* node, const char* ns)
 {
-	node->partition_generation = (uint32_t)-1;
+	for (uint8_t i = 0; i < node->partition_bitmaps_size; i++) {
+		as_partition_bitmaps* entry = &node->partition_bitmaps[i];
+
+		if (strcmp(entry->ns, ns) == 0) {
+			return entry;
+		}
+	}
+
+	if (node->partition_bitmaps_size >= AS_MAX_NAMESPACES) {
+		return NULL;
+	}
+
+	if (!node->partition_bitmaps) {
+		node->partition_bitmaps = cf_malloc(sizeof(as_partition_bitmaps) * AS_MAX_NAMESPACES);
+	}
+
+	as_partition_bitmaps* entry = &node->partition_bitmaps[node->partition_bitmaps_size++];
+	as_strncpy(entry->ns, ns, sizeof(entry->ns));
+	memset(entry->regime, 0, sizeof(entry->regime));
+	memset(entry->bitmaps, 0, sizeof(entry->bitmaps));
+	return entry;
 }
 
-static void
-decode_and_update(
-	char* bitmap_b64, uint32_t len, as_partition_table* table, as_node* node,
-	uint8_t replica_index, uint32_t regime, bool* regime_error
+static inline uint32_t
+as_partition_bitmap_add_ids(uint8_t bits, uint32_t offset, uint32_t max, uint32_t* ids,
+	uint32_t count)
+{
+	// Bitmap is in network bit order. The most significant bit is the lowest partition id.
+	while (bits) {
+		uint32_t bit = 0;
+
+		while ((bits & (0x80 >> bit)) == 0) {
+			bit++;
+		}
+		bits &= (uint8_t)~(0x80 >> bit);
+
+		uint32_t id = offset + bit;
+
+		if (id < max) {
+			ids[count++] = id;
+		}
+	}
+	return count;
+}
+
+uint32_t
+as_partition_bitmap_decode(
+	as_node* node, const char* ns, char* bitmap_b64, uint32_t len, uint32_t n_partitions,
+	uint8_t replica_index, uint32_t regime, bool full, uint32_t* ids
 	)
 {
+	uint32_t bitmap_size = (n_partitions + 7) / 8;
+
 	// Size allows for padding - is actual size rounded up to multiple of 3.
 	uint8_t* bitmap = (uint8_t*)alloca(cf_b64_decoded_buf_size(len));
 
 	// For now - for speed - trust validity of encoded characters.
 	cf_b64_decode(bitmap_b64, len, bitmap, NULL);
 
-	// Expand the bitmap.
-	for (uint32_t i = 0; i < table->size; i++) {
-		if ((bitmap[i >> 3] & (0x80 >> (i & 7))) != 0) {
-			// This node claims ownership of partition.
-			// as_log_debug("Set partition %s:%s:%u:%s", master? "master" : "prole", table->ns, i,
-			//				node->name);
-
-			// Volatile reads are not necessary because the tend thread exclusively modifies
-			// partition.  Volatile writes are used so other threads can view change.
-			as_partition* p = &table->partitions[i];
-
-			if (regime >= p->regime) {
-				if (regime > p->regime) {
-					p->regime = regime;
-				}
+	as_partition_bitmaps* entry = as_partition_bitmaps_get(node, ns);
+	uint8_t* prev = NULL;
 
-				as_node* node_old = p->nodes[replica_index];
+	if (entry) {
+		prev = entry->bitmaps[replica_index];
 
-				if (node != node_old) {
-					as_partition_reserve_node(node);
-					as_node_store(&p->nodes[replica_index], node);
+		if (!prev) {
+			entry->bitmaps[replica_index] = cf_malloc(bitmap_size);
+		}
+		else if (full || entry->regime[replica_index] != regime) {
+			prev = NULL;
+		}
+		else if (memcmp(prev, bitmap, bitmap_size) == 0) {
+			// Node claims the same partitions as before. Nothing to update.
+			return 0;
+		}
+	}
 
-					if (node_old) {
-						force_replicas_refresh(node_old);
-						as_partition_release_node_delayed(node_old);
-					}
-				}
+	uint32_t count = 0;
+	uint32_t i = 0;
+
+	// Compare 8 bytes at a time and skip words where no partition is newly claimed.
+	if (prev) {
+		for (; i + 8 <= bitmap_size; i += 8) {
+			uint64_t cur_word;
+			uint64_t prev_word;
+			memcpy(&cur_word, bitmap + i, sizeof(uint64_t));
+			memcpy(&prev_word, prev + i, sizeof(uint64_t));
+
+			if ((cur_word & ~prev_word) == 0) {
+				continue;
 			}
-			else {
-				if (!(*regime_error)) {
-					as_log_info("%s regime(%u) < old regime(%u)",
-								as_node_get_address_string(node), regime, p->regime);
-					*regime_error = true;
+
+			for (uint32_t j = i; j < i + 8; j++) {
+				count = as_partition_bitmap_add_ids(bitmap[j] & (uint8_t)~prev[j], j * 8,
+					n_partitions, ids, count);
+			}
+		}
+
+		for (; i < bitmap_size; i++) {
+			count = as_partition_bitmap_add_ids(bitmap[i] & (uint8_t)~prev[i], i * 8,
+				n_partitions, ids, count);
+		}
+	}
+	else {
+		for (; i + 8 <= bitmap_size; i += 8) {
+			uint64_t cur_word;
+			memcpy(&cur_word, bitmap + i, sizeof(uint64_t));
+
+			if (cur_word == 0) {
+				continue;
+			}
+
+			for (uint32_t j = i; j < i + 8; j++) {
+				count = as_partition_bitmap_add_ids(bitmap[j], j * 8, n_partitions, ids, count);
+			}
+		}
+
+		for (; i < bitmap_size; i++) {
+			count = as_partition_bitmap_add_ids(bitmap[i], i * 8, n_partitions, ids, count);
+		}
+	}
+
+	if (entry) {
+		memcpy(entry->bitmaps[replica_index], bitmap, bitmap_size);
+		entry->regime[replica_index] = regime;
+	}
+	return count;
+}
+
+void
+as_partition_bitmaps_destroy(as_node* node)
+{
+	for (uint8_t i = 0; i < node->partition_bitmaps_size; i++) {
+		as_partition_bitmaps* entry = &node->partition_bitmaps[i];
+
+		for (uint32_t j = 0; j < AS_MAX_REPLICATION_FACTOR; j++) {
+			cf_free(entry->bitmaps[j]);
+		}
+	}
+	cf_free(node->partition_bitmaps);
+	node->partition_bitmaps = NULL;
+	node->partition_bitmaps_size = 0;
+}
+
+static inline void
+force_replicas_refresh(as_node* node)
+{
+	node->partition_generation = (uint32_t)-1;
+	node->partition_bitmaps_stale = true;
+}
+
+static uint32_t
+decode_and_update(
+	char* bitmap_b64, uint32_t len, as_partition_table* table, as_node* node,
+	uint8_t replica_index, uint32_t regime, bool full, bool* regime_error
+	)
+{
+	uint32_t* ids = (uint32_t*)alloca(sizeof(uint32_t) * table->size);
+	uint32_t n_ids = as_partition_bitmap_decode(node, table->ns, bitmap_b64, len, table->size,
+		replica_index, regime, full, ids);
+	uint32_t changed = 0;
+
+	for (uint32_t i = 0; i < n_ids; i++) {
+		// This node claims ownership of partition.
+		// as_log_debug("Set partition %s:%s:%u:%s", master? "master" : "prole", table->ns, ids[i],
+		//				node->name);
+
+		// Volatile reads are not necessary because the tend thread exclusively modifies
+		// partition.  Volatile writes are used so other threads can view change.
+		as_partition* p = &table->partitions[ids[i]];
+
+		if (regime >= p->regime) {
+			if (regime > p->regime) {
+				p->regime = regime;
+			}
+
+			as_node* node_old = p->nodes[replica_index];
+
+			if (node != node_old) {
+				as_partition_reserve_node(node);
+				as_node_store(&p->nodes[replica_index], node);
+				changed++;
+
+				if (node_old) {
+					force_replicas_refresh(node_old);
+					as_partition_release_node_delayed(node_old);
 				}
 			}
 		}
+		else {
+			if (!(*regime_error)) {
+				as_log_info("%s regime(%u) < old regime(%u)",
+							as_node_get_address_string(node), regime, p->regime);
+				*regime_error = true;
+			}
+		}
 	}
+	return changed;
 }
 
 bool
@@ -386,6 +626,11 @@ as_partition_tables_update_all(as_cluster* cluster, as_node* node, char* buf)
 	uint32_t regime = 0;
 	bool regime_error = false;
 
+	// Apply all claimed partitions when another node took over partitions from this node
+	// since its last update. Otherwise, only apply partitions that this node newly claims.
+	bool full = node->partition_bitmaps_stale;
+	node->partition_bitmaps_stale = false;
+
 	while (*p) {
 		if (*p == ':') {
 			// Parse namespace.
@@ -394,6 +639,7 @@ as_partition_tables_update_all(as_cluster* cluster, as_node* node, char* buf)
 			
 			if (len <= 0 || len >= 32) {
 				as_log_error("Partition update. Invalid partition namespace %s", ns);
+				node->partition_bitmaps_stale = true;
 				return false;
 			}
 			begin = ++p;
@@ -422,6 +668,7 @@ as_partition_tables_update_all(as_cluster* cluster, as_node* node, char* buf)
 
 			if (replication_factor <= 0 || replication_factor > 255) {
 				as_log_error("Invalid replication factor: %s %d", ns, replication_factor);
+				node->partition_bitmaps_stale = true;
 				return false;
 			}
 
@@ -446,14 +693,16 @@ as_partition_tables_update_all(as_cluster* cluster, as_node* node, char* buf)
 					as_log_error(
 						"Partition update. unexpected partition map encoded length %" PRId64 " for namespace %s",
 						len, ns);
+					node->partition_bitmaps_stale = true;
 					return false;
 				}
 				
 				// Only handle AS_MAX_REPLICATION_FACTOR levels. Do not process other proles.
 				if (replica_index < AS_MAX_REPLICATION_FACTOR) {
 					if (cluster->shm_info) {
-						as_shm_update_partitions(cluster->shm_info, ns, begin, len, node,
-							replica_size, replica_index, regime);
+						cluster->tend_partitions_changed += as_shm_update_partitions(
+							cluster->shm_info, ns, begin, len, node, replica_size, replica_index,
+							regime, full);
 					}
 					else {
 						as_partition_table* table = as_partition_tables_get(tables, ns);
@@ -463,6 +712,7 @@ as_partition_tables_update_all(as_cluster* cluster, as_node* node, char* buf)
 							if (tables->size >= AS_MAX_NAMESPACES) {
 								as_log_error("Partition update. Max namespaces exceeded %u",
 											 AS_MAX_NAMESPACES);
+								node->partition_bitmaps_stale = true;
 								return false;
 							}
 
@@ -474,12 +724,11 @@ as_partition_tables_update_all(as_cluster* cluster, as_node* node, char* buf)
 						}
 						
 						// Decode partition bitmap and update client's view.
-						decode_and_update(begin, (uint32_t)len, table, node, replica_index, regime,
-							&regime_error);
+						cluster->tend_partitions_changed += decode_and_update(begin, (uint32_t)len,
+							table, node, replica_index, regime, full, &regime_error);
 
 						if (create) {
-							tables->tables[tables->size] = table;
-							as_store_uint32_rls(&tables->size, tables->size + 1);
+							as_partition_tables_add(tables, table);
 						}
 					}
 				}
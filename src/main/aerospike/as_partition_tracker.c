@@ -121,7 +121,9 @@ tracker_init(
 	pt->max_records = max_records;
 	pt->record_count = 0;
 	pt->check_max = false;
-	pt->replica = replica;
+	// AS_POLICY_REPLICA_FASTEST is driven by single record read latency. Partitions are
+	// already well distributed across nodes in scan/query, so use SEQUENCE instead.
+	pt->replica = (replica == AS_POLICY_REPLICA_FASTEST)? AS_POLICY_REPLICA_SEQUENCE : replica;
 
 	pt->sleep_between_retries = policy->sleep_between_retries;
 	pt->connect_timeout = policy->connect_timeout;
@@ -370,8 +372,7 @@ as_partition_tracker_assign(
 		}
 	}
 	else {
-		as_cluster_shm* cluster_shm = cluster->shm_info->cluster_shm;
-		as_partition_table_shm* table = as_shm_find_partition_table(cluster_shm, ns);
+		as_partition_table_shm* table = as_shm_lookup_partition_table(cluster->shm_info, ns);
 
 		if (! table) {
 			return as_error_update(err, AEROSPIKE_ERR_NAMESPACE_NOT_FOUND, "Invalid namespace: %s",
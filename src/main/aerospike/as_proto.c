@@ -15,6 +15,7 @@
  * the License.
  */
 #include <aerospike/as_proto.h>
+#include <aerospike/as_compress.h>
 #include <citrusleaf/cf_byte_order.h>
 #include <string.h>
 #include <zlib.h>
@@ -98,8 +99,8 @@ as_proto_parse(as_error* err, as_proto* proto)
 as_status
 as_proto_decompress(as_error* err, uint8_t* trg, size_t trg_sz, uint8_t* src, size_t src_sz)
 {
-	uLongf sz = (uLongf)trg_sz;
-	int rv = uncompress(trg, &sz, src + sizeof(uint64_t), (uLong)(src_sz - sizeof(uint64_t)));
+	size_t sz = trg_sz;
+	int rv = as_decompress(trg, &sz, src + sizeof(uint64_t), src_sz - sizeof(uint64_t));
 
 	if (rv != Z_OK) {
 		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Decompress failed: %d", rv);
@@ -175,6 +175,129 @@ as_record_destroy(as_record* rec)
 	as_rec_destroy((as_rec *) rec);
 }
 
+static void*
+as_record_copy_buf(const void* src, size_t size, bool terminate)
+{
+	uint8_t* trg = cf_malloc(terminate ? size + 1 : size);
+	memcpy(trg, src, size);
+
+	if (terminate) {
+		trg[size] = 0;
+	}
+	return trg;
+}
+
+static void
+as_record_copy_key(as_key* trg, const as_key* src)
+{
+	strcpy(trg->ns, src->ns);
+	strcpy(trg->set, src->set);
+	trg->digest.init = src->digest.init;
+	memcpy(trg->digest.value, src->digest.value, AS_DIGEST_VALUE_SIZE);
+
+	as_val* val = (as_val*)src->valuep;
+
+	if (! val) {
+		trg->valuep = NULL;
+		return;
+	}
+
+	switch (val->type) {
+		case AS_INTEGER:
+			as_integer_init((as_integer*)&trg->value, ((as_integer*)val)->value);
+			break;
+
+		case AS_DOUBLE:
+			as_double_init((as_double*)&trg->value, ((as_double*)val)->value);
+			break;
+
+		case AS_STRING: {
+			as_string* s = (as_string*)val;
+			size_t len = as_string_len(s);
+			char* v = as_record_copy_buf(s->value, len, true);
+			as_string_init_wlen((as_string*)&trg->value, v, len, true);
+			break;
+		}
+
+		case AS_BYTES: {
+			as_bytes* b = (as_bytes*)val;
+			uint8_t* v = as_record_copy_buf(b->value, b->size, false);
+			as_bytes_init_wrap((as_bytes*)&trg->value, v, b->size, true);
+			break;
+		}
+
+		default:
+			trg->valuep = NULL;
+			return;
+	}
+	trg->valuep = &trg->value;
+}
+
+as_record*
+as_record_copy(const as_record* src)
+{
+	if ( !src ) return NULL;
+
+	as_record* rec = as_record_new(src->bins.size);
+	if ( !rec ) return rec;
+
+	as_record_copy_key(&rec->key, &src->key);
+	rec->gen = src->gen;
+	rec->ttl = src->ttl;
+
+	for (uint16_t i = 0; i < src->bins.size; i++) {
+		as_bin* bin = &src->bins.entries[i];
+		as_val* val = (as_val*)bin->valuep;
+
+		switch (val ? val->type : AS_NIL) {
+			case AS_BOOLEAN:
+				as_record_set_bool(rec, bin->name, ((as_boolean*)val)->value);
+				break;
+
+			case AS_INTEGER:
+				as_record_set_int64(rec, bin->name, ((as_integer*)val)->value);
+				break;
+
+			case AS_DOUBLE:
+				as_record_set_double(rec, bin->name, ((as_double*)val)->value);
+				break;
+
+			case AS_STRING: {
+				as_string* s = (as_string*)val;
+				char* v = as_record_copy_buf(s->value, as_string_len(s), true);
+				as_record_set_strp(rec, bin->name, v, true);
+				break;
+			}
+
+			case AS_GEOJSON: {
+				as_geojson* g = (as_geojson*)val;
+				char* v = as_record_copy_buf(g->value, as_geojson_len(g), true);
+				as_record_set_geojson_strp(rec, bin->name, v, true);
+				break;
+			}
+
+			case AS_BYTES: {
+				as_bytes* b = (as_bytes*)val;
+				uint8_t* v = as_record_copy_buf(b->value, b->size, false);
+				as_record_set_raw_typep(rec, bin->name, v, b->size, b->type, true);
+				break;
+			}
+
+			case AS_LIST:
+			case AS_MAP:
+				// Deserialized lists and maps never reference the response buffer.
+				as_val_reserve(val);
+				as_record_set(rec, bin->name, (as_bin_value*)val);
+				break;
+
+			default:
+				as_record_set_nil(rec, bin->name);
+				break;
+		}
+	}
+	return rec;
+}
+
 /******************************************************************************
  * VALUE FUNCTIONS
  *****************************************************************************/
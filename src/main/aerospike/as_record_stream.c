@@ -0,0 +1,169 @@
+/*
+ * Copyright 2008-2026 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/as_record_stream.h>
+#include <aerospike/as_tls.h>
+#include <citrusleaf/alloc.h>
+#include <string.h>
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static void*
+as_record_stream_run(void* udata)
+{
+	as_record_stream* stream = udata;
+
+	as_error err;
+	as_error_init(&err);
+
+	as_status status = stream->producer(stream, &err);
+
+	pthread_mutex_lock(&stream->lock);
+	stream->status = status;
+	as_error_copy(&stream->err, &err);
+	stream->done = true;
+	pthread_cond_broadcast(&stream->not_empty);
+	pthread_mutex_unlock(&stream->lock);
+
+	as_tls_thread_cleanup();
+	return NULL;
+}
+
+static void
+as_record_stream_destroy(as_record_stream* stream)
+{
+	for (uint32_t i = 0; i < stream->size; i++) {
+		as_record_destroy(stream->records[(stream->head + i) % stream->capacity]);
+	}
+	cf_free(stream->records);
+	pthread_cond_destroy(&stream->not_full);
+	pthread_cond_destroy(&stream->not_empty);
+	pthread_mutex_destroy(&stream->lock);
+	cf_free(stream);
+}
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+as_status
+as_record_stream_start(
+	struct aerospike_s* as, as_error* err, void* cmd, const void* policy, size_t policy_size,
+	uint32_t capacity, as_record_stream_producer producer, as_record_stream** stream_out
+	)
+{
+	as_record_stream* stream = cf_malloc(sizeof(as_record_stream));
+	stream->as = as;
+	stream->cmd = cmd;
+	memcpy(&stream->policy, policy, policy_size);
+	stream->producer = producer;
+	pthread_mutex_init(&stream->lock, NULL);
+	pthread_cond_init(&stream->not_empty, NULL);
+	pthread_cond_init(&stream->not_full, NULL);
+	stream->capacity = capacity > 0 ? capacity : 1;
+	stream->records = cf_malloc(sizeof(as_record*) * stream->capacity);
+	stream->head = 0;
+	stream->size = 0;
+	stream->status = AEROSPIKE_OK;
+	as_error_init(&stream->err);
+	stream->done = false;
+	stream->closed = false;
+
+	if (pthread_create(&stream->thread, NULL, as_record_stream_run, stream) != 0) {
+		as_record_stream_destroy(stream);
+		*stream_out = NULL;
+		return as_error_set_message(err, AEROSPIKE_ERR_CLIENT, "Failed to create stream thread");
+	}
+
+	*stream_out = stream;
+	return AEROSPIKE_OK;
+}
+
+bool
+as_record_stream_callback(const as_val* val, void* udata)
+{
+	if (! val) {
+		// End of query is signaled when the producer returns.
+		return true;
+	}
+
+	as_record_stream* stream = udata;
+
+	// Copy record outside of lock. The original record is destroyed when this callback returns.
+	as_record* rec = as_record_copy(as_record_fromval(val));
+
+	pthread_mutex_lock(&stream->lock);
+
+	// Block node thread (and its socket reads) until the application consumes records.
+	while (stream->size >= stream->capacity && ! stream->closed) {
+		pthread_cond_wait(&stream->not_full, &stream->lock);
+	}
+
+	if (stream->closed) {
+		pthread_mutex_unlock(&stream->lock);
+		as_record_destroy(rec);
+		return false;
+	}
+
+	stream->records[(stream->head + stream->size) % stream->capacity] = rec;
+	stream->size++;
+	pthread_cond_signal(&stream->not_empty);
+	pthread_mutex_unlock(&stream->lock);
+	return true;
+}
+
+as_status
+as_record_stream_next(as_record_stream* stream, as_error* err, as_record** rec)
+{
+	pthread_mutex_lock(&stream->lock);
+
+	while (stream->size == 0 && ! stream->done) {
+		pthread_cond_wait(&stream->not_empty, &stream->lock);
+	}
+
+	if (stream->size > 0) {
+		*rec = stream->records[stream->head];
+		stream->head = (stream->head + 1) % stream->capacity;
+		stream->size--;
+		pthread_cond_signal(&stream->not_full);
+		pthread_mutex_unlock(&stream->lock);
+		return AEROSPIKE_OK;
+	}
+
+	// All records have been consumed and the producer has finished.
+	pthread_mutex_unlock(&stream->lock);
+	*rec = NULL;
+
+	if (stream->status != AEROSPIKE_OK) {
+		as_error_copy(err, &stream->err);
+	}
+	return stream->status;
+}
+
+void
+as_record_stream_close(as_record_stream* stream)
+{
+	pthread_mutex_lock(&stream->lock);
+	stream->closed = true;
+	pthread_cond_broadcast(&stream->not_full);
+	pthread_mutex_unlock(&stream->lock);
+
+	// Blocked node threads return false from the callback, which aborts the query.
+	pthread_join(stream->thread, NULL);
+	as_record_stream_destroy(stream);
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2008-2025 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/as_ripemd160.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+uint32_t
+as_ripemd160_pad(uint8_t* buf, size_t len)
+{
+	uint32_t n_blocks = as_ripemd160_blocks(len);
+	size_t total = (size_t)n_blocks * AS_RIPEMD160_BLOCK_SIZE;
+
+	buf[len] = 0x80;
+	memset(buf + len + 1, 0, total - len - 9);
+
+	// Message length in bits, little endian.
+	uint64_t bits = (uint64_t)len << 3;
+	uint8_t* p = buf + total - 8;
+
+	for (uint32_t i = 0; i < 8; i++) {
+		p[i] = (uint8_t)(bits >> (i * 8));
+	}
+	return n_blocks;
+}
+
+#if defined(AS_RIPEMD160_SIMD)
+
+//---------------------------------
+// Vector Operations
+//---------------------------------
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+typedef __m128i as_vec;
+
+#define vec_set1(x) _mm_set1_epi32((int)(x))
+#define vec_add(a, b) _mm_add_epi32(a, b)
+#define vec_and(a, b) _mm_and_si128(a, b)
+#define vec_or(a, b) _mm_or_si128(a, b)
+#define vec_xor(a, b) _mm_xor_si128(a, b)
+#define vec_andnot(a, b) _mm_andnot_si128(a, b) // ~a & b
+#define vec_not(a) _mm_xor_si128(a, _mm_set1_epi32(-1))
+#define vec_rol(a, n) _mm_or_si128(_mm_sll_epi32(a, _mm_cvtsi32_si128(n)), \
+	_mm_srl_epi32(a, _mm_cvtsi32_si128(32 - (n))))
+#define vec_load(p) _mm_loadu_si128((const __m128i*)(p))
+#define vec_store(p, a) _mm_storeu_si128((__m128i*)(p), a)
+
+#else
+
+typedef uint32x4_t as_vec;
+
+#define vec_set1(x) vdupq_n_u32(x)
+#define vec_add(a, b) vaddq_u32(a, b)
+#define vec_and(a, b) vandq_u32(a, b)
+#define vec_or(a, b) vorrq_u32(a, b)
+#define vec_xor(a, b) veorq_u32(a, b)
+#define vec_andnot(a, b) vbicq_u32(b, a) // ~a & b
+#define vec_not(a) vmvnq_u32(a)
+#define vec_rol(a, n) vorrq_u32(vshlq_u32(a, vdupq_n_s32(n)), \
+	vshlq_u32(a, vdupq_n_s32((n) - 32)))
+#define vec_load(p) vld1q_u32(p)
+#define vec_store(p, a) vst1q_u32(p, a)
+
+#endif
+
+//---------------------------------
+// Constants
+//---------------------------------
+
+static const uint8_t as_rmd_r[80] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+	3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+	1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+	4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+};
+
+static const uint8_t as_rmd_rp[80] = {
+	5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+	6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+	15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+	8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+	12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+};
+
+static const uint8_t as_rmd_s[80] = {
+	11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+	7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+	11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+	11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+	9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+};
+
+static const uint8_t as_rmd_sp[80] = {
+	8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+	9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+	9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+	15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+	8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+};
+
+static const uint32_t as_rmd_k[5] = {
+	0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E
+};
+
+static const uint32_t as_rmd_kp[5] = {
+	0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000
+};
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static inline as_vec
+as_rmd_f(uint32_t round, as_vec x, as_vec y, as_vec z)
+{
+	switch (round) {
+		case 0:
+			return vec_xor(vec_xor(x, y), z);
+		case 1:
+			return vec_or(vec_and(x, y), vec_andnot(x, z));
+		case 2:
+			return vec_xor(vec_or(x, vec_not(y)), z);
+		case 3:
+			return vec_or(vec_and(x, z), vec_andnot(z, y));
+		default:
+			return vec_xor(x, vec_or(y, vec_not(z)));
+	}
+}
+
+static void
+as_rmd_compress(as_vec* h, const as_vec* x)
+{
+	as_vec a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+	as_vec ap = h[0], bp = h[1], cp = h[2], dp = h[3], ep = h[4];
+
+	for (uint32_t j = 0; j < 80; j++) {
+		uint32_t round = j >> 4;
+
+		// Left line.
+		as_vec t = vec_add(vec_add(a, as_rmd_f(round, b, c, d)),
+			vec_add(x[as_rmd_r[j]], vec_set1(as_rmd_k[round])));
+		t = vec_add(vec_rol(t, as_rmd_s[j]), e);
+		a = e;
+		e = d;
+		d = vec_rol(c, 10);
+		c = b;
+		b = t;
+
+		// Right line uses the boolean functions in reverse order.
+		t = vec_add(vec_add(ap, as_rmd_f(4 - round, bp, cp, dp)),
+			vec_add(x[as_rmd_rp[j]], vec_set1(as_rmd_kp[round])));
+		t = vec_add(vec_rol(t, as_rmd_sp[j]), ep);
+		ap = ep;
+		ep = dp;
+		dp = vec_rol(cp, 10);
+		cp = bp;
+		bp = t;
+	}
+
+	as_vec t = vec_add(vec_add(h[1], c), dp);
+	h[1] = vec_add(vec_add(h[2], d), ep);
+	h[2] = vec_add(vec_add(h[3], e), ap);
+	h[3] = vec_add(vec_add(h[4], a), bp);
+	h[4] = vec_add(vec_add(h[0], b), cp);
+	h[0] = t;
+}
+
+static inline uint32_t
+as_rmd_get32(const uint8_t* p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+		((uint32_t)p[3] << 24);
+}
+
+//---------------------------------
+// Functions
+//---------------------------------
+
+void
+as_ripemd160_lanes(
+	const uint8_t* blocks[AS_RIPEMD160_LANES], uint32_t n_blocks,
+	uint8_t* digests[AS_RIPEMD160_LANES]
+	)
+{
+	as_vec h[5] = {
+		vec_set1(0x67452301), vec_set1(0xEFCDAB89), vec_set1(0x98BADCFE),
+		vec_set1(0x10325476), vec_set1(0xC3D2E1F0)
+	};
+	as_vec x[16];
+	uint32_t words[AS_RIPEMD160_LANES];
+
+	for (uint32_t b = 0; b < n_blocks; b++) {
+		uint32_t offset = b * AS_RIPEMD160_BLOCK_SIZE;
+
+		// Transpose message words so each vector holds the same word from every lane.
+		for (uint32_t i = 0; i < 16; i++) {
+			for (uint32_t lane = 0; lane < AS_RIPEMD160_LANES; lane++) {
+				words[lane] = as_rmd_get32(blocks[lane] + offset + i * 4);
+			}
+			x[i] = vec_load(words);
+		}
+		as_rmd_compress(h, x);
+	}
+
+	for (uint32_t i = 0; i < 5; i++) {
+		vec_store(words, h[i]);
+
+		for (uint32_t lane = 0; lane < AS_RIPEMD160_LANES; lane++) {
+			uint8_t* p = digests[lane] + i * 4;
+			uint32_t v = words[lane];
+			p[0] = (uint8_t)v;
+			p[1] = (uint8_t)(v >> 8);
+			p[2] = (uint8_t)(v >> 16);
+			p[3] = (uint8_t)(v >> 24);
+		}
+	}
+}
+
+#endif
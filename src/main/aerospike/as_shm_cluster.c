@@ -446,6 +446,69 @@ as_shm_find_partition_table(as_cluster_shm* cluster_shm, const char* ns)
 	return 0;
 }
 
+static void
+as_shm_index_partition_table(as_shm_info* shm_info, const char* ns, uint32_t offset)
+{
+	// Can be called from any thread, so slots are claimed with compare and swap.
+	// The index never fills because it has at least twice the shared memory table capacity.
+	uint32_t* index = shm_info->ns_index;
+	uint32_t mask = shm_info->ns_index_mask;
+	uint32_t slot = as_partition_ns_hash(ns) & mask;
+	uint32_t val = offset + 1;
+
+	while (true) {
+		uint32_t cur = as_load_uint32_acq(&index[slot]);
+
+		if (cur == 0) {
+			if (as_cas_uint32(&index[slot], 0, val)) {
+				return;
+			}
+			// Another thread claimed slot. Check slot again.
+			continue;
+		}
+
+		if (cur == val) {
+			// Another thread already indexed this table.
+			return;
+		}
+		slot = (slot + 1) & mask;
+	}
+}
+
+as_partition_table_shm*
+as_shm_lookup_partition_table(as_shm_info* shm_info, const char* ns)
+{
+	as_cluster_shm* cluster_shm = shm_info->cluster_shm;
+	as_partition_table_shm* tables = as_shm_get_partition_tables(cluster_shm);
+	uint32_t* index = shm_info->ns_index;
+	uint32_t mask = shm_info->ns_index_mask;
+	uint32_t slot = as_partition_ns_hash(ns) & mask;
+	uint32_t offset;
+
+	while ((offset = as_load_uint32_acq(&index[slot])) != 0) {
+		as_partition_table_shm* table = as_shm_get_partition_table(cluster_shm, tables, offset - 1);
+
+		if (strcmp(table->ns, ns) == 0) {
+			return table;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	// Namespace is not indexed. The table may have been added by the tend thread or
+	// by another process, so scan shared memory.
+	as_partition_table_shm* table = tables;
+	uint32_t max = as_load_uint32(&cluster_shm->partition_tables_size);
+
+	for (uint32_t i = 0; i < max; i++) {
+		if (strcmp(table->ns, ns) == 0) {
+			as_shm_index_partition_table(shm_info, ns, i);
+			return table;
+		}
+		table = as_shm_next_partition_table(cluster_shm, table);
+	}
+	return NULL;
+}
+
 static as_partition_table_shm*
 as_shm_add_partition_table(
 	as_cluster_shm* cluster_shm, const char* ns, uint8_t replica_size, bool sc_mode
@@ -479,65 +542,66 @@ as_shm_force_replicas_refresh(as_shm_info* shm_info, uint32_t node_index)
 	
 	if (node) {
 		node->partition_generation = (uint32_t)-1;
+		node->partition_bitmaps_stale = true;
 	}
 }
 
-static void
+static uint32_t
 as_shm_decode_and_update(
 	as_shm_info* shm_info, char* bitmap_b64, int64_t len, as_partition_table_shm* table,
-	uint32_t node_index, uint8_t replica_index, uint32_t regime
+	as_node* node, uint8_t replica_index, uint32_t regime, bool full
 	)
 {
-	// Size allows for padding - is actual size rounded up to multiple of 3.
-	uint8_t* bitmap = (uint8_t*)alloca(cf_b64_decoded_buf_size((uint32_t)len));
-	
-	// For now - for speed - trust validity of encoded characters.
-	cf_b64_decode(bitmap_b64, (uint32_t)len, bitmap, NULL);
-	
-	// Expand the bitmap.
 	uint32_t max = shm_info->cluster_shm->n_partitions;
+	uint32_t* ids = (uint32_t*)alloca(sizeof(uint32_t) * max);
+	uint32_t n_ids = as_partition_bitmap_decode(node, table->ns, bitmap_b64, (uint32_t)len, max,
+		replica_index, regime, full, ids);
 
-	for (uint32_t i = 0; i < max; i++) {
-		if ((bitmap[i >> 3] & (0x80 >> (i & 7))) != 0) {
-			// This node claims ownership of partition.
-			as_partition_shm* p = &table->partitions[i];
+	// node index starts at one (zero indicates unset).
+	uint32_t node_index = node->index + 1;
+	uint32_t changed = 0;
 
-			if (regime >= as_load_uint32(&p->regime)) {
-				if (regime > p->regime) {
-					as_store_uint32(&p->regime, regime);
-				}
+	for (uint32_t i = 0; i < n_ids; i++) {
+		// This node claims ownership of partition.
+		as_partition_shm* p = &table->partitions[ids[i]];
+
+		if (regime >= as_load_uint32(&p->regime)) {
+			if (regime > p->regime) {
+				as_store_uint32(&p->regime, regime);
+			}
 
-				uint32_t node_index_old = p->nodes[replica_index];
+			uint32_t node_index_old = p->nodes[replica_index];
 
-				if (node_index != node_index_old) {
-					// node index starts at one (zero indicates unset).
-					if (node_index_old) {
-						as_shm_force_replicas_refresh(shm_info, node_index_old);
-					}
-					as_store_uint32_rls(&p->nodes[replica_index], node_index);
+			if (node_index != node_index_old) {
+				if (node_index_old) {
+					as_shm_force_replicas_refresh(shm_info, node_index_old);
 				}
+				as_store_uint32_rls(&p->nodes[replica_index], node_index);
+				changed++;
 			}
 		}
 	}
+	return changed;
 }
 
-void
+uint32_t
 as_shm_update_partitions(
 	as_shm_info* shm_info, const char* ns, char* bitmap_b64, int64_t len, as_node* node,
-	uint8_t replica_size, uint8_t replica_index, uint32_t regime
+	uint8_t replica_size, uint8_t replica_index, uint32_t regime, bool full
 	)
 {
 	as_cluster_shm* cluster_shm = shm_info->cluster_shm;
-	as_partition_table_shm* table = as_shm_find_partition_table(cluster_shm, ns);
-	
+	as_partition_table_shm* table = as_shm_lookup_partition_table(shm_info, ns);
+
 	if (! table) {
 		table = as_shm_add_partition_table(cluster_shm, ns, replica_size, regime != 0);
 	}
-	
-	if (table) {
-		as_shm_decode_and_update(shm_info, bitmap_b64, len, table, node->index + 1, replica_index,
-			regime);
+
+	if (! table) {
+		return 0;
 	}
+	return as_shm_decode_and_update(shm_info, bitmap_b64, len, table, node, replica_index,
+		regime, full);
 }
 
 static as_node*
@@ -667,6 +731,71 @@ as_shm_get_replica_rack(
 	return NULL;
 }
 
+static as_node*
+as_shm_get_replica_fastest(
+	as_node** local_nodes, as_partition_shm* p, as_node* prev_node, uint8_t replica_size,
+	uint8_t* replica_index
+	)
+{
+	// Power of two choices. See get_replica_fastest() in as_partition.c.
+	as_node* best = NULL;
+	as_node* fallback = NULL;
+	uint64_t best_score = 0;
+	uint8_t best_index = 0;
+	uint8_t fallback_index = 0;
+	uint32_t candidates = 0;
+
+	for (uint8_t i = 0; i < replica_size; i++) {
+		uint8_t index = (uint8_t)((*replica_index + i) % replica_size);
+		uint32_t node_index = as_load_uint32_acq(&p->nodes[index]);
+
+		// node_index starts at one (zero indicates unset).
+		if (! node_index) {
+			continue;
+		}
+
+		as_node* node = as_node_load(&local_nodes[node_index-1]);
+
+		if (! (node && as_node_is_active(node))) {
+			continue;
+		}
+
+		// Never examine the contents of prev_node. It may have already been destroyed.
+		if (node == prev_node) {
+			if (! fallback) {
+				fallback = node;
+				fallback_index = index;
+			}
+			continue;
+		}
+
+		// Latency and in-flight counts are kept on the local node, so each process
+		// attached to shared memory chooses based on its own observations.
+		uint64_t score = as_node_replica_score(node);
+
+		if (! best || score < best_score) {
+			best = node;
+			best_score = score;
+			best_index = index;
+		}
+
+		if (++candidates == 2) {
+			break;
+		}
+	}
+
+	if (best) {
+		*replica_index = best_index;
+		return best;
+	}
+
+	if (fallback) {
+		*replica_index = fallback_index;
+		return fallback;
+	}
+	return NULL;
+}
+
 as_node*
 as_partition_shm_get_node(
 	as_cluster* cluster, const char* ns, as_partition_shm* p, as_node* prev_node,
@@ -683,6 +812,10 @@ as_partition_shm_get_node(
 			return as_shm_get_replica_rack(cluster, local_nodes, ns, p, prev_node, replica_size,
 				replica_index);
 
+		case AS_POLICY_REPLICA_FASTEST:
+			return as_shm_get_replica_fastest(local_nodes, p, prev_node, replica_size,
+				replica_index);
+
 		// The remaining replica algorithms use replica_index as the starting point
 		// and iterate till a valid node is found.
 		default:
@@ -725,6 +858,14 @@ as_shm_takeover_cluster(
 	as_store_uint32(&cluster_shm->owner_pid, pid);
 	shm_info->is_tend_master = true;
 
+	// Partition maps were updated by the previous tend master, so cached node partition
+	// bitmaps no longer describe the shared memory partition maps.
+	as_nodes* nodes = cluster->nodes;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		nodes->array[i]->partition_bitmaps_stale = true;
+	}
+
 	if (cluster->rack_aware) {
 		as_shm_reset_rebalance_gen(shm_info, cluster_shm);
 	}
@@ -997,6 +1138,14 @@ as_shm_create(as_cluster* cluster, as_error* err, as_config* config)
 	// Initialize local data.
 	as_shm_info* shm_info = cf_malloc(sizeof(as_shm_info));
 	shm_info->local_nodes = cf_calloc(config->shm_max_nodes, sizeof(as_node*));
+
+	uint32_t ns_index_size = 8;
+
+	while (ns_index_size < config->shm_max_namespaces * 2) {
+		ns_index_size <<= 1;
+	}
+	shm_info->ns_index = cf_calloc(ns_index_size, sizeof(uint32_t));
+	shm_info->ns_index_mask = ns_index_size - 1;
 	shm_info->cluster_shm = cluster_shm;
 	shm_info->shm_id = id;
 	shm_info->takeover_threshold_ms = config->shm_takeover_threshold_sec * 1000;
@@ -1122,6 +1271,7 @@ as_shm_destroy(as_cluster* cluster)
 
 	// Release memory.
 	cf_free(shm_info->local_nodes);
+	cf_free(shm_info->ns_index);
 	cf_free(shm_info);
 	cluster->shm_info = 0;
 }
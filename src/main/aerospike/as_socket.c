@@ -65,6 +65,8 @@ as_socket_is_error(int e)
 #define IPV6_ADDR_PREFERENCES 72
 
 bool as_socket_stop_on_interrupt = false;
+uint32_t as_socket_spin_us = 0;
+uint32_t as_socket_busy_poll_us = 0;
 
 //---------------------------------
 // Functions
@@ -130,6 +132,18 @@ as_socket_create_fd(int family, as_socket_fd* fdp)
 	}
 #endif
 
+#if defined(__linux__)
+	if (as_socket_busy_poll_us > 0) {
+		// Busy poll the device queue on blocking reads. Values above net.core.busy_read
+		// require CAP_NET_ADMIN, so failure is not fatal.
+		int bp = (int)as_socket_busy_poll_us;
+
+		if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &bp, sizeof(bp)) < 0) {
+			as_log_debug("SO_BUSY_POLL failed: %d", errno);
+		}
+	}
+#endif
+
 	// May want to specify preference for permanent public addresses sometime in the future.
 	// int p = IPV6_PREFER_SRC_PUBLIC;
 	// setsockopt(fd, IPPROTO_IPV6, IPV6_ADDR_PREFERENCES, &p, sizeof(p));
@@ -190,6 +204,8 @@ as_socket_start_connect(as_socket* sock, struct sockaddr* addr, uint64_t deadlin
 	}
 
 	if (sock->tls) {
+		as_tls_session_resume(sock->tls, sock->ssl, addr, sock->tls_name);
+
 		if (as_tls_connect(sock, deadline_ms)) {
 			return false;
 		}
@@ -225,7 +241,7 @@ as_socket_create_and_connect(
 void
 as_socket_close(as_socket* sock)
 {
-	if (sock->tls) {
+	if (sock->ssl) {
 		SSL_shutdown(sock->ssl);
 		shutdown(sock->fd, SHUT_RDWR);
 		SSL_free(sock->ssl);
@@ -306,6 +322,105 @@ as_socket_validate_fd(as_socket_fd fd)
 #endif
 }
 
+static inline int
+as_socket_read_once(as_socket_fd fd, uint8_t* buf, size_t len)
+{
+#if !defined(_MSC_VER)
+	return (int)read(fd, buf, len);
+#else
+	return (int)recv(fd, buf, (int)len, 0);
+#endif
+}
+
+static inline int
+as_socket_write_once(as_socket_fd fd, uint8_t* buf, size_t len)
+{
+#if defined(__linux__)
+	return (int)send(fd, buf, len, MSG_NOSIGNAL);
+#elif defined(_MSC_VER)
+	return send(fd, buf, (int)len, 0);
+#else
+	return (int)write(fd, buf, len);
+#endif
+}
+
+#if !defined(_MSC_VER)
+static inline int
+as_socket_writev_once(as_socket_fd fd, as_iovec* iov, uint32_t iov_size)
+{
+#if defined(__linux__)
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = iov_size;
+	return (int)sendmsg(fd, &msg, MSG_NOSIGNAL);
+#else
+	return (int)writev(fd, iov, (int)iov_size);
+#endif
+}
+#endif
+
+static inline int
+as_socket_io_once(
+	as_socket_fd fd, uint8_t* buf, size_t len, as_iovec* iov, uint32_t iov_size, bool read
+	)
+{
+#if !defined(_MSC_VER)
+	if (iov) {
+		return as_socket_writev_once(fd, iov, iov_size);
+	}
+#endif
+	return read ? as_socket_read_once(fd, buf, len) : as_socket_write_once(fd, buf, len);
+}
+
+static int
+as_socket_spin(
+	as_socket_fd fd, uint8_t* buf, size_t len, as_iovec* iov, uint32_t iov_size, bool read,
+	uint32_t* timeout, int* bytes
+	)
+{
+	// Retry the non-blocking call until it makes progress, the spin period expires or the
+	// timeout expires. Return 1 if the call made progress or failed with *bytes set, 0 if the
+	// timeout expired and -1 if the socket is still not ready, so the caller falls back to poll
+	// with the remaining timeout.
+	uint64_t begin = 0;
+	uint64_t spin_limit = 0;
+	uint64_t timeout_limit = 0;
+
+	while (true) {
+		int rv = as_socket_io_once(fd, buf, len, iov, iov_size, read);
+
+		if (rv >= 0 || as_socket_is_error(as_last_error())) {
+			*bytes = rv;
+			return 1;
+		}
+
+		uint64_t now = cf_getus();
+
+		if (begin == 0) {
+			begin = now;
+			spin_limit = now + as_socket_spin_us;
+
+			if (*timeout > 0) {
+				timeout_limit = now + (uint64_t)*timeout * 1000;
+			}
+			continue;
+		}
+
+		if (timeout_limit > 0 && now >= timeout_limit) {
+			return 0;
+		}
+
+		if (now >= spin_limit) {
+			if (*timeout > 0) {
+				// Remaining timeout is at least 1ms because timeout_limit was not reached.
+				*timeout -= (uint32_t)((now - begin) / 1000);
+			}
+			return -1;
+		}
+	}
+}
+
 as_status
 as_socket_write_deadline(
 	as_error* err, as_socket* sock, struct as_node_s* node, uint8_t* buf, size_t buf_len,
@@ -359,17 +474,20 @@ as_socket_write_deadline(
 			timeout = socket_timeout;
 		}
 
-		int rv = as_poll_socket(&poll, sock->fd, timeout, false);
+		int w_bytes = 0;
+		int rv = (as_socket_spin_us > 0)?
+			as_socket_spin(sock->fd, buf + pos, buf_len - pos, NULL, 0, false, &timeout, &w_bytes) : -1;
+		bool spun = rv > 0;
+
+		if (rv < 0) {
+			rv = as_poll_socket(&poll, sock->fd, timeout, false);
+		}
 
 		if (rv > 0) {
-#if defined(__linux__) 
-			int w_bytes = (int)send(sock->fd, buf + pos, buf_len - pos, MSG_NOSIGNAL);
-#elif defined(_MSC_VER)
-			int w_bytes = send(sock->fd, buf + pos, (int)(buf_len - pos), 0);
-#else
-			int w_bytes = (int)write(sock->fd, buf + pos, buf_len - pos);
-#endif
-		
+			if (! spun) {
+				w_bytes = as_socket_write_once(sock->fd, buf + pos, buf_len - pos);
+			}
+
 			if (w_bytes > 0) {
 				pos += w_bytes;
 			}
@@ -409,6 +527,133 @@ as_socket_write_deadline(
 	return status;
 }
 
+#if !defined(_MSC_VER)
+static as_status
+as_socket_writev_plain(
+	as_error* err, as_socket* sock, struct as_node_s* node, as_iovec* iov, uint32_t iov_size,
+	uint32_t socket_timeout, uint64_t deadline
+	)
+{
+	// Partial writes modify the segments, so work on a copy that can be discarded.
+	as_iovec copy[AS_SOCKET_IOV_MAX];
+	as_iovec* vec = copy;
+	memcpy(vec, iov, sizeof(as_iovec) * iov_size);
+
+	as_poll poll;
+	as_poll_init(&poll, sock->fd);
+
+	as_status status = AEROSPIKE_OK;
+	uint32_t timeout;
+
+	do {
+		if (deadline > 0) {
+			uint64_t now = cf_getms();
+
+			if (now >= deadline) {
+				// Timeout.  Do not set error string to avoid affecting performance.
+				// Calling functions usually retry, so the error string is not used anyway.
+				status = err->code = AEROSPIKE_ERR_TIMEOUT;
+				err->message[0] = 0;
+				break;
+			}
+
+			timeout = (uint32_t)(deadline - now);
+
+			if (socket_timeout > 0 && socket_timeout < timeout) {
+				timeout = socket_timeout;
+			}
+		}
+		else {
+			timeout = socket_timeout;
+		}
+
+		int w_bytes = 0;
+		int rv = (as_socket_spin_us > 0)?
+			as_socket_spin(sock->fd, NULL, 0, vec, iov_size, false, &timeout, &w_bytes) : -1;
+		bool spun = rv > 0;
+
+		if (rv < 0) {
+			rv = as_poll_socket(&poll, sock->fd, timeout, false);
+		}
+
+		if (rv > 0) {
+			if (! spun) {
+				w_bytes = as_socket_writev_once(sock->fd, vec, iov_size);
+			}
+
+			if (w_bytes > 0) {
+				// Skip fully written segments and advance into the partial one.
+				size_t w = (size_t)w_bytes;
+
+				while (iov_size > 0 && w >= vec->iov_len) {
+					w -= vec->iov_len;
+					vec++;
+					iov_size--;
+				}
+
+				if (iov_size > 0) {
+					vec->iov_base = (uint8_t*)vec->iov_base + w;
+					vec->iov_len -= w;
+				}
+			}
+			else if (w_bytes == 0) {
+				// We shouldn't see 0 returned unless we try to write 0 bytes, which we don't.
+				status = as_error_set_message(err, AEROSPIKE_ERR_CONNECTION, "Bad file descriptor");
+				break;
+			}
+			else {
+				int e = as_last_error();
+				if (as_socket_is_error(e)) {
+					status = as_socket_error(sock->fd, node, err, AEROSPIKE_ERR_CONNECTION, "Socket write error", e);
+					break;
+				}
+			}
+		}
+		else if (rv == 0) {
+			// Timeout.  Do not set error string to avoid affecting performance.
+			// Calling functions usually retry, so the error string is not used anyway.
+			status = err->code = AEROSPIKE_ERR_TIMEOUT;
+			err->message[0] = 0;
+			break;
+		}
+		else if (rv == -1) {
+			int e = as_last_error();
+			if (e != AS_EINTR || as_socket_stop_on_interrupt) {
+				status = as_socket_error(sock->fd, node, err, AEROSPIKE_ERR_CONNECTION, "Socket write error", e);
+				break;
+			}
+		}
+	} while (iov_size > 0);
+
+	as_poll_destroy(&poll);
+	return status;
+}
+#endif
+
+as_status
+as_socket_writev_deadline(
+	as_error* err, as_socket* sock, struct as_node_s* node, as_iovec* iov, uint32_t iov_size,
+	uint32_t socket_timeout, uint64_t deadline
+	)
+{
+#if !defined(_MSC_VER)
+	if (! sock->tls) {
+		return as_socket_writev_plain(err, sock, node, iov, iov_size, socket_timeout, deadline);
+	}
+#endif
+
+	// OpenSSL encrypts from contiguous buffers, so write each segment in order.
+	for (uint32_t i = 0; i < iov_size; i++) {
+		as_status status = as_socket_write_deadline(err, sock, node, (uint8_t*)iov[i].iov_base,
+			iov[i].iov_len, socket_timeout, deadline);
+
+		if (status != AEROSPIKE_OK) {
+			return status;
+		}
+	}
+	return AEROSPIKE_OK;
+}
+
 static inline bool
 as_socket_recoverable(as_socket_context* ctx, as_node* node)
 {
@@ -496,14 +741,19 @@ as_socket_read_deadline(
 			timeout = socket_timeout;
 		}
 
-		int rv = as_poll_socket(&poll, sock->fd, timeout, true);
+		int r_bytes = 0;
+		int rv = (as_socket_spin_us > 0)?
+			as_socket_spin(sock->fd, buf + pos, buf_len - pos, NULL, 0, true, &timeout, &r_bytes) : -1;
+		bool spun = rv > 0;
+
+		if (rv < 0) {
+			rv = as_poll_socket(&poll, sock->fd, timeout, true);
+		}
 
 		if (rv > 0) {
-#if !defined(_MSC_VER)
-			int r_bytes = (int)read(sock->fd, buf + pos, buf_len - pos);
-#else
-			int r_bytes = (int)recv(sock->fd, buf + pos, (int)(buf_len - pos), 0);
-#endif
+			if (! spun) {
+				r_bytes = as_socket_read_once(sock->fd, buf + pos, buf_len - pos);
+			}
 
 			if (r_bytes > 0) {
 				pos += r_bytes;
@@ -31,6 +31,10 @@
 #include <pthread.h>
 #include <signal.h>
 
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define AS_TLS_KTLS
+#endif
+
 static void* cert_blacklist_read(const char * path);
 static bool cert_blacklist_check(void* cert_blacklist,
 								 const char* snhex,
@@ -39,6 +43,14 @@ static void cert_blacklist_destroy(void* cert_blacklist);
 
 static void manage_sigpipe(void);
 
+#define AS_TLS_SESSION_MAX 256
+
+typedef struct as_tls_session_s {
+	struct sockaddr_storage addr;
+	char* tls_name;
+	SSL_SESSION* session;
+} as_tls_session;
+
 static bool s_tls_inited = false;
 static pthread_mutex_t s_tls_init_mutex = PTHREAD_MUTEX_INITIALIZER;
 static int s_ex_name_index = -1;
@@ -607,8 +619,15 @@ as_tls_context_setup(as_config_tls* tlscfg, as_tls_context* ctx, as_error* errp)
 	ctx->ssl_ctx = NULL;
 	ctx->pkey = NULL;
 	ctx->cert_blacklist = NULL;
+	ctx->sessions = tlscfg->session_cache ?
+		cf_malloc(sizeof(as_tls_session) * AS_TLS_SESSION_MAX) : NULL;
+	ctx->sessions_size = 0;
+	ctx->sessions_evict = 0;
+	ctx->session_hit_count = 0;
+	ctx->session_miss_count = 0;
 	ctx->log_session_info = tlscfg->log_session_info;
 	ctx->for_login_only = tlscfg->for_login_only;
+	ctx->ktls = false;
 
 	as_tls_check_init();
 	pthread_mutex_init(&ctx->lock, NULL);
@@ -799,14 +818,39 @@ as_tls_context_setup(as_config_tls* tlscfg, as_tls_context* ctx, as_error* errp)
 		X509_VERIFY_PARAM_free(param);
 	}
 
+	if (tlscfg->ktls) {
+#if defined(AS_TLS_KTLS)
+		SSL_CTX_set_options(ctx->ssl_ctx, SSL_OP_ENABLE_KTLS);
+		ctx->ktls = true;
+#else
+		as_log_warn("kTLS is not supported by this OpenSSL build. Using user space TLS.");
+#endif
+	}
+
 	SSL_CTX_set_verify(ctx->ssl_ctx, SSL_VERIFY_PEER, verify_callback);
 	manage_sigpipe();
 	return AEROSPIKE_OK;
 }
 
+static void
+sessions_clear(as_tls_context* ctx)
+{
+	for (uint32_t i = 0; i < ctx->sessions_size; i++) {
+		SSL_SESSION_free(ctx->sessions[i].session);
+		cf_free(ctx->sessions[i].tls_name);
+	}
+	ctx->sessions_size = 0;
+	ctx->sessions_evict = 0;
+}
+
 void
 as_tls_context_destroy(as_tls_context* ctx)
 {
+	if (ctx->sessions) {
+		sessions_clear(ctx);
+		cf_free(ctx->sessions);
+	}
+
 	if (ctx->cert_blacklist) {
 		cert_blacklist_destroy(ctx->cert_blacklist);
 	}
@@ -878,6 +922,11 @@ as_tls_config_reload(as_config_tls* tlscfg, as_tls_context* ctx,
 		ctx->cert_blacklist = new_cbl;
 	}
 
+	// Cached sessions were established with the old credentials.
+	if (ctx->sessions) {
+		sessions_clear(ctx);
+	}
+
 	pthread_mutex_unlock(&ctx->lock);
 	return AEROSPIKE_OK;
 }
@@ -922,6 +971,134 @@ as_tls_set_context_name(struct ssl_st* ssl, as_tls_context* ctx, const char* tls
 	SSL_set_ex_data(ssl, s_ex_ctxt_index, ctx);
 }
 
+static bool
+session_addr_equal(struct sockaddr_storage* a, struct sockaddr* b)
+{
+	if (a->ss_family != b->sa_family) {
+		return false;
+	}
+
+	if (b->sa_family == AF_INET) {
+		struct sockaddr_in* a4 = (struct sockaddr_in*)a;
+		struct sockaddr_in* b4 = (struct sockaddr_in*)b;
+		return a4->sin_port == b4->sin_port && a4->sin_addr.s_addr == b4->sin_addr.s_addr;
+	}
+
+	struct sockaddr_in6* a6 = (struct sockaddr_in6*)a;
+	struct sockaddr_in6* b6 = (struct sockaddr_in6*)b;
+	return a6->sin6_port == b6->sin6_port &&
+		memcmp(&a6->sin6_addr, &b6->sin6_addr, sizeof(struct in6_addr)) == 0;
+}
+
+static inline bool
+session_name_equal(const char* a, const char* b)
+{
+	if (! a || ! b) {
+		return a == b;
+	}
+	return strcmp(a, b) == 0;
+}
+
+static as_tls_session*
+session_find(as_tls_context* ctx, struct sockaddr* addr, const char* tls_name)
+{
+	// The server certificate was verified against tls_name, so a session must only be
+	// resumed by connections that expect the same name.
+	for (uint32_t i = 0; i < ctx->sessions_size; i++) {
+		as_tls_session* entry = &ctx->sessions[i];
+
+		if (session_addr_equal(&entry->addr, addr) &&
+			session_name_equal(entry->tls_name, tls_name)) {
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+void
+as_tls_session_resume(
+	as_tls_context* ctx, struct ssl_st* ssl, struct sockaddr* addr, const char* tls_name
+	)
+{
+	if (! ctx->sessions) {
+		return;
+	}
+
+	pthread_mutex_lock(&ctx->lock);
+
+	as_tls_session* entry = session_find(ctx, addr, tls_name);
+
+	if (entry) {
+		// SSL_set_session() takes its own reference.
+		SSL_set_session(ssl, entry->session);
+	}
+	pthread_mutex_unlock(&ctx->lock);
+}
+
+void
+as_tls_session_save(
+	as_tls_context* ctx, struct ssl_st* ssl, struct sockaddr* addr, const char* tls_name
+	)
+{
+	if (! ctx->sessions) {
+		return;
+	}
+
+	if (SSL_session_reused(ssl)) {
+		as_incr_uint64(&ctx->session_hit_count);
+		return;
+	}
+
+	as_incr_uint64(&ctx->session_miss_count);
+
+	SSL_SESSION* session = SSL_get1_session(ssl);
+
+	if (! session) {
+		return;
+	}
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+	if (! SSL_SESSION_is_resumable(session)) {
+		SSL_SESSION_free(session);
+		return;
+	}
+#endif
+
+	pthread_mutex_lock(&ctx->lock);
+
+	as_tls_session* entry = session_find(ctx, addr, tls_name);
+
+	if (entry) {
+		SSL_SESSION_free(entry->session);
+	}
+	else {
+		if (ctx->sessions_size < AS_TLS_SESSION_MAX) {
+			entry = &ctx->sessions[ctx->sessions_size++];
+		}
+		else {
+			// Cache is full. Replace entries in round-robin order.
+			entry = &ctx->sessions[ctx->sessions_evict++ % AS_TLS_SESSION_MAX];
+			SSL_SESSION_free(entry->session);
+			cf_free(entry->tls_name);
+		}
+		as_address_copy_storage(addr, &entry->addr);
+		entry->tls_name = tls_name ? cf_strdup(tls_name) : NULL;
+	}
+	entry->session = session;
+	pthread_mutex_unlock(&ctx->lock);
+}
+
+static void
+session_save_socket(as_socket* sock)
+{
+	struct sockaddr_storage addr;
+	socklen_t size = sizeof(addr);
+
+	if (getpeername(sock->fd, (struct sockaddr*)&addr, &size) == 0) {
+		as_tls_session_save(sock->tls, sock->ssl, (struct sockaddr*)&addr, sock->tls_name);
+	}
+}
+
 static void
 log_session_info(as_socket* sock)
 {
@@ -943,6 +1120,35 @@ log_session_info(as_socket* sock)
 	}
 }
 
+static void
+ktls_offload(as_socket* sock)
+{
+#if defined(AS_TLS_KTLS)
+	if (! sock->tls->ktls) {
+		return;
+	}
+
+	// The socket can only be used as a plain fd when the kernel owns both directions
+	// and OpenSSL has not buffered any bytes beyond the handshake.
+	if (! (BIO_get_ktls_send(SSL_get_wbio(sock->ssl)) &&
+		   BIO_get_ktls_recv(SSL_get_rbio(sock->ssl)) &&
+		   ! SSL_has_pending(sock->ssl))) {
+		if (sock->tls->log_session_info) {
+			as_log_info("TLS kernel offload not available");
+		}
+		return;
+	}
+
+	if (sock->tls->log_session_info) {
+		as_log_info("TLS kernel offload enabled");
+	}
+
+	// Keep sock->ssl for shutdown and free. Clearing the context routes all reads and
+	// writes through the plain socket paths.
+	sock->tls = NULL;
+#endif
+}
+
 static void
 log_verify_details(as_socket* sock)
 {
@@ -955,9 +1161,22 @@ log_verify_details(as_socket* sock)
 int
 as_tls_connect_once(as_socket* sock)
 {
+	if (sock->tls->sessions && SSL_in_before(sock->ssl)) {
+		// Socket connect has completed, so the peer address is available.
+		struct sockaddr_storage addr;
+		socklen_t size = sizeof(addr);
+
+		if (getpeername(sock->fd, (struct sockaddr*)&addr, &size) == 0) {
+			as_tls_session_resume(sock->tls, sock->ssl, (struct sockaddr*)&addr,
+				sock->tls_name);
+		}
+	}
+
 	int rv = SSL_connect(sock->ssl);
 	if (rv == 1) {
 		log_session_info(sock);
+		session_save_socket(sock);
+		ktls_offload(sock);
 		return 1;
 	}
 
@@ -1017,6 +1236,8 @@ as_tls_connect(as_socket* sock, uint64_t deadline)
 		rv = SSL_connect(sock->ssl);
 		if (rv == 1) {
 			log_session_info(sock);
+			session_save_socket(sock);
+			ktls_offload(sock);
 			return 0;
 		}
 
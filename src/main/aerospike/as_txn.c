@@ -18,20 +18,21 @@
 #include <citrusleaf/alloc.h>
 #include <citrusleaf/cf_random.h>
 
-//---------------------------------
-// Types
-//---------------------------------
-
-typedef void (*khash_reduce_fn)(const uint8_t* keyd, const char* set, uint64_t version, void* udata);
-
 //---------------------------------
 // Static Functions
 //---------------------------------
 
-static inline as_txn_hash_row*
-get_row(const as_txn_hash* h, const uint8_t* keyd)
+static inline as_txn_hash_segment*
+get_segment(as_txn_hash* h, const uint8_t* keyd)
+{
+	// Slot index uses the first four digest bytes, so select segment with the next byte.
+	return &h->segments[keyd[4] % AS_TXN_HASH_SEGMENTS];
+}
+
+static inline uint32_t
+get_slot(const as_txn_hash_segment* seg, const uint8_t* keyd)
 {
-	return &h->table[*(uint32_t*)keyd % h->n_rows];
+	return *(uint32_t*)keyd & (seg->n_slots - 1);
 }
 
 static inline void
@@ -40,197 +41,204 @@ fill_ele(as_txn_key* e, const uint8_t* keyd, const char* set, uint64_t version)
 	memcpy(e->digest, keyd, sizeof(e->digest));
 	as_strncpy(e->set, set, sizeof(e->set));
 	e->version = version;
-	e->next = NULL;
+	e->used = true;
+}
+
+static as_txn_key*
+as_txn_segment_find(as_txn_hash_segment* seg, const uint8_t* keyd)
+{
+	uint32_t mask = seg->n_slots - 1;
+	uint32_t i = get_slot(seg, keyd);
+
+	while (seg->table[i].used) {
+		as_txn_key* e = &seg->table[i];
+
+		if (memcmp(keyd, e->digest, AS_DIGEST_VALUE_SIZE) == 0) {
+			return e;
+		}
+		i = (i + 1) & mask;
+	}
+	return NULL;
+}
+
+static void
+as_txn_segment_grow(as_txn_hash_segment* seg)
+{
+	as_txn_key* old_table = seg->table;
+	uint32_t old_slots = seg->n_slots;
+
+	seg->n_slots = old_slots * 2;
+	seg->table = (as_txn_key*)cf_malloc(seg->n_slots * sizeof(as_txn_key));
+
+	for (uint32_t i = 0; i < seg->n_slots; i++) {
+		seg->table[i].used = false;
+	}
+
+	uint32_t mask = seg->n_slots - 1;
+
+	for (uint32_t i = 0; i < old_slots; i++) {
+		as_txn_key* e = &old_table[i];
+
+		if (e->used) {
+			uint32_t j = get_slot(seg, e->digest);
+
+			while (seg->table[j].used) {
+				j = (j + 1) & mask;
+			}
+			seg->table[j] = *e;
+		}
+	}
+	cf_free(old_table);
 }
 
 static void
 as_txn_hash_init(as_txn_hash* h, uint32_t n_rows)
 {
-	pthread_mutex_init(&h->lock, NULL);
+	// Size segments for n_rows total slots. Slot counts must be a power of 2.
+	uint32_t n_slots = 8;
+
+	while (n_slots * AS_TXN_HASH_SEGMENTS < n_rows) {
+		n_slots *= 2;
+	}
+
 	h->n_eles = 0;
-	h->n_rows = n_rows;
-	h->table = (as_txn_hash_row*)cf_malloc(n_rows * sizeof(as_txn_hash_row));
 
-	for (uint32_t i = 0; i < h->n_rows; i++) {
-		h->table[i].used = false;
+	for (uint32_t i = 0; i < AS_TXN_HASH_SEGMENTS; i++) {
+		as_txn_hash_segment* seg = &h->segments[i];
+
+		pthread_mutex_init(&seg->lock, NULL);
+		seg->n_eles = 0;
+		seg->n_slots = n_slots;
+		seg->table = (as_txn_key*)cf_malloc(n_slots * sizeof(as_txn_key));
+
+		for (uint32_t j = 0; j < n_slots; j++) {
+			seg->table[j].used = false;
+		}
 	}
 }
 
 static void
 as_txn_hash_clear(as_txn_hash* h)
 {
-	as_txn_hash_row* row = h->table;
-
-	for (uint32_t i = 0; i < h->n_rows; i++) {
-		if (row->used) {
-			as_txn_key* e = row->head.next;
+	for (uint32_t i = 0; i < AS_TXN_HASH_SEGMENTS; i++) {
+		as_txn_hash_segment* seg = &h->segments[i];
 
-			while (e != NULL) {
-				as_txn_key* t = e->next;
-				cf_free(e);
-				e = t;
+		if (seg->n_eles > 0) {
+			for (uint32_t j = 0; j < seg->n_slots; j++) {
+				seg->table[j].used = false;
 			}
-			row->used = false;
+			seg->n_eles = 0;
 		}
-		row++;
 	}
-	
 	h->n_eles = 0;
 }
 
 static void
 as_txn_hash_destroy(as_txn_hash* h)
 {
-	if (h->n_eles > 0) {
-		as_txn_hash_clear(h);
+	for (uint32_t i = 0; i < AS_TXN_HASH_SEGMENTS; i++) {
+		as_txn_hash_segment* seg = &h->segments[i];
+
+		pthread_mutex_destroy(&seg->lock);
+		cf_free(seg->table);
 	}
-	pthread_mutex_destroy(&h->lock);
-	cf_free(h->table);
 }
 
 static void
 as_txn_hash_put(as_txn_hash* h, const uint8_t* keyd, const char* set, uint64_t version)
 {
-	as_txn_hash_row* row = get_row(h, keyd);
-	as_txn_key* e = &row->head;
+	as_txn_hash_segment* seg = get_segment(h, keyd);
 
-	pthread_mutex_lock(&h->lock);
+	pthread_mutex_lock(&seg->lock);
 
-	// Most common case should be insert into empty row.
-	if (! row->used) {
-		fill_ele(e, keyd, set, version);
-		h->n_eles++;
-		row->used = true;
-		pthread_mutex_unlock(&h->lock);
-		return;
-	}
+	uint32_t mask = seg->n_slots - 1;
+	uint32_t i = get_slot(seg, keyd);
+
+	while (seg->table[i].used) {
+		as_txn_key* e = &seg->table[i];
 
-	do {
 		if (memcmp(keyd, e->digest, AS_DIGEST_VALUE_SIZE) == 0) {
 			e->version = version;
-			pthread_mutex_unlock(&h->lock);
+			pthread_mutex_unlock(&seg->lock);
 			return;
 		}
+		i = (i + 1) & mask;
+	}
 
-		e = e->next;
-	} while (e != NULL);
-
-	e = (as_txn_key*)cf_malloc(sizeof(as_txn_key));
-	fill_ele(e, keyd, set, version);
-	h->n_eles++;
+	fill_ele(&seg->table[i], keyd, set, version);
+	seg->n_eles++;
 
-	// Insert just after head.
-	e->next = row->head.next;
-	row->head.next = e;
+	// Keep load factor at or below 3/4 so probe sequences stay short.
+	if (seg->n_eles * 4 > seg->n_slots * 3) {
+		as_txn_segment_grow(seg);
+	}
 
-	pthread_mutex_unlock(&h->lock);
+	pthread_mutex_unlock(&seg->lock);
+	as_incr_uint32(&h->n_eles);
 }
 
 static void
 as_txn_hash_remove(as_txn_hash* h, const uint8_t* keyd)
 {
-	as_txn_hash_row* row = get_row(h, keyd);
-	as_txn_key* e = &row->head;
-	as_txn_key* e_prev = NULL;
-	as_txn_key* free_e = NULL;
+	as_txn_hash_segment* seg = get_segment(h, keyd);
+
+	pthread_mutex_lock(&seg->lock);
 
-	pthread_mutex_lock(&h->lock);
+	as_txn_key* e = as_txn_segment_find(seg, keyd);
 
-	if (! row->used) {
-		pthread_mutex_unlock(&h->lock);
+	if (! e) {
+		pthread_mutex_unlock(&seg->lock);
 		return;
 	}
 
-	do {
-		if (memcmp(keyd, e->digest, AS_DIGEST_VALUE_SIZE) == 0) {
-			if (e_prev != NULL) {
-				e_prev->next = e->next;
-				free_e = e;
-			}
-			else if (e->next == NULL) {
-				row->used = false;
-			}
-			else {
-				free_e = e->next;
-				*e = *e->next;
-			}
+	// Backward shift deletion. Move following keys of the probe sequence into the hole,
+	// so lookups never need tombstones.
+	uint32_t mask = seg->n_slots - 1;
+	uint32_t hole = (uint32_t)(e - seg->table);
+	uint32_t i = (hole + 1) & mask;
 
-			h->n_eles--;
-			break;
-		}
-		
-		e_prev = e;
-		e = e->next;
-	} while (e != NULL);
+	while (seg->table[i].used) {
+		uint32_t home = get_slot(seg, seg->table[i].digest);
 
-	pthread_mutex_unlock(&h->lock);
-
-	if (free_e != NULL) {
-		cf_free(free_e);
+		// Move key if its home slot is not cyclically in (hole, i].
+		if (((i - home) & mask) >= ((i - hole) & mask)) {
+			seg->table[hole] = seg->table[i];
+			hole = i;
+		}
+		i = (i + 1) & mask;
 	}
+
+	seg->table[hole].used = false;
+	seg->n_eles--;
+	pthread_mutex_unlock(&seg->lock);
+	as_decr_uint32(&h->n_eles);
 }
 
 static uint64_t
 as_txn_hash_get_version(as_txn_hash* h, const uint8_t* keyd)
 {
-	as_txn_hash_row* row = get_row(h, keyd);
-
-	if (! row->used) {
-		return 0;
-	}
-
-	as_txn_key* e = &row->head;
+	as_txn_hash_segment* seg = get_segment(h, keyd);
 
-	pthread_mutex_lock(&h->lock);
+	pthread_mutex_lock(&seg->lock);
 
-	if (! row->used) {
-		pthread_mutex_unlock(&h->lock);
-		return 0;
-	}
+	as_txn_key* e = as_txn_segment_find(seg, keyd);
+	uint64_t version = e ? e->version : 0;
 
-	do {
-		if (memcmp(keyd, e->digest, AS_DIGEST_VALUE_SIZE) == 0) {
-			uint64_t version = e->version;
-			pthread_mutex_unlock(&h->lock);
-			return version;
-		}
-
-		e = e->next;
-	} while (e != NULL);
-
-	pthread_mutex_unlock(&h->lock);
-	return 0;
+	pthread_mutex_unlock(&seg->lock);
+	return version;
 }
 
 static bool
 as_txn_hash_contains(as_txn_hash* h, const uint8_t* keyd)
 {
-	as_txn_hash_row* row = get_row(h, keyd);
-
-	if (! row->used) {
-		return false;
-	}
+	as_txn_hash_segment* seg = get_segment(h, keyd);
 
-	as_txn_key* e = &row->head;
+	pthread_mutex_lock(&seg->lock);
 
-	pthread_mutex_lock(&h->lock);
+	bool found = as_txn_segment_find(seg, keyd) != NULL;
 
-	if (! row->used) {
-		pthread_mutex_unlock(&h->lock);
-		return false;
-	}
-
-	do {
-		if (memcmp(keyd, e->digest, AS_DIGEST_VALUE_SIZE) == 0) {
-			pthread_mutex_unlock(&h->lock);
-			return true;
-		}
-
-		e = e->next;
-	} while (e != NULL);
-
-	pthread_mutex_unlock(&h->lock);
-	return false;
+	pthread_mutex_unlock(&seg->lock);
+	return found;
 }
 
 static void
@@ -415,22 +423,18 @@ as_txn_clear(as_txn* txn)
 as_txn_key*
 as_txn_iter_next(as_txn_iter* iter)
 {
-	if (iter->ele) {
-		as_txn_key* tmp = iter->ele;
-		iter->ele = tmp->next;
-		return tmp;
-	}
+	while (iter->segment < AS_TXN_HASH_SEGMENTS) {
+		as_txn_hash_segment* seg = &iter->khash->segments[iter->segment];
 
-	while (iter->idx < iter->khash->n_rows) {
-		if (iter->row->used) {
-			as_txn_key* tmp = &iter->row->head;
-			iter->ele = tmp->next;
-			iter->row++;
-			iter->idx++;
-			return tmp;
+		while (iter->idx < seg->n_slots) {
+			as_txn_key* e = &seg->table[iter->idx++];
+
+			if (e->used) {
+				return e;
+			}
 		}
-		iter->row++;
-		iter->idx++;
+		iter->segment++;
+		iter->idx = 0;
 	}
 	return NULL;
 }
@@ -21,7 +21,9 @@
 #include <aerospike/as_arraylist.h>
 #include <aerospike/as_atomic.h>
 #include <aerospike/as_batch.h>
+#include <aerospike/as_cluster.h>
 #include <aerospike/as_error.h>
+#include <aerospike/as_event.h>
 #include <aerospike/as_exp_operations.h>
 #include <aerospike/as_hashmap.h>
 #include <aerospike/as_integer.h>
@@ -35,6 +37,7 @@
 #include <aerospike/as_val.h>
 #include <pthread.h>
 #include "../test.h"
+#include "../aerospike_test.h"
 #include "../util/log_helper.h"
 
 //---------------------------------
@@ -356,6 +359,215 @@ TEST(batch_get_bins, "Batch Get - with bin name filters")
 	assert_int_eq(data.errors, 0);
 }
 
+static uint32_t
+batch_async_conns_opened(aerospike* client)
+{
+	uint32_t opened = 0;
+	as_nodes* nodes = as_nodes_reserve(client->cluster);
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+
+		for (uint32_t j = 0; j < as_event_loop_size; j++) {
+			opened += node->async_conn_pools[j].opened;
+		}
+	}
+	as_nodes_release(nodes);
+	return opened;
+}
+
+TEST(batch_read_event_loops, "Batch read sync on event loops")
+{
+	// Use a separate client, so the shared client config is not modified.
+	as_config config;
+	aerospike_test_config_init(&config);
+	config.sync_batch_event_loops = true;
+
+	aerospike* client = aerospike_new(&config);
+
+	as_error err;
+	as_status status = aerospike_connect(client, &err);
+
+	if (status != AEROSPIKE_OK) {
+		aerospike_destroy(client);
+	}
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	as_batch_records records;
+	as_batch_records_inita(&records, N_KEYS);
+
+	for (uint32_t i = 0; i < N_KEYS; i++) {
+		as_batch_read_record* r = as_batch_read_reserve(&records);
+		as_key_init_int64(&r->key, NAMESPACE, SET, i);
+		r->read_all_bins = true;
+	}
+
+	// Split into several sub-batches, so the event loop path is taken on a single node cluster.
+	as_policy_batch p;
+	as_policy_batch_init(&p);
+	p.concurrent = true;
+	p.max_records_per_command = N_KEYS / 4;
+
+	// The new client has not run any async commands, so async connections are only opened
+	// when the batch runs on event loops.
+	uint32_t opened_begin = batch_async_conns_opened(client);
+
+	status = aerospike_batch_read(client, &err, &p, &records);
+
+	uint32_t opened = batch_async_conns_opened(client) - opened_begin;
+
+	aerospike_close(client, &err);
+	aerospike_destroy(client);
+
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	if (as_event_loop_size > 0) {
+		assert_true(opened > 0);
+	}
+	else {
+		// Falls back to thread pool when event loops have not been created.
+		assert_int_eq(opened, 0);
+	}
+
+	uint32_t found = 0;
+	uint32_t errors = 0;
+	as_vector* list = &records.list;
+
+	for (uint32_t i = 0; i < list->size; i++) {
+		as_batch_read_record* r = as_vector_get(list, i);
+
+		if (r->result == AEROSPIKE_OK) {
+			int64_t val = as_record_get_int64(&r->record, bin1, -1);
+
+			if (val == (int64_t)i) {
+				found++;
+			}
+			else {
+				errors++;
+			}
+		}
+		else if (r->result != AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+			errors++;
+		}
+	}
+	as_batch_records_destroy(&records);
+
+	// Every 20th record is not written.
+	assert_int_eq(found, N_KEYS - N_KEYS / 20);
+	assert_int_eq(errors, 0);
+}
+
+static bool
+batch_split_callback(const as_batch_read* results, uint32_t n, void* udata)
+{
+	batch_stats* data = udata;
+
+	data->total = n;
+
+	for (uint32_t i = 0; i < n; i++) {
+		// Results must be in original key order.
+		int64_t key = as_integer_getorelse((as_integer*)results[i].key->valuep, -1);
+
+		if (key != (int64_t)i + 1) {
+			data->errors++;
+			continue;
+		}
+
+		if (results[i].result == AEROSPIKE_OK) {
+			data->found++;
+
+			if (as_record_get_int64(&results[i].record, bin1, -1) != key) {
+				data->errors++;
+			}
+		}
+		else if (results[i].result != AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+			data->errors++;
+		}
+	}
+	return true;
+}
+
+TEST(batch_get_split, "Batch get split into sub-batches")
+{
+	as_error err;
+
+	as_batch batch;
+	as_batch_inita(&batch, N_KEYS);
+
+	for (uint32_t i = 0; i < N_KEYS; i++) {
+		as_key_init_int64(as_batch_keyat(&batch,i), NAMESPACE, SET, i+1);
+	}
+
+	as_policy_batch p;
+	as_policy_batch_init(&p);
+	p.concurrent = true;
+	p.max_records_per_command = 7;
+
+	batch_stats data = {0};
+
+	aerospike_batch_get(as, &err, &p, &batch, batch_split_callback, &data);
+	if (err.code != AEROSPIKE_OK) {
+		info("error(%d): %s", err.code, err.message);
+	}
+	assert_int_eq(err.code, AEROSPIKE_OK);
+
+	assert_int_eq(data.total, N_KEYS);
+	assert_int_eq(data.found, N_KEYS - N_KEYS/20);
+	assert_int_eq(data.errors, 0);
+}
+
+TEST(batch_read_split_concurrent, "Batch read split into more sub-batches than nodes")
+{
+	as_batch_records records;
+	as_batch_records_inita(&records, N_KEYS);
+
+	for (uint32_t i = 0; i < N_KEYS; i++) {
+		as_batch_read_record* r = as_batch_read_reserve(&records);
+		as_key_init_int64(&r->key, NAMESPACE, SET, i);
+		r->read_all_bins = true;
+	}
+
+	as_policy_batch p;
+	as_policy_batch_init(&p);
+	p.concurrent = true;
+	p.max_records_per_command = 2;
+
+	// Each node group must be split, so there are more concurrent tasks than nodes.
+	as_nodes* nodes = as_nodes_reserve(as->cluster);
+	uint32_t n_nodes = nodes->size;
+	as_nodes_release(nodes);
+	assert_true(N_KEYS / p.max_records_per_command > n_nodes);
+
+	as_error err;
+	as_status status = aerospike_batch_read(as, &err, &p, &records);
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	uint32_t found = 0;
+	uint32_t errors = 0;
+	as_vector* list = &records.list;
+
+	for (uint32_t i = 0; i < list->size; i++) {
+		as_batch_read_record* r = as_vector_get(list, i);
+
+		if (r->result == AEROSPIKE_OK) {
+			if (as_record_get_int64(&r->record, bin1, -1) == (int64_t)i) {
+				found++;
+			}
+			else {
+				errors++;
+			}
+		}
+		else if (r->result != AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+			errors++;
+		}
+	}
+	as_batch_records_destroy(&records);
+
+	// Every 20th record is not written.
+	assert_int_eq(found, N_KEYS - N_KEYS / 20);
+	assert_int_eq(errors, 0);
+}
+
 TEST(batch_read_complex, "Batch read complex")
 {
 	// Batch allows multiple namespaces in one call, but example test environment may only have one namespace.
@@ -1168,6 +1380,9 @@ SUITE(batch, "aerospike batch tests")
 	suite_add(batch_get_1);
 	suite_add(multithreaded_batch_get);
 	suite_add(batch_get_bins);
+	suite_add(batch_read_event_loops);
+	suite_add(batch_get_split);
+	suite_add(batch_read_split_concurrent);
 	suite_add(batch_read_complex);
 	suite_add(batch_read_list_operate);
 	suite_add(batch_write_list_operate);
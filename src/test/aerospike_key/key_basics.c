@@ -19,6 +19,7 @@
 #include <aerospike/aerospike_scan.h>
 #include <aerospike/as_arraylist.h>
 #include <aerospike/as_buffer.h>
+#include <aerospike/as_cluster.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_hashmap.h>
 #include <aerospike/as_integer.h>
@@ -28,10 +29,16 @@
 #include <aerospike/as_record.h>
 #include <aerospike/as_serializer.h>
 #include <aerospike/as_sleep.h>
+#include <aerospike/as_socket.h>
 #include <aerospike/as_status.h>
 #include <aerospike/as_string.h>
 #include <aerospike/as_stringmap.h>
 #include <aerospike/as_val.h>
+#include <citrusleaf/cf_clock.h>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 #include "../test.h"
 
@@ -203,6 +210,44 @@ TEST( key_basics_get , "get: (test,test,foo) = {a: 123, b: 'abc', c: 456, d: 'de
 	as_record_destroy(rec);
 }
 
+TEST( key_basics_get_bin_arena , "get with bin arena: (test,test,foo)" ) {
+
+	as_error err;
+	as_error_reset(&err);
+
+	as_policy_read policy;
+	as_policy_read_init(&policy);
+	policy.bin_arena = true;
+
+	as_key key;
+	as_key_init(&key, NAMESPACE, SET, "foo");
+
+	as_record* rec = NULL;
+	as_status rc = aerospike_key_get(as, &err, &policy, &key, &rec);
+
+	as_key_destroy(&key);
+
+	assert_int_eq( rc, AEROSPIKE_OK );
+	assert_int_eq( as_record_numbins(rec), 7 );
+	assert_int_eq( as_record_get_int64(rec, "a", 0), 123 );
+	assert_string_eq( as_record_get_str(rec, "b"), "abc" );
+	assert_string_eq( as_record_get_str(rec, "d"), "def" );
+
+	as_list * list = as_record_get_list(rec, "e");
+	assert_not_null( list );
+	assert_int_eq( as_list_size(list), 3 );
+
+	as_map * map = as_record_get_map(rec, "f");
+	assert_not_null( map );
+	assert_int_eq( as_map_size(map), 3 );
+
+	// Replace arena backed value before destroy.
+	as_record_set_str(rec, "b", "xyz");
+	assert_string_eq( as_record_get_str(rec, "b"), "xyz" );
+
+	as_record_destroy(rec);
+}
+
 TEST( key_basics_select , "select: (test,test,foo) = {a: 123, b: 'abc'}" ) {
 
 	as_error err;
@@ -877,6 +922,230 @@ TEST(key_basics_reset_read_ttl, "reset read ttl")
 	assert_int_eq(status, AEROSPIKE_ERR_RECORD_NOT_FOUND);
 }
 
+TEST(key_basics_set_digests, "batch digests match single key digests")
+{
+	// Mix key types and lengths so messages span several RIPEMD-160 block counts.
+	uint32_t n_keys = 21;
+	as_key keys[21];
+	as_key single;
+	char buf[256];
+	uint8_t blob[40];
+
+	for (uint32_t i = 0; i < sizeof(blob); i++) {
+		blob[i] = (uint8_t)i;
+	}
+
+	for (uint32_t i = 0; i < n_keys; i++) {
+		if (i % 3 == 0) {
+			as_key_init_int64(&keys[i], NAMESPACE, SET, (int64_t)i * 7919);
+		}
+		else if (i % 3 == 1) {
+			uint32_t len = i * 12;
+			memset(buf, 'a' + i, len);
+			buf[len] = 0;
+			as_key_init_strp(&keys[i], NAMESPACE, SET, strdup(buf), true);
+		}
+		else {
+			as_key_init_rawp(&keys[i], NAMESPACE, SET, blob, i * 2, false);
+		}
+	}
+
+	as_error err;
+	as_status status = as_keys_set_digests(&err, keys, n_keys);
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	for (uint32_t i = 0; i < n_keys; i++) {
+		assert_true(keys[i].digest.init);
+
+		as_key_init_value(&single, NAMESPACE, SET, keys[i].valuep);
+		status = as_key_set_digest(&err, &single);
+		assert_int_eq(status, AEROSPIKE_OK);
+		assert_int_eq(memcmp(single.digest.value, keys[i].digest.value, AS_DIGEST_VALUE_SIZE), 0);
+		as_key_destroy(&keys[i]);
+	}
+}
+
+TEST(key_basics_get_fastest, "get with AS_POLICY_REPLICA_FASTEST")
+{
+	as_error err;
+
+	as_key key;
+	as_key_init(&key, NAMESPACE, SET, "foo");
+
+	as_policy_read p;
+	as_policy_read_init(&p);
+	p.replica = AS_POLICY_REPLICA_FASTEST;
+
+	for (uint32_t i = 0; i < 100; i++) {
+		as_record* rec = NULL;
+		as_status status = aerospike_key_get(as, &err, &p, &key, &rec);
+		assert_int_eq(status, AEROSPIKE_OK);
+		assert_int_eq(as_record_get_int64(rec, "a", 0), 123);
+		as_record_destroy(rec);
+	}
+	as_key_destroy(&key);
+
+	// At least one node must have latency samples and no reads may remain in flight.
+	as_nodes* nodes = as_nodes_reserve(as->cluster);
+	uint32_t sampled = 0;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node* node = nodes->array[i];
+
+		if (as_load_uint32(&node->latency_ewma) > 0) {
+			sampled++;
+		}
+		assert_int_eq(as_load_uint32(&node->inflight), 0);
+	}
+	as_nodes_release(nodes);
+	assert_true(sampled > 0);
+}
+
+TEST(key_basics_get_hedge, "get with hedged reads")
+{
+	as_error err;
+
+	as_key key;
+	as_key_init(&key, NAMESPACE, SET, "foo");
+
+	as_policy_read p;
+	as_policy_read_init(&p);
+	p.replica = AS_POLICY_REPLICA_SEQUENCE;
+	p.hedge_delay = 1;
+
+	for (uint32_t i = 0; i < 100; i++) {
+		as_record* rec = NULL;
+		as_status status = aerospike_key_get(as, &err, &p, &key, &rec);
+		assert_int_eq(status, AEROSPIKE_OK);
+		assert_int_eq(as_record_get_int64(rec, "a", 0), 123);
+		as_record_destroy(rec);
+	}
+
+	// Hedging at the observed p95 must also return the record.
+	p.hedge_delay = AS_POLICY_HEDGE_DELAY_P95;
+
+	for (uint32_t i = 0; i < 100; i++) {
+		as_record* rec = NULL;
+		as_status status = aerospike_key_get(as, &err, &p, &key, &rec);
+		assert_int_eq(status, AEROSPIKE_OK);
+		assert_int_eq(as_record_get_int64(rec, "a", 0), 123);
+		as_record_destroy(rec);
+	}
+	as_key_destroy(&key);
+
+	assert_true(as_cluster_get_hedge_win_count(as->cluster) <=
+		as_cluster_get_hedge_count(as->cluster));
+
+	// Cancelled hedges must not leave reads in flight.
+	as_nodes* nodes = as_nodes_reserve(as->cluster);
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		assert_int_eq(as_load_uint32(&nodes->array[i]->inflight), 0);
+	}
+	as_nodes_release(nodes);
+}
+
+TEST(key_basics_put_gather, "put large string and blob values sent in place")
+{
+	as_error err;
+
+	as_key key;
+	as_key_init(&key, NAMESPACE, SET, "foo_gather");
+
+	uint32_t blob_size = 256 * 1024;
+	uint8_t* blob = malloc(blob_size);
+
+	for (uint32_t i = 0; i < blob_size; i++) {
+		blob[i] = (uint8_t)i;
+	}
+
+	uint32_t str_size = 20 * 1024;
+	char* str = malloc(str_size + 1);
+	memset(str, 'x', str_size);
+	str[str_size] = 0;
+
+	// Small bins between the large values are written to the command buffer.
+	as_record rec;
+	as_record_inita(&rec, 4);
+	as_record_set_raw(&rec, "a", blob, blob_size);
+	as_record_set_int64(&rec, "b", 7);
+	as_record_set_str(&rec, "c", str);
+	as_record_set_str(&rec, "d", "abc");
+
+	as_status status = aerospike_key_put(as, &err, NULL, &key, &rec);
+	assert_int_eq(status, AEROSPIKE_OK);
+	as_record_destroy(&rec);
+
+	as_record* prec = NULL;
+	status = aerospike_key_get(as, &err, NULL, &key, &prec);
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	as_bytes* bytes = as_record_get_bytes(prec, "a");
+	assert_not_null(bytes);
+	assert_int_eq(bytes->size, blob_size);
+	assert_int_eq(memcmp(bytes->value, blob, blob_size), 0);
+	assert_int_eq(as_record_get_int64(prec, "b", 0), 7);
+
+	char* s = as_record_get_str(prec, "c");
+	assert_not_null(s);
+	assert_int_eq(strlen(s), str_size);
+	assert_string_eq(as_record_get_str(prec, "d"), "abc");
+	as_record_destroy(prec);
+
+	free(str);
+	free(blob);
+	as_key_destroy(&key);
+}
+
+TEST(key_basics_socket_spin, "socket spin mode reads and times out on a silent peer")
+{
+	as_error err;
+
+	as_key key;
+	as_key_init(&key, NAMESPACE, SET, "foo_spin");
+
+	as_record rec;
+	as_record_inita(&rec, 1);
+	as_record_set_int64(&rec, "a", 11);
+
+	aerospike_socket_spin(100, 0);
+
+	as_status status = aerospike_key_put(as, &err, NULL, &key, &rec);
+	assert_int_eq(status, AEROSPIKE_OK);
+	as_record_destroy(&rec);
+
+	as_record* prec = NULL;
+	status = aerospike_key_get(as, &err, NULL, &key, &prec);
+	assert_int_eq(status, AEROSPIKE_OK);
+	assert_int_eq(as_record_get_int64(prec, "a", 0), 11);
+	as_record_destroy(prec);
+	as_key_destroy(&key);
+
+	// The peer never writes. With a spin period far longer than the deadline, the read must
+	// still time out at the deadline instead of spinning for the whole spin period.
+	int fds[2];
+	assert_int_eq(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL, 0) | O_NONBLOCK);
+
+	as_socket sock;
+	memset(&sock, 0, sizeof(sock));
+	sock.fd = fds[0];
+
+	aerospike_socket_spin(10 * 1000 * 1000, 0);
+
+	uint8_t buf[8];
+	uint64_t begin = cf_getms();
+	status = as_socket_read_deadline(&err, &sock, NULL, buf, sizeof(buf), 0, begin + 100, NULL);
+	uint64_t elapsed = cf_getms() - begin;
+
+	aerospike_socket_spin(0, 0);
+	close(fds[0]);
+	close(fds[1]);
+
+	assert_int_eq(status, AEROSPIKE_ERR_TIMEOUT);
+	assert_true(elapsed < 2000);
+}
+
 /******************************************************************************
  * TEST SUITE
  *****************************************************************************/
@@ -892,6 +1161,12 @@ SUITE(key_basics, "aerospike_key basic tests") {
 	suite_add(key_basics_put_generation);
 	suite_add(key_basics_put);
 	suite_add(key_basics_get);
+	suite_add(key_basics_get_bin_arena);
+	suite_add(key_basics_get_fastest);
+	suite_add(key_basics_get_hedge);
+	suite_add(key_basics_put_gather);
+	suite_add(key_basics_socket_spin);
+	suite_add(key_basics_set_digests);
 	suite_add(key_basics_select);
 	suite_add(key_basics_operate);
 	suite_add(key_basics_get2);
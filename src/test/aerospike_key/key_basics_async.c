@@ -17,6 +17,7 @@
 #include <aerospike/aerospike.h>
 #include <aerospike/aerospike_key.h>
 #include <aerospike/as_arraylist.h>
+#include <aerospike/as_atomic.h>
 #include <aerospike/as_buffer.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_hashmap.h>
@@ -452,6 +453,62 @@ TEST(key_basics_async_operate_heap, "async operate with record on heap")
 	as_monitor_wait(&monitor);
 }
 
+#define GET_MANY_SIZE 20
+
+static void
+as_get_many_callback(as_error* err, as_record* rec, void* udata, as_event_loop* event_loop)
+{
+	counter_data* data = udata;
+
+	if (err) {
+		data->result->success = false;
+		snprintf(data->result->message, sizeof(data->result->message), "%d %s",
+			err->code, err->message);
+	}
+	else if (as_record_get_int64(rec, "a", -1) < 0) {
+		data->result->success = false;
+		snprintf(data->result->message, sizeof(data->result->message), "Bin a not found");
+	}
+
+	if (as_faa_uint32(&data->counter, 1) + 1 == GET_MANY_SIZE) {
+		as_monitor_notify(&monitor);
+	}
+}
+
+TEST(key_basics_async_get_many, "async get many")
+{
+	as_key keys[GET_MANY_SIZE];
+	void* udata[GET_MANY_SIZE];
+	counter_data data = {__result__, 0};
+	as_error err;
+
+	for (uint32_t i = 0; i < GET_MANY_SIZE; i++) {
+		as_key_init_int64(&keys[i], NAMESPACE, SET, 1000 + i);
+		udata[i] = &data;
+
+		as_record rec;
+		as_record_inita(&rec, 1);
+		as_record_set_int64(&rec, "a", i);
+
+		as_status status = aerospike_key_put(as, &err, NULL, &keys[i], &rec);
+		as_record_destroy(&rec);
+		assert_int_eq(status, AEROSPIKE_OK);
+	}
+
+	as_monitor_begin(&monitor);
+
+	as_status status = aerospike_key_get_async_many(as, &err, NULL, keys, GET_MANY_SIZE,
+		as_get_many_callback, udata, NULL);
+
+	assert_int_eq(status, AEROSPIKE_OK);
+	as_monitor_wait(&monitor);
+	assert_int_eq(data.counter, GET_MANY_SIZE);
+
+	for (uint32_t i = 0; i < GET_MANY_SIZE; i++) {
+		as_key_destroy(&keys[i]);
+	}
+}
+
 /******************************************************************************
  * TEST SUITE
  *****************************************************************************/
@@ -468,4 +525,5 @@ SUITE(key_basics_async, "aerospike_key basic tests")
 	suite_add(key_basics_async_remove);
 	suite_add(key_basics_async_operate);
 	suite_add(key_basics_async_operate_heap);
+	suite_add(key_basics_async_get_many);
 }
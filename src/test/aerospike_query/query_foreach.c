@@ -479,6 +479,78 @@ TEST(query_foreach_1, "count(*) where a == 'abc' (non-aggregating)")
 	as_query_destroy(&q);
 }
 
+TEST(query_stream, "stream records where a == 'abc' with small record queue")
+{
+	as_error err;
+	as_error_reset(&err);
+
+	as_policy_query p;
+	as_policy_query_init(&p);
+	p.record_queue_size = 8;
+
+	as_query q;
+	as_query_init(&q, NAMESPACE, SET);
+
+	as_query_select_inita(&q, 1);
+	as_query_select(&q, "c");
+
+	as_query_where_inita(&q, 1);
+	as_query_where(&q, "a", as_string_equals("abc"));
+
+	as_record_stream* stream;
+	as_status status = aerospike_query_stream(as, &err, &p, &q, &stream);
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	uint32_t count = 0;
+	as_record* rec;
+
+	while ((status = as_record_stream_next(stream, &err, &rec)) == AEROSPIKE_OK && rec) {
+		if (as_record_get(rec, "c")) {
+			count++;
+		}
+		as_record_destroy(rec);
+	}
+	as_record_stream_close(stream);
+
+	assert_int_eq(status, AEROSPIKE_OK);
+	assert_int_eq(count, 100);
+
+	as_query_destroy(&q);
+}
+
+TEST(query_stream_close, "close record stream before all records are read")
+{
+	as_error err;
+	as_error_reset(&err);
+
+	as_policy_query p;
+	as_policy_query_init(&p);
+	p.record_queue_size = 2;
+
+	as_query q;
+	as_query_init(&q, NAMESPACE, SET);
+
+	as_query_where_inita(&q, 1);
+	as_query_where(&q, "a", as_string_equals("abc"));
+
+	as_record_stream* stream;
+	as_status status = aerospike_query_stream(as, &err, &p, &q, &stream);
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	as_record* rec;
+
+	for (uint32_t i = 0; i < 5; i++) {
+		status = as_record_stream_next(stream, &err, &rec);
+		assert_int_eq(status, AEROSPIKE_OK);
+		assert_not_null(rec);
+		as_record_destroy(rec);
+	}
+
+	// Node threads blocked on the full queue must be released.
+	as_record_stream_close(stream);
+	as_query_destroy(&q);
+}
+
 static bool
 query_foreach_2_callback(const as_val* v, void* udata)
 {
@@ -1445,6 +1517,143 @@ TEST(query_agg_quit_early, "aggregation and quit early")
 	as_query_destroy(&q);
 }
 
+TEST(query_agg_parallel, "sum(e) where a == 'abc' with parallel node streams")
+{
+	as_error err;
+	as_error_reset(&err);
+
+	int64_t value = 0;
+
+	as_policy_query p;
+	as_policy_query_init(&p);
+	p.aggregate_parallel = true;
+
+	as_query q;
+	as_query_init(&q, NAMESPACE, SET);
+
+	as_query_where_inita(&q, 1);
+	as_query_where(&q, "a", as_string_equals("abc"));
+
+	as_query_apply(&q, UDF_FILE, "sum", NULL);
+
+	// Falls back to a single merged stream when the cluster has one node or
+	// the thread pool is too small. The result must be the same either way.
+	if (aerospike_query_foreach(as, &err, &p, &q, query_foreach_3_callback, &value) != AEROSPIKE_OK) {
+		error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+	}
+
+	info("value: %ld", value);
+
+	assert_int_eq(err.code, AEROSPIKE_OK);
+	assert_int_eq(value, 24275);
+
+	as_query_destroy(&q);
+}
+
+typedef struct {
+	uint32_t count;
+	int64_t idx_sum;
+} query_agg_slow_data;
+
+static bool
+query_agg_slow_callback(const as_val* v, void* udata)
+{
+	if (v) {
+		as_map* map = as_map_fromval(v);
+
+		if (map) {
+			query_agg_slow_data* data = (query_agg_slow_data*)udata;
+			data->count++;
+			data->idx_sum += as_stringmap_get_int64(map, "idx");
+		}
+		// Slow consumer. The lua thread blocks here, so node threads fill the
+		// bounded input stream and must wait for space.
+		as_sleep(2);
+	}
+	return true;
+}
+
+static void
+query_agg_slow(bool parallel)
+{
+	as_error err;
+	as_error_reset(&err);
+
+	query_agg_slow_data data = {0};
+
+	as_policy_query p;
+	as_policy_query_init(&p);
+	p.aggregate_queue_capacity = 2;
+	p.aggregate_parallel = parallel;
+
+	as_query q;
+	as_query_init(&q, NAMESPACE, SET);
+
+	as_query_where_inita(&q, 1);
+	as_query_where(&q, "a", as_string_equals("abc"));
+
+	as_query_apply(&q, UDF_FILE, "filter_passthrough", NULL);
+
+	if (aerospike_query_foreach(as, &err, &p, &q, query_agg_slow_callback, &data) != AEROSPIKE_OK) {
+		error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+	}
+
+	info("count: %u idx_sum: %ld", data.count, data.idx_sum);
+
+	// Backpressure must not drop or duplicate records.
+	assert_int_eq(err.code, AEROSPIKE_OK);
+	assert_int_eq(data.count, 100);
+	assert_int_eq(data.idx_sum, 4950);
+
+	as_query_destroy(&q);
+}
+
+TEST(query_agg_backpressure, "aggregation with slow consumer and small queue")
+{
+	query_agg_slow(false);
+}
+
+TEST(query_agg_backpressure_parallel, "parallel aggregation with slow consumer and small queue")
+{
+	query_agg_slow(true);
+}
+
+TEST(query_agg_backpressure_quit_early, "aggregation with small queue and quit early")
+{
+	as_nodes* nodes = as_nodes_reserve(as->cluster);
+	uint32_t nodes_size = nodes->size;
+	as_nodes_release(nodes);
+
+	as_error err;
+	as_error_reset(&err);
+
+	uint32_t count = 0;
+
+	as_policy_query p;
+	as_policy_query_init(&p);
+	p.aggregate_queue_capacity = 1;
+
+	as_query q;
+	as_query_init(&q, NAMESPACE, SET);
+
+	as_query_where_inita(&q, 1);
+	as_query_where(&q, "a", as_string_equals("abc"));
+
+	as_query_apply(&q, UDF_FILE, "filter_passthrough", NULL);
+
+	// Node threads blocked on a full queue must be released when the user quits.
+	if (aerospike_query_foreach(as, &err, &p, &q, query_quit_early_callback, &count) != AEROSPIKE_OK) {
+		error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+	}
+
+	info("count: %d",count);
+
+	assert_int_eq(err.code, 0);
+	assert_true(count <= nodes_size);
+
+	as_query_destroy(&q);
+}
+
 static bool
 query_quit_early_bytes_callback(const as_val* v, void* udata)
 {
@@ -1904,6 +2113,8 @@ SUITE(query_foreach, "aerospike_query_foreach tests")
 	}
 
 	suite_add(query_foreach_1);
+	suite_add(query_stream);
+	suite_add(query_stream_close);
 	suite_add(query_foreach_2);
 	suite_add(query_foreach_3);
 	suite_add(query_foreach_4);
@@ -1931,6 +2142,10 @@ SUITE(query_foreach, "aerospike_query_foreach tests")
 	suite_add(query_with_mapval_filter);
 	suite_add(query_quit_early);
 	suite_add(query_agg_quit_early);
+	suite_add(query_agg_parallel);
+	suite_add(query_agg_backpressure);
+	suite_add(query_agg_backpressure_parallel);
+	suite_add(query_agg_backpressure_quit_early);
 	suite_add(query_filter_map_bytes);
 	suite_add(query_foreach_nullset);
 	suite_add(query_foreach_int_with_double_bin);
@@ -514,6 +514,67 @@ TEST(scan_basics_set1 , "scan "SET1"")
 	as_scan_destroy(&scan);
 }
 
+static bool scan_borrow_callback(const as_val* val, void* udata)
+{
+	if (!val) {
+		return false;
+	}
+
+	scan_check* check = (scan_check*) udata;
+	as_record* rec = as_record_fromval(val);
+
+	as_bytes* b = as_bytes_fromval((as_val*)as_record_get(rec, "bin3"));
+
+	if (!b || b->type != AS_BYTES_MAP || b->free) {
+		error("Expected borrowed map bytes in bin3");
+		return !(check->failed = true);
+	}
+
+	// Copy must own its bin values after the callback returns.
+	as_record* copy = as_record_copy(rec);
+	as_bytes* cb = as_bytes_fromval((as_val*)as_record_get(copy, "bin3"));
+
+	if (!cb || !cb->free || cb->size != b->size || memcmp(cb->value, b->value, b->size) != 0 ||
+		as_record_get_int64(copy, "bin1", -1) != as_record_get_int64(rec, "bin1", -2) ||
+		strcmp(as_record_get_str(copy, "bin2"), as_record_get_str(rec, "bin2")) != 0) {
+		error("Record copy does not match borrowed record");
+		check->failed = true;
+	}
+
+	as_record_destroy(copy);
+	as_incr_uint32(&check->count);
+	return !check->failed;
+}
+
+TEST(scan_basics_set1_borrow , "scan "SET1" with borrowed bytes")
+{
+	scan_check check = {
+		.failed = false,
+		.set = SET1,
+		.count = 0,
+		.nobindata = false,
+		.bins = { "bin1", "bin2", "bin3", NULL }
+	};
+
+	as_error err;
+
+	as_policy_scan policy;
+	as_policy_scan_init(&policy);
+	policy.borrow_bytes = true;
+
+	as_scan scan;
+	as_scan_init(&scan, NS, SET1);
+	scan.deserialize_list_map = false;
+
+	as_status rc = aerospike_scan_foreach(as, &err, &policy, &scan, scan_borrow_callback, &check);
+
+	assert_int_eq(rc, AEROSPIKE_OK);
+	assert_false(check.failed);
+	assert_int_eq(check.count, NUM_RECS_SET1);
+
+	as_scan_destroy(&scan);
+}
+
 TEST(scan_filter_set1 , "scan "SET1" w/ 25 <= bin1 <= 33")
 {
 	scan_check check = {
@@ -1467,6 +1528,7 @@ SUITE(scan_basics, "aerospike_scan basic tests")
 
 	suite_add(scan_basics_null_set);
 	suite_add(scan_basics_set1);
+	suite_add(scan_basics_set1_borrow);
 	suite_add(scan_filter_set1);
 	suite_add(scan_basics_set1_concurrent);
 	suite_add(scan_basics_set1_select);
@@ -16,6 +16,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if defined(_MSC_VER)
 #undef _UNICODE  // Use ASCII getopt version on windows.
@@ -60,6 +61,12 @@ bool g_has_query_expression = false;
 // Static Functions
 //---------------------------------
 
+static char*
+test_strdup(const char* s)
+{
+	return s ? strdup(s) : NULL;
+}
+
 static bool
 as_client_log_callback(as_log_level level, const char * func, const char * file, uint32_t line, const char * fmt, ...)
 {
@@ -280,6 +287,30 @@ static bool parse_opts(int argc, char* argv[])
 	return true;
 }
 
+void
+aerospike_test_config_init(as_config* config)
+{
+	as_config_init(config);
+	as_config_add_hosts(config, g_host, g_port);
+	as_config_set_user(config, g_user, g_password);
+	config->auth_mode = g_auth_mode;
+
+	// The global client owns the g_tls strings, so give this config its own copies.
+	as_config_tls* tls = &config->tls;
+	memcpy(tls, &g_tls, sizeof(as_config_tls));
+	tls->cafile = test_strdup(g_tls.cafile);
+	tls->castring = test_strdup(g_tls.castring);
+	tls->capath = test_strdup(g_tls.capath);
+	tls->protocols = test_strdup(g_tls.protocols);
+	tls->cipher_suite = test_strdup(g_tls.cipher_suite);
+	tls->cert_blacklist = test_strdup(g_tls.cert_blacklist);
+	tls->keyfile = test_strdup(g_tls.keyfile);
+	tls->keyfile_pw = test_strdup(g_tls.keyfile_pw);
+	tls->keystring = test_strdup(g_tls.keystring);
+	tls->certfile = test_strdup(g_tls.certfile);
+	tls->certstring = test_strdup(g_tls.certstring);
+}
+
 static bool before(atf_plan* plan)
 {
 	if ( as ) {
@@ -518,6 +549,9 @@ PLAN(aerospike_test)
 	plan_add(error_detail_parser);
 	plan_add(error_detail_policy);
 	plan_add(error_detail_sync);
+	plan_add(buffer_pool);
+	plan_add(cluster);
+	plan_add(tls);
 
 	/*
 	 * shm_second_client: skip on github.com CI by default. The monolithic test
@@ -16,7 +16,18 @@
  */
 #pragma once
 
+#include <aerospike/as_config.h>
+
 #define MAX_HOST_SIZE 1024
 extern char g_host[MAX_HOST_SIZE];
 extern int g_port;
 extern bool g_enable_tls;
+extern as_config_tls g_tls;
+
+/**
+ * Initialize config for a separate client that connects to the same cluster with the same
+ * credentials and TLS settings as the global client. Ownership of heap allocated fields is
+ * transferred to the client in aerospike_new() or aerospike_init().
+ */
+void
+aerospike_test_config_init(as_config* config);
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2008-2026 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/as_buffer_pool.h>
+#include <pthread.h>
+#include "test.h"
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+#define MIN_CLASS_SIZE ((size_t)1 << AS_BUFFER_POOL_MIN_SHIFT)
+#define MAX_CLASS_SIZE ((size_t)1 << (AS_BUFFER_POOL_MIN_SHIFT + AS_BUFFER_POOL_CLASSES - 1))
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static void*
+pool_thread_run(void* udata)
+{
+	return as_buffer_pool_thread();
+}
+
+//---------------------------------
+// Tests
+//---------------------------------
+
+TEST(buffer_pool_get_put, "get rounds up to size class and put caches for reuse")
+{
+	as_buffer_pool pool;
+	as_buffer_pool_init(&pool);
+
+	size_t capacity = 0;
+	uint8_t* buf = as_buffer_pool_get(&pool, 100, &capacity);
+	assert_not_null(buf);
+	assert_int_eq(capacity, MIN_CLASS_SIZE);
+	assert_int_eq(pool.cached_bytes, 0);
+
+	size_t capacity2 = 0;
+	uint8_t* buf2 = as_buffer_pool_get(&pool, MIN_CLASS_SIZE + 1, &capacity2);
+	assert_not_null(buf2);
+	assert_int_eq(capacity2, MIN_CLASS_SIZE * 2);
+
+	as_buffer_pool_put(&pool, buf, capacity);
+	as_buffer_pool_put(&pool, buf2, MIN_CLASS_SIZE + 1);
+	assert_int_eq(pool.classes[0].size, 1);
+	assert_int_eq(pool.classes[1].size, 1);
+	assert_int_eq(pool.cached_bytes, MIN_CLASS_SIZE * 3);
+
+	// Cached buffer is handed out again.
+	uint8_t* buf3 = as_buffer_pool_get(&pool, 200, &capacity);
+	assert_true(buf3 == buf);
+	assert_int_eq(pool.classes[0].size, 0);
+	assert_int_eq(pool.cached_bytes, MIN_CLASS_SIZE * 2);
+
+	as_buffer_pool_put(&pool, buf3, capacity);
+	as_buffer_pool_destroy(&pool);
+	assert_int_eq(pool.cached_bytes, 0);
+	assert_int_eq(pool.classes[0].size, 0);
+	assert_int_eq(pool.classes[1].size, 0);
+}
+
+TEST(buffer_pool_oversize, "buffers larger than the largest size class are not cached")
+{
+	as_buffer_pool pool;
+	as_buffer_pool_init(&pool);
+
+	size_t size = MAX_CLASS_SIZE + 1;
+	size_t capacity = 0;
+	uint8_t* buf = as_buffer_pool_get(&pool, size, &capacity);
+	assert_not_null(buf);
+	assert_int_eq(capacity, size);
+
+	as_buffer_pool_put(&pool, buf, capacity);
+	assert_int_eq(pool.cached_bytes, 0);
+	as_buffer_pool_destroy(&pool);
+}
+
+TEST(buffer_pool_trim, "high-water trim releases buffers that are no longer needed")
+{
+	as_buffer_pool pool;
+	as_buffer_pool_init(&pool);
+
+	// Two buffers in use at the same time leave two cached buffers.
+	size_t capacity = 0;
+	uint8_t* buf = as_buffer_pool_get(&pool, 100, &capacity);
+	uint8_t* buf2 = as_buffer_pool_get(&pool, 100, &capacity);
+	as_buffer_pool_put(&pool, buf, capacity);
+	as_buffer_pool_put(&pool, buf2, capacity);
+	assert_int_eq(pool.classes[0].size, 2);
+
+	// Only one buffer is needed at a time from now on. The second trim drops the extra buffer.
+	for (uint32_t i = 0; i < AS_BUFFER_POOL_TRIM_INTERVAL * 2; i++) {
+		buf = as_buffer_pool_get(&pool, 100, &capacity);
+		as_buffer_pool_put(&pool, buf, capacity);
+	}
+	assert_int_eq(pool.classes[0].size, 1);
+	assert_int_eq(pool.cached_bytes, MIN_CLASS_SIZE);
+	as_buffer_pool_destroy(&pool);
+}
+
+TEST(buffer_pool_idle, "pool releases large buffers when the last buffer is returned")
+{
+	as_buffer_pool pool;
+	as_buffer_pool_init(&pool);
+
+	size_t capacity = 0;
+	uint8_t* bufs[AS_BUFFER_POOL_CLASS_CAPACITY];
+
+	for (uint32_t i = 0; i < AS_BUFFER_POOL_CLASS_CAPACITY; i++) {
+		bufs[i] = as_buffer_pool_get(&pool, MAX_CLASS_SIZE / 2, &capacity);
+	}
+
+	// Returned buffers are cached while other buffers are still in use.
+	for (uint32_t i = 0; i < AS_BUFFER_POOL_CLASS_CAPACITY - 1; i++) {
+		as_buffer_pool_put(&pool, bufs[i], capacity);
+	}
+	assert_true(pool.cached_bytes > AS_BUFFER_POOL_IDLE_BYTES);
+
+	// Returning the last buffer trims the pool to the idle limit.
+	as_buffer_pool_put(&pool, bufs[AS_BUFFER_POOL_CLASS_CAPACITY - 1], capacity);
+	assert_true(pool.cached_bytes <= AS_BUFFER_POOL_IDLE_BYTES);
+	as_buffer_pool_destroy(&pool);
+}
+
+TEST(buffer_pool_thread, "each thread has its own pool")
+{
+	as_buffer_pool* pool = as_buffer_pool_thread();
+	assert_not_null(pool);
+	assert_true(as_buffer_pool_thread() == pool);
+
+	// The other thread's pool is freed by the thread exit destructor.
+	pthread_t thread;
+	void* other = NULL;
+	assert_int_eq(pthread_create(&thread, NULL, pool_thread_run, NULL), 0);
+	pthread_join(thread, &other);
+	assert_not_null(other);
+	assert_true(other != pool);
+}
+
+//---------------------------------
+// Test Suite
+//---------------------------------
+
+SUITE(buffer_pool, "Command buffer pool tests")
+{
+	suite_add(buffer_pool_get_put);
+	suite_add(buffer_pool_oversize);
+	suite_add(buffer_pool_trim);
+	suite_add(buffer_pool_idle);
+	suite_add(buffer_pool_thread);
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright 2008-2026 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_cluster.h>
+#include <aerospike/as_conn_pool.h>
+#include <aerospike/as_node.h>
+#include <aerospike/as_partition.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_sleep.h>
+#include <citrusleaf/cf_b64.h>
+#include <citrusleaf/cf_clock.h>
+#include <pthread.h>
+#include <string.h>
+#include "test.h"
+#include "aerospike_test.h"
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+#define NAMESPACE "test"
+#define SET "test_cluster"
+#define TEND_INTERVAL 100
+#define N_PARTITIONS 4096
+#define BITMAP_SIZE (N_PARTITIONS / 8)
+#define CONN_POOLS 4
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static uint32_t
+cluster_tend_count(as_cluster* cluster)
+{
+	pthread_mutex_lock(&cluster->tend_lock);
+	uint32_t count = cluster->tend_count;
+	pthread_mutex_unlock(&cluster->tend_lock);
+	return count;
+}
+
+static void
+cluster_wait_tends(as_cluster* cluster, uint32_t n)
+{
+	uint32_t end = cluster_tend_count(cluster) + n;
+
+	for (uint32_t i = 0; i < 100 && cluster_tend_count(cluster) < end; i++) {
+		as_sleep(TEND_INTERVAL);
+	}
+}
+
+static void
+bitmap_set(uint8_t* bitmap, uint32_t id)
+{
+	bitmap[id >> 3] |= (uint8_t)(0x80 >> (id & 7));
+}
+
+static void
+bitmap_clear(uint8_t* bitmap, uint32_t id)
+{
+	bitmap[id >> 3] &= (uint8_t)~(0x80 >> (id & 7));
+}
+
+static uint32_t
+bitmap_decode(
+	as_node* node, const char* ns, uint8_t* bitmap, uint8_t replica_index, uint32_t regime,
+	bool full, uint32_t* ids
+	)
+{
+	char b64[1024];
+	cf_b64_encode(bitmap, BITMAP_SIZE, b64);
+	return as_partition_bitmap_decode(node, ns, b64, cf_b64_encoded_len(BITMAP_SIZE),
+		N_PARTITIONS, replica_index, regime, full, ids);
+}
+
+typedef struct {
+	as_node* node;
+	as_status status;
+	uint32_t home_index;
+	int fd;
+	as_conn_pool* pool;
+} conn_thread_data;
+
+static uint32_t
+conn_home_index(void)
+{
+	return (as_node_thread_assign() - 1) % CONN_POOLS;
+}
+
+static as_status
+conn_get(as_node* node, as_socket* sock)
+{
+	as_error err;
+	as_status status = as_node_get_connection(&err, node, NULL, cf_getms() + 5000, sock, NULL);
+
+	if (status != AEROSPIKE_OK) {
+		error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+	}
+	return status;
+}
+
+static void*
+conn_thread_run(void* udata)
+{
+	// Open a connection in this thread's home pool and leave it idle there.
+	conn_thread_data* data = udata;
+	data->home_index = conn_home_index();
+
+	as_socket sock;
+	data->status = conn_get(data->node, &sock);
+
+	if (data->status == AEROSPIKE_OK) {
+		data->fd = sock.fd;
+		data->pool = sock.pool;
+		as_node_put_connection(data->node, &sock);
+	}
+	return NULL;
+}
+
+static aerospike*
+conn_affinity_client_create(void)
+{
+	as_config config;
+	aerospike_test_config_init(&config);
+	config.conn_pools_per_node = CONN_POOLS;
+	config.conn_pool_thread_affinity = true;
+
+	aerospike* client = aerospike_new(&config);
+
+	as_error err;
+
+	if (aerospike_connect(client, &err) != AEROSPIKE_OK) {
+		error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+		aerospike_destroy(client);
+		return NULL;
+	}
+	return client;
+}
+
+static void
+conn_affinity_client_destroy(aerospike* client, as_node* node)
+{
+	as_node_release(node);
+
+	as_error err;
+	aerospike_close(client, &err);
+	aerospike_destroy(client);
+}
+
+static as_node*
+conn_node_reserve(aerospike* client)
+{
+	as_nodes* nodes = as_nodes_reserve(client->cluster);
+	as_node* node = nodes->array[0];
+	as_node_reserve(node);
+	as_nodes_release(nodes);
+	return node;
+}
+
+//---------------------------------
+// Tests
+//---------------------------------
+
+TEST(cluster_tend_parallel, "tend nodes from the tend thread pool")
+{
+	as_config config;
+	aerospike_test_config_init(&config);
+	config.tend_thread_pool_size = 4;
+	config.tender_interval = TEND_INTERVAL;
+
+	aerospike* client = aerospike_new(&config);
+
+	as_error err;
+	as_status status = aerospike_connect(client, &err);
+
+	if (status != AEROSPIKE_OK) {
+		aerospike_destroy(client);
+	}
+	assert_int_eq(status, AEROSPIKE_OK);
+
+	as_cluster* cluster = client->cluster;
+	as_nodes* nodes = as_nodes_reserve(cluster);
+	uint32_t n_nodes = nodes->size;
+	as_node* node = nodes->array[0];
+	as_node_reserve(node);
+	as_nodes_release(nodes);
+
+	// Simulate a quick node restart by moving the peers generation past the server's value.
+	// The tend lock is held by the tend thread except while it waits between tends.
+	pthread_mutex_lock(&cluster->tend_lock);
+	uint32_t peers_gen = node->peers_generation;
+	node->peers_generation = peers_gen + 1000;
+	pthread_mutex_unlock(&cluster->tend_lock);
+
+	cluster_wait_tends(cluster, 3);
+
+	// The restart was handled by the tend thread and peers were reloaded from the server.
+	pthread_mutex_lock(&cluster->tend_lock);
+	bool restarted = node->restarted;
+	uint32_t peers_gen_new = node->peers_generation;
+	bool active = node->active;
+	pthread_mutex_unlock(&cluster->tend_lock);
+	as_node_release(node);
+
+	as_key key;
+	as_key_init_int64(&key, NAMESPACE, SET, 1);
+
+	as_record rec;
+	as_record_inita(&rec, 1);
+	as_record_set_int64(&rec, "a", 1);
+
+	as_status put_status = aerospike_key_put(client, &err, NULL, &key, &rec);
+	as_record_destroy(&rec);
+
+	nodes = as_nodes_reserve(cluster);
+	uint32_t n_nodes_new = nodes->size;
+	as_nodes_release(nodes);
+
+	aerospike_close(client, &err);
+	aerospike_destroy(client);
+
+	assert_false(restarted);
+	assert_true(active);
+	assert_true(peers_gen_new < peers_gen + 1000);
+	assert_int_eq(n_nodes_new, n_nodes);
+	assert_int_eq(put_status, AEROSPIKE_OK);
+}
+
+TEST(cluster_partition_bitmap_diff, "apply only changed partitions from a replicas bitmap")
+{
+	// Only the tend thread fields used by the bitmap cache are needed.
+	as_node node;
+	memset(&node, 0, sizeof(as_node));
+
+	uint8_t bitmap[BITMAP_SIZE];
+	memset(bitmap, 0, sizeof(bitmap));
+	bitmap_set(bitmap, 0);
+	bitmap_set(bitmap, 5);
+	bitmap_set(bitmap, 100);
+	bitmap_set(bitmap, 4095);
+
+	uint32_t ids[N_PARTITIONS];
+
+	// No cached bitmap. All claimed partitions are applied.
+	uint32_t n = bitmap_decode(&node, NAMESPACE, bitmap, 0, 1, false, ids);
+	assert_int_eq(n, 4);
+	assert_int_eq(ids[0], 0);
+	assert_int_eq(ids[1], 5);
+	assert_int_eq(ids[2], 100);
+	assert_int_eq(ids[3], 4095);
+
+	// Same bitmap. Nothing is applied.
+	n = bitmap_decode(&node, NAMESPACE, bitmap, 0, 1, false, ids);
+	assert_int_eq(n, 0);
+
+	// Claim 7 and 2000, drop 5. Only the newly claimed partitions are applied.
+	bitmap_set(bitmap, 7);
+	bitmap_set(bitmap, 2000);
+	bitmap_clear(bitmap, 5);
+	n = bitmap_decode(&node, NAMESPACE, bitmap, 0, 1, false, ids);
+	assert_int_eq(n, 2);
+	assert_int_eq(ids[0], 7);
+	assert_int_eq(ids[1], 2000);
+
+	// Reclaim 5. It was dropped from the cached bitmap, so it is applied again.
+	bitmap_set(bitmap, 5);
+	n = bitmap_decode(&node, NAMESPACE, bitmap, 0, 1, false, ids);
+	assert_int_eq(n, 1);
+	assert_int_eq(ids[0], 5);
+
+	// Other replica indexes and namespaces are cached separately.
+	n = bitmap_decode(&node, NAMESPACE, bitmap, 1, 1, false, ids);
+	assert_int_eq(n, 6);
+	n = bitmap_decode(&node, "other", bitmap, 0, 1, false, ids);
+	assert_int_eq(n, 6);
+	assert_int_eq(node.partition_bitmaps_size, 2);
+
+	// A regime change or a forced full update applies all claimed partitions.
+	n = bitmap_decode(&node, NAMESPACE, bitmap, 0, 2, false, ids);
+	assert_int_eq(n, 6);
+	n = bitmap_decode(&node, NAMESPACE, bitmap, 0, 2, true, ids);
+	assert_int_eq(n, 6);
+	n = bitmap_decode(&node, NAMESPACE, bitmap, 0, 2, false, ids);
+	assert_int_eq(n, 0);
+
+	as_partition_bitmaps_destroy(&node);
+	assert_int_eq(node.partition_bitmaps_size, 0);
+}
+
+TEST(cluster_conn_affinity_reuse, "reuse connection from thread's home pool")
+{
+	aerospike* client = conn_affinity_client_create();
+	assert_not_null(client);
+
+	as_node* node = conn_node_reserve(client);
+	as_conn_pool* home = &node->sync_conn_pools[conn_home_index()];
+	uint32_t opened = as_node_get_sync_conns_opened(node);
+
+	as_socket sock;
+	as_status status = conn_get(node, &sock);
+	int fd = sock.fd;
+	as_conn_pool* pool1 = sock.pool;
+
+	if (status == AEROSPIKE_OK) {
+		as_node_put_connection(node, &sock);
+		status = conn_get(node, &sock);
+	}
+
+	int fd2 = sock.fd;
+	as_conn_pool* pool2 = sock.pool;
+
+	if (status == AEROSPIKE_OK) {
+		as_node_put_connection(node, &sock);
+	}
+
+	uint32_t opened_new = as_node_get_sync_conns_opened(node);
+	conn_affinity_client_destroy(client, node);
+
+	// The new connection is created in the home pool and the same thread gets it back.
+	assert_int_eq(status, AEROSPIKE_OK);
+	assert_true(pool1 == home);
+	assert_true(pool2 == home);
+	assert_int_eq(fd2, fd);
+	assert_int_eq(opened_new, opened + 1);
+}
+
+TEST(cluster_conn_affinity_borrow, "borrow idle connection from another thread's pool")
+{
+	aerospike* client = conn_affinity_client_create();
+	assert_not_null(client);
+
+	as_node* node = conn_node_reserve(client);
+	uint32_t home_index = conn_home_index();
+	conn_thread_data data = {.node = node, .status = AEROSPIKE_OK, .home_index = home_index};
+
+	// Thread ids are assigned in sequence, so a few threads are enough to find one whose
+	// home pool differs from this thread's home pool.
+	for (uint32_t i = 0; i < CONN_POOLS * 2 && data.home_index == home_index &&
+		 data.status == AEROSPIKE_OK; i++) {
+		pthread_t thread;
+		pthread_create(&thread, NULL, conn_thread_run, &data);
+		pthread_join(thread, NULL);
+
+		if (data.status == AEROSPIKE_OK && data.home_index == home_index) {
+			// The connection was left in this thread's home pool. Remove it.
+			as_socket sock;
+
+			if (conn_get(node, &sock) == AEROSPIKE_OK) {
+				as_node_close_connection(node, &sock, sock.pool);
+			}
+		}
+	}
+
+	uint32_t opened = as_node_get_sync_conns_opened(node);
+	as_socket sock;
+	as_status status = AEROSPIKE_ERR_CLIENT;
+	int fd = -1;
+	as_conn_pool* pool = NULL;
+
+	if (data.status == AEROSPIKE_OK && data.home_index != home_index) {
+		// This thread's home pool is empty, so the other thread's idle connection is
+		// borrowed instead of opening a new one.
+		status = conn_get(node, &sock);
+
+		if (status == AEROSPIKE_OK) {
+			fd = sock.fd;
+			pool = sock.pool;
+			as_node_put_connection(node, &sock);
+		}
+	}
+
+	uint32_t opened_new = as_node_get_sync_conns_opened(node);
+	conn_affinity_client_destroy(client, node);
+
+	assert_int_eq(data.status, AEROSPIKE_OK);
+	assert_true(data.home_index != home_index);
+	assert_int_eq(status, AEROSPIKE_OK);
+	assert_int_eq(fd, data.fd);
+	assert_true(pool == data.pool);
+	assert_int_eq(opened_new, opened);
+}
+
+//---------------------------------
+// Test Suite
+//---------------------------------
+
+SUITE(cluster, "Cluster tend and node tests")
+{
+	suite_add(cluster_tend_parallel);
+	suite_add(cluster_partition_bitmap_diff);
+	suite_add(cluster_conn_affinity_reuse);
+	suite_add(cluster_conn_affinity_borrow);
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright 2008-2026 Aerospike, Inc.
+ *
+ * Portions may be licensed to Aerospike, Inc. under one or more contributor
+ * license agreements.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_key.h>
+#include <aerospike/aerospike_stats.h>
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_record.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "aerospike_test.h"
+
+//---------------------------------
+// Macros
+//---------------------------------
+
+#define NAMESPACE "test"
+#define SET "test_tls"
+#define N_KEYS 20
+#define BLOB_SIZE (256 * 1024)
+
+//---------------------------------
+// Static Functions
+//---------------------------------
+
+static aerospike*
+tls_client_create(as_config* config)
+{
+	aerospike* client = aerospike_new(config);
+
+	as_error err;
+
+	if (aerospike_connect(client, &err) != AEROSPIKE_OK) {
+		error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+		aerospike_destroy(client);
+		return NULL;
+	}
+	return client;
+}
+
+static void
+tls_client_destroy(aerospike* client)
+{
+	as_error err;
+	aerospike_close(client, &err);
+	aerospike_destroy(client);
+}
+
+static bool
+tls_write_read(aerospike* client)
+{
+	as_error err;
+	uint8_t* blob = malloc(BLOB_SIZE);
+
+	for (uint32_t i = 0; i < BLOB_SIZE; i++) {
+		blob[i] = (uint8_t)i;
+	}
+
+	bool ok = true;
+
+	// The blob spans many TLS records in both directions.
+	for (int i = 0; i < N_KEYS && ok; i++) {
+		as_key key;
+		as_key_init_int64(&key, NAMESPACE, SET, i);
+
+		as_record rec;
+		as_record_inita(&rec, 2);
+		as_record_set_int64(&rec, "a", i);
+		as_record_set_raw(&rec, "b", blob, BLOB_SIZE);
+
+		if (aerospike_key_put(client, &err, NULL, &key, &rec) != AEROSPIKE_OK) {
+			error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+			ok = false;
+		}
+		as_record_destroy(&rec);
+	}
+
+	for (int i = 0; i < N_KEYS && ok; i++) {
+		as_key key;
+		as_key_init_int64(&key, NAMESPACE, SET, i);
+
+		as_record* rec = NULL;
+
+		if (aerospike_key_get(client, &err, NULL, &key, &rec) != AEROSPIKE_OK) {
+			error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+			ok = false;
+			break;
+		}
+
+		as_bytes* bytes = as_record_get_bytes(rec, "b");
+
+		if (as_record_get_int64(rec, "a", -1) != i || ! bytes ||
+			as_bytes_size(bytes) != BLOB_SIZE ||
+			memcmp(as_bytes_get(bytes), blob, BLOB_SIZE) != 0) {
+			error("record %d mismatch", i);
+			ok = false;
+		}
+		as_record_destroy(rec);
+	}
+
+	for (int i = 0; i < N_KEYS; i++) {
+		as_key key;
+		as_key_init_int64(&key, NAMESPACE, SET, i);
+		aerospike_key_remove(client, &err, NULL, &key);
+	}
+
+	free(blob);
+	return ok;
+}
+
+static uint64_t
+tls_session_hits(aerospike* client)
+{
+	as_cluster_stats stats;
+	aerospike_stats(client, &stats);
+	uint64_t hits = stats.tls_session_hit_count;
+	aerospike_stats_destroy(&stats);
+	return hits;
+}
+
+static bool
+tls_put(aerospike* client)
+{
+	as_error err;
+
+	as_key key;
+	as_key_init_int64(&key, NAMESPACE, SET, 1);
+
+	as_record rec;
+	as_record_inita(&rec, 1);
+	as_record_set_int64(&rec, "a", 1);
+
+	as_status status = aerospike_key_put(client, &err, NULL, &key, &rec);
+	as_record_destroy(&rec);
+
+	if (status != AEROSPIKE_OK) {
+		error("%s (%d) [%s:%d]", err.message, err.code, err.file, err.line);
+		return false;
+	}
+	return true;
+}
+
+static uint64_t
+tls_session_hits_new_conn(bool session_cache)
+{
+	as_config config;
+	aerospike_test_config_init(&config);
+	config.tls.session_cache = session_cache;
+
+	aerospike* client = tls_client_create(&config);
+
+	if (! client) {
+		return UINT64_MAX;
+	}
+
+	// The tend connection to each node did a full handshake and cached its session. The
+	// first command opens a second connection to a node, which resumes that session.
+	uint64_t hits = tls_session_hits(client);
+	bool ok = tls_put(client);
+	uint64_t hits_new = tls_session_hits(client);
+	tls_client_destroy(client);
+
+	if (! ok) {
+		return UINT64_MAX;
+	}
+
+	info("tls session hits: %" PRIu64 " -> %" PRIu64, hits, hits_new);
+	return hits_new - hits;
+}
+
+//---------------------------------
+// Tests
+//---------------------------------
+
+TEST(tls_ktls, "read and write with kernel TLS offload enabled")
+{
+	if (! g_tls.enable) {
+		return;
+	}
+
+	// Connections use kTLS when the kernel and OpenSSL support it and fall back to user
+	// space TLS otherwise. Reads and writes must succeed either way.
+	as_config config;
+	aerospike_test_config_init(&config);
+	config.tls.ktls = true;
+	config.tls.log_session_info = true;
+
+	aerospike* client = tls_client_create(&config);
+	assert_not_null(client);
+
+	bool ok = tls_write_read(client);
+	tls_client_destroy(client);
+	assert_true(ok);
+}
+
+TEST(tls_ktls_off, "read and write with kernel TLS offload disabled")
+{
+	if (! g_tls.enable) {
+		return;
+	}
+
+	as_config config;
+	aerospike_test_config_init(&config);
+	config.tls.ktls = false;
+
+	aerospike* client = tls_client_create(&config);
+	assert_not_null(client);
+
+	bool ok = tls_write_read(client);
+	tls_client_destroy(client);
+	assert_true(ok);
+}
+
+TEST(tls_session_resume, "resume cached TLS session on new connection")
+{
+	if (! g_tls.enable) {
+		return;
+	}
+
+	uint64_t hits = tls_session_hits_new_conn(true);
+	assert_true(hits != UINT64_MAX);
+	assert_true(hits > 0);
+}
+
+TEST(tls_session_cache_off, "full TLS handshake when session cache is disabled")
+{
+	if (! g_tls.enable) {
+		return;
+	}
+
+	uint64_t hits = tls_session_hits_new_conn(false);
+	assert_true(hits != UINT64_MAX);
+	assert_true(hits == 0);
+}
+
+//---------------------------------
+// Test Suite
+//---------------------------------
+
+SUITE(tls, "TLS connection tests")
+{
+	suite_add(tls_ktls);
+	suite_add(tls_ktls_off);
+	suite_add(tls_session_resume);
+	suite_add(tls_session_cache_off);
+}
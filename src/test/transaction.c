@@ -1079,6 +1079,61 @@ TEST(txn_commit_fail_command_blocked, "commands blocked while txn in commit-fail
 	as_txn_destroy(&txn);
 }
 
+TEST(txn_hash_grow, "transaction key hash grows beyond initial capacity")
+{
+	// Client side only. Track far more keys than the default hash capacity.
+	as_txn txn;
+	as_txn_init(&txn);
+
+	uint32_t n_keys = 20000;
+
+	for (uint32_t i = 0; i < n_keys; i++) {
+		as_key key;
+		as_key_init_int64(&key, NAMESPACE, SET, i);
+		as_key_digest(&key);
+		as_txn_on_read(&txn, key.digest.value, SET, i + 1);
+
+		if (i % 4 == 0) {
+			// Move key from reads to writes.
+			as_txn_on_write(&txn, key.digest.value, SET, 0, AEROSPIKE_OK);
+		}
+		as_key_destroy(&key);
+	}
+
+	assert_int_eq(as_txn_reads_size(&txn), n_keys - n_keys / 4);
+	assert_int_eq(as_txn_writes_size(&txn), n_keys / 4);
+
+	for (uint32_t i = 0; i < n_keys; i++) {
+		as_key key;
+		as_key_init_int64(&key, NAMESPACE, SET, i);
+		as_key_digest(&key);
+
+		uint64_t version = as_txn_get_read_version(&txn, key.digest.value);
+
+		if (i % 4 == 0) {
+			assert_int_eq(version, 0);
+			assert_true(as_txn_writes_contain(&txn, &key));
+		}
+		else {
+			assert_int_eq(version, i + 1);
+			assert_false(as_txn_writes_contain(&txn, &key));
+		}
+		as_key_destroy(&key);
+	}
+
+	as_txn_iter iter;
+	as_txn_iter_reads(&iter, &txn);
+
+	uint32_t count = 0;
+
+	while (as_txn_iter_next(&iter) != NULL) {
+		count++;
+	}
+	assert_int_eq(count, n_keys - n_keys / 4);
+
+	as_txn_destroy(&txn);
+}
+
 //---------------------------------
 // Test Suite
 //---------------------------------
@@ -1114,4 +1169,5 @@ SUITE(transaction, "Transaction tests")
 	suite_add(txn_commit_fail_safe_abortable);
 	suite_add(txn_commit_fail_abort_blocked);
 	suite_add(txn_commit_fail_command_blocked);
+	suite_add(txn_hash_grow);
 }